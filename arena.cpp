@@ -0,0 +1,85 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "arena.h"
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+
+
+///////////////////
+
+Arena::Arena(std::size_t blockSize) : m_blockSize{blockSize}
+{
+}
+
+
+void Arena::rewind(Mark mark)
+{
+   assert(mark.block < m_current ||
+          (mark.block == m_current && mark.offset <= m_offset));
+   m_current = mark.block;
+   m_offset = mark.offset;
+}
+
+
+std::size_t Arena::capacity() const
+{
+   std::size_t cap = 0;
+   for (const Block& block : m_blocks)
+      cap += block.size;
+   return cap;
+}
+
+
+void* Arena::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+   while (true)
+   {
+      if (m_current < m_blocks.size())
+      {
+         const Block& block = m_blocks[m_current];
+         const auto base = reinterpret_cast<std::uintptr_t>(block.memory.get());
+         const std::uintptr_t aligned =
+            (base + m_offset + alignment - 1) & ~(std::uintptr_t{alignment} - 1);
+         const std::size_t end = static_cast<std::size_t>(aligned - base) + bytes;
+
+         if (end <= block.size)
+         {
+            m_offset = end;
+            return reinterpret_cast<void*>(aligned);
+         }
+      }
+
+      nextBlock(bytes + alignment);
+   }
+}
+
+
+void Arena::nextBlock(std::size_t minSize)
+{
+   // Skip to the next existing block that is large enough. Blocks that are
+   // skipped stay unused until the arena is rewound.
+   std::size_t next = m_blocks.empty() ? 0 : m_current + 1;
+   while (next < m_blocks.size() && m_blocks[next].size < minSize)
+      ++next;
+
+   if (next == m_blocks.size())
+   {
+      const std::size_t size = std::max(m_blockSize, minSize);
+      m_blocks.push_back(Block{std::make_unique<std::byte[]>(size), size});
+   }
+
+   m_current = next;
+   m_offset = 0;
+}
+
+
+///////////////////
+
+Arena& threadArena()
+{
+   thread_local Arena arena;
+   return arena;
+}
@@ -0,0 +1,84 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+
+///////////////////
+
+// Bump allocator for short-lived scratch data. Allocating advances a pointer within
+// the current block and deallocating does nothing. Memory is reclaimed all at once
+// by rewinding the arena to an earlier mark, which keeps the blocks for reuse.
+// Not thread-safe. Each thread uses its own arena.
+class Arena : public std::pmr::memory_resource
+{
+ public:
+   static constexpr std::size_t DefaultBlockSize = 64 * 1024;
+
+   // Allocation state that the arena can be rewound to.
+   struct Mark
+   {
+      std::size_t block = 0;
+      std::size_t offset = 0;
+   };
+
+   explicit Arena(std::size_t blockSize = DefaultBlockSize);
+   Arena(const Arena&) = delete;
+   Arena& operator=(const Arena&) = delete;
+
+   Mark mark() const { return {m_current, m_offset}; }
+   // Frees everything allocated after the mark was taken.
+   void rewind(Mark mark);
+   void reset() { rewind(Mark{}); }
+   // Total memory held by the arena.
+   std::size_t capacity() const;
+
+ private:
+   struct Block
+   {
+      std::unique_ptr<std::byte[]> memory;
+      std::size_t size = 0;
+   };
+
+   void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+   void do_deallocate(void*, std::size_t, std::size_t) override {}
+   bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+   {
+      return this == &other;
+   }
+
+   // Makes the next block with at least the given size current.
+   void nextBlock(std::size_t minSize);
+
+ private:
+   std::size_t m_blockSize = DefaultBlockSize;
+   std::vector<Block> m_blocks;
+   std::size_t m_current = 0;
+   std::size_t m_offset = 0;
+};
+
+
+// Returns the arena of the calling thread.
+Arena& threadArena();
+
+
+///////////////////
+
+// Rewinds an arena to its state at construction time when going out of scope.
+class ArenaScope
+{
+ public:
+   explicit ArenaScope(Arena& arena) : m_arena{arena}, m_mark{arena.mark()} {}
+   ~ArenaScope() { m_arena.rewind(m_mark); }
+   ArenaScope(const ArenaScope&) = delete;
+   ArenaScope& operator=(const ArenaScope&) = delete;
+
+ private:
+   Arena& m_arena;
+   Arena::Mark m_mark;
+};
@@ -0,0 +1,247 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#pragma once
+#include "bitboard.h"
+#include "piece.h"
+#include "square.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Lookup tables for move generation and evaluation. All tables are generated at
+// compile time, so no code runs to initialize them at startup.
+
+
+namespace detail
+{
+///////////////////
+
+using SquareTable = std::array<Bitboard, Square::NumSquares>;
+using SquarePairTable = std::array<SquareTable, Square::NumSquares>;
+using DistanceTable =
+   std::array<std::array<std::uint8_t, Square::NumSquares>, Square::NumSquares>;
+
+
+template <std::size_t N>
+constexpr SquareTable makeOffsetTable(const std::array<Offset, N>& offsets)
+{
+   SquareTable table{};
+   for (std::size_t idx = 0; idx < Square::NumSquares; ++idx)
+   {
+      const Square from = Square::fromIndex(idx);
+      for (const Offset& off : offsets)
+         if (const auto to = from + off; to.has_value())
+            table[idx] |= bit(*to);
+   }
+   return table;
+}
+
+
+constexpr SquareTable makeKingTable()
+{
+   return makeOffsetTable(std::array<Offset, 8>{
+      Offset{1, 1}, {1, 0}, {1, -1}, {0, 1}, {0, -1}, {-1, 1}, {-1, 0}, {-1, -1}});
+}
+
+
+constexpr SquareTable makeKnightTable()
+{
+   return makeOffsetTable(std::array<Offset, 8>{
+      Offset{2, 1}, {2, -1}, {-2, 1}, {-2, -1}, {1, 2}, {-1, 2}, {1, -2}, {-1, -2}});
+}
+
+
+constexpr std::array<SquareTable, 2> makePawnTable()
+{
+   return {makeOffsetTable(std::array<Offset, 2>{Offset{-1, 1}, {1, 1}}),
+           makeOffsetTable(std::array<Offset, 2>{Offset{-1, -1}, {1, -1}})};
+}
+
+
+// Squares strictly between two squares on a common line.
+constexpr SquarePairTable makeBetweenTable()
+{
+   SquarePairTable table{};
+   for (std::size_t idx = 0; idx < Square::NumSquares; ++idx)
+   {
+      const Square from = Square::fromIndex(idx);
+      for (std::size_t dir = 0; dir < NumDirections; ++dir)
+      {
+         Bitboard passed = EmptyBB;
+         for (const Square to : ray(from, static_cast<Direction>(dir)))
+         {
+            table[idx][to.index()] = passed;
+            passed |= bit(to);
+         }
+      }
+   }
+   return table;
+}
+
+
+// Complete line through two squares on a common line, including the squares
+// themselves.
+constexpr SquarePairTable makeLineTable()
+{
+   SquarePairTable table{};
+   for (std::size_t idx = 0; idx < Square::NumSquares; ++idx)
+   {
+      const Square from = Square::fromIndex(idx);
+      // Opposite directions are four apart.
+      for (std::size_t dir = 0; dir < NumDirections / 2; ++dir)
+      {
+         const Ray& forward = ray(from, static_cast<Direction>(dir));
+         const Ray& backward = ray(from, static_cast<Direction>(dir + 4));
+
+         Bitboard line = bit(from);
+         for (const Square sq : forward)
+            line |= bit(sq);
+         for (const Square sq : backward)
+            line |= bit(sq);
+
+         for (const Square to : forward)
+            table[idx][to.index()] = line;
+         for (const Square to : backward)
+            table[idx][to.index()] = line;
+      }
+   }
+   return table;
+}
+
+
+constexpr int absDiff(int a, int b)
+{
+   return a > b ? a - b : b - a;
+}
+
+
+constexpr DistanceTable makeChebyshevTable()
+{
+   DistanceTable table{};
+   for (std::size_t a = 0; a < Square::NumSquares; ++a)
+   {
+      for (std::size_t b = 0; b < Square::NumSquares; ++b)
+      {
+         const Square sa = Square::fromIndex(a);
+         const Square sb = Square::fromIndex(b);
+         const int df = absDiff(sa.fileIndex(), sb.fileIndex());
+         const int dr = absDiff(sa.rankIndex(), sb.rankIndex());
+         table[a][b] = static_cast<std::uint8_t>(df > dr ? df : dr);
+      }
+   }
+   return table;
+}
+
+
+constexpr DistanceTable makeManhattanTable()
+{
+   DistanceTable table{};
+   for (std::size_t a = 0; a < Square::NumSquares; ++a)
+   {
+      for (std::size_t b = 0; b < Square::NumSquares; ++b)
+      {
+         const Square sa = Square::fromIndex(a);
+         const Square sb = Square::fromIndex(b);
+         table[a][b] = static_cast<std::uint8_t>(absDiff(sa.fileIndex(), sb.fileIndex()) +
+                                                 absDiff(sa.rankIndex(), sb.rankIndex()));
+      }
+   }
+   return table;
+}
+
+
+inline constexpr std::array<Direction, 4> StraightDirections = {
+   Direction::North, Direction::East, Direction::South, Direction::West};
+inline constexpr std::array<Direction, 4> DiagonalDirections = {
+   Direction::NorthEast, Direction::SouthEast, Direction::SouthWest,
+   Direction::NorthWest};
+
+
+// Squares along rays up to and including the first occupied square of each ray.
+constexpr Bitboard slidingAttacks(Square from, Bitboard occupied,
+                                  const std::array<Direction, 4>& directions)
+{
+   Bitboard attacks = EmptyBB;
+   for (const Direction dir : directions)
+   {
+      for (const Square sq : ray(from, dir))
+      {
+         attacks |= bit(sq);
+         if (isSet(occupied, sq))
+            break;
+      }
+   }
+   return attacks;
+}
+
+
+inline constexpr SquareTable KingAttacks = makeKingTable();
+inline constexpr SquareTable KnightAttacks = makeKnightTable();
+inline constexpr std::array<SquareTable, 2> PawnAttacks = makePawnTable();
+inline constexpr SquarePairTable Between = makeBetweenTable();
+inline constexpr SquarePairTable Line = makeLineTable();
+inline constexpr DistanceTable ChebyshevDistance = makeChebyshevTable();
+inline constexpr DistanceTable ManhattanDistance = makeManhattanTable();
+
+} // namespace detail
+
+
+///////////////////
+
+inline constexpr Bitboard kingAttacks(Square sq)
+{
+   return detail::KingAttacks[sq.index()];
+}
+
+inline constexpr Bitboard knightAttacks(Square sq)
+{
+   return detail::KnightAttacks[sq.index()];
+}
+
+// Squares that a pawn of a given color attacks diagonally.
+inline constexpr Bitboard pawnAttacks(Color side, Square sq)
+{
+   return detail::PawnAttacks[static_cast<std::size_t>(side)][sq.index()];
+}
+
+// Squares that a rook attacks for given occupied squares. Includes the first
+// occupied square in each direction.
+inline constexpr Bitboard rookAttacks(Square sq, Bitboard occupied)
+{
+   return detail::slidingAttacks(sq, occupied, detail::StraightDirections);
+}
+
+// Squares that a bishop attacks for given occupied squares. Includes the first
+// occupied square in each direction.
+inline constexpr Bitboard bishopAttacks(Square sq, Bitboard occupied)
+{
+   return detail::slidingAttacks(sq, occupied, detail::DiagonalDirections);
+}
+
+// Squares strictly between two squares. Empty if the squares are not on a common
+// rank, file or diagonal.
+inline constexpr Bitboard between(Square a, Square b)
+{
+   return detail::Between[a.index()][b.index()];
+}
+
+// Whole rank, file or diagonal through two squares. Empty if the squares are not
+// on a common line.
+inline constexpr Bitboard line(Square a, Square b)
+{
+   return detail::Line[a.index()][b.index()];
+}
+
+// Number of king moves between two squares.
+inline constexpr int chebyshevDistance(Square a, Square b)
+{
+   return detail::ChebyshevDistance[a.index()][b.index()];
+}
+
+// Number of rook steps of length one between two squares.
+inline constexpr int manhattanDistance(Square a, Square b)
+{
+   return detail::ManhattanDistance[a.index()][b.index()];
+}
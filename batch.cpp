@@ -0,0 +1,72 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "batch.h"
+#include "eval_cache.h"
+#include "tt.h"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+
+///////////////////
+
+std::vector<SearchResult> searchBatch(const std::vector<BatchJob>& jobs,
+                                      const BatchOptions& options,
+                                      const BatchCallback& onResult,
+                                      const Tablebases& tablebases)
+{
+   std::vector<SearchResult> results(jobs.size());
+   std::atomic<std::size_t> nextJob{0};
+   std::mutex callbackMutex;
+   const std::atomic<bool> noCancel{false};
+   const std::atomic<bool>& cancel = options.cancel ? *options.cancel : noCancel;
+
+   const auto work = [&]() {
+      TranspositionTable tt{options.hashSizeMB};
+      EvalCache evalCache{options.evalCacheSizeMB};
+      // Limits of the jobs whose scores are in the evaluation cache.
+      std::optional<SearchLimits> cachedLimits;
+      for (std::size_t idx = nextJob++; idx < jobs.size(); idx = nextJob++)
+      {
+         if (cancel.load(std::memory_order_relaxed))
+            break;
+
+         const BatchJob& job = jobs[idx];
+         // The workers already keep the hardware threads busy.
+         SearchLimits limits = job.limits;
+         limits.isParallel = false;
+
+         tt.clear();
+         if (!cachedLimits || !haveSameEvaluation(*cachedLimits, limits))
+         {
+            evalCache.clear();
+            cachedLimits = limits;
+         }
+         results[idx] = search(job.pos, job.side, limits, tt, cancel, {}, tablebases,
+                               &evalCache);
+
+         if (onResult)
+         {
+            std::lock_guard lock{callbackMutex};
+            onResult(idx, results[idx]);
+         }
+      }
+   };
+
+   std::size_t numWorkers = options.numWorkers;
+   if (numWorkers == 0)
+      numWorkers = std::thread::hardware_concurrency();
+   // No idle workers.
+   numWorkers = std::max<std::size_t>(std::min(numWorkers, jobs.size()), 1);
+
+   std::vector<std::thread> workers;
+   for (std::size_t i = 0; i < numWorkers; ++i)
+      workers.emplace_back(work);
+   for (std::thread& worker : workers)
+      worker.join();
+   return results;
+}
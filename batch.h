@@ -0,0 +1,57 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#pragma once
+#include "matt.h"
+#include "position.h"
+#include "tablebase.h"
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+
+///////////////////
+
+// Position to search as part of a batch.
+struct BatchJob
+{
+   Position pos;
+   Color side = Color::White;
+   SearchLimits limits;
+};
+
+
+struct BatchOptions
+{
+   // Worker threads. One per hardware thread if zero.
+   std::size_t numWorkers = 0;
+   // Size of the transposition table of each worker. Small tables are cheap to clear
+   // between jobs.
+   std::size_t hashSizeMB = 1;
+   // Size of the evaluation cache of each worker. It gets cleared between jobs that
+   // evaluate positions differently.
+   std::size_t evalCacheSizeMB = 1;
+   // Cancels the batch when set. Running jobs return the best result found so far
+   // and jobs that did not start yet return empty results.
+   const std::atomic<bool>* cancel = nullptr;
+};
+
+
+// Called with the index of a job and its result as soon as the job completes. Gets
+// called from the worker threads, one call at a time.
+using BatchCallback = std::function<void(std::size_t, const SearchResult&)>;
+
+
+// Searches many independent positions on a fixed number of worker threads. Each
+// worker searches one position at a time on its own thread with its own
+// transposition table, which gets cleared between jobs, and its own evaluation
+// cache, which only keeps its scores for jobs with the same evaluation, so that
+// results do not depend on the order in which the jobs run or on the number of
+// workers.
+// Returns the results in the order of the jobs.
+std::vector<SearchResult>
+searchBatch(const std::vector<BatchJob>& jobs, const BatchOptions& options,
+            const BatchCallback& onResult = {},
+            const Tablebases& tablebases = Tablebases::builtIn());
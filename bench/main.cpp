@@ -0,0 +1,142 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "batch.h"
+#include "fen.h"
+#include "position.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Searches a fixed suite of positions to a fixed depth and reports the nodes and
+// the speed, e.g.
+//    matt_bench --depth 6 --threads 4 --hash 16
+// The total node count is a signature of the search. It depends on the depth and
+// the hash size but not on the number of threads, so builds that search differently
+// can be told apart from builds that only search faster.
+
+
+namespace
+{
+///////////////////
+
+// Positions from the unit tests of the search, White to move.
+constexpr std::string_view NotatedPositions[] = {
+   "Kwd3 wf4 Kbb2",
+   "Rwb1 Kwd1 Bwf1 Rwh1 wa2 wf2 wg2 wh2 Qbc3 we3 Nwf3 Bwg3 wd4 Kbe4 bd5 bg5 bc6 bh6 "
+   "ba7 bb7 Kbe7 bf7 Bbg7 Rba8 Kbb8 Qwc8 Rbh8"};
+
+// Openings, middlegames and endgames.
+constexpr std::string_view FenPositions[] = {
+   "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+   "r1bqkbnr/pppp1ppp/2n5/4p3/2B1P3/5N2/PPPP1PPP/RNBQK2R b KQkq - 3 3",
+   "rnbqkbnr/pp1ppppp/8/2p5/4P3/8/PPPP1PPP/RNBQKBNR w KQkq - 0 2",
+   "rnbqkb1r/ppp2ppp/4pn2/3p4/2PP4/2N5/PP2PPPP/R1BQKBNR w KQkq - 2 4",
+   "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+   "r1bq1rk1/pp2bppp/2n1pn2/3p4/2PP4/2N1PN2/PP3PPP/R2QKB1R w KQ - 0 8",
+   "2rq1rk1/pb1nbppp/1p2pn2/2pp4/2PP4/1PN1PN2/PB2BPPP/2RQ1RK1 w - - 0 11",
+   "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+   "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+   "6k1/5ppp/8/8/8/8/5PPP/3R2K1 w - - 0 1",
+   "8/5pk1/6p1/8/3R4/6P1/5PK1/r7 b - - 0 1",
+   "8/8/3k4/8/2NBK3/8/8/8 w - - 0 1"};
+
+
+struct Options
+{
+   std::size_t plies = 6;
+   BatchOptions batch{1, 16};
+};
+
+
+std::optional<std::size_t> readCount(const char* arg)
+{
+   char* end = nullptr;
+   const unsigned long count = std::strtoul(arg, &end, 10);
+   if (end == arg || *end != '\0' || count == 0)
+      return std::nullopt;
+   return static_cast<std::size_t>(count);
+}
+
+
+std::optional<Options> readOptions(int argc, char* argv[])
+{
+   Options options;
+   for (int i = 1; i + 1 < argc; i += 2)
+   {
+      const std::string arg = argv[i];
+      const std::optional<std::size_t> count = readCount(argv[i + 1]);
+      if (!count.has_value())
+         return std::nullopt;
+
+      if (arg == "--depth")
+         options.plies = *count;
+      else if (arg == "--threads")
+         options.batch.numWorkers = *count;
+      else if (arg == "--hash")
+         options.batch.hashSizeMB = *count;
+      else
+         return std::nullopt;
+   }
+   if (argc % 2 == 0)
+      return std::nullopt;
+   return options;
+}
+
+
+std::vector<BatchJob> makeJobs(std::size_t plies)
+{
+   std::vector<BatchJob> jobs;
+   for (const std::string_view notation : NotatedPositions)
+      jobs.push_back(BatchJob{Position{notation}, Color::White, {}});
+   for (const std::string_view fen : FenPositions)
+   {
+      const std::optional<FenPosition> pos = readFen(fen);
+      jobs.push_back(BatchJob{pos->pos, pos->side, {}});
+   }
+
+   for (BatchJob& job : jobs)
+      job.limits.plies = plies;
+   return jobs;
+}
+
+} // namespace
+
+
+int main(int argc, char* argv[])
+{
+   const std::optional<Options> options = readOptions(argc, argv);
+   if (!options.has_value())
+   {
+      std::cerr << "usage: matt_bench [--depth <plies>] [--threads <n>] [--hash <MB>]\n";
+      return EXIT_FAILURE;
+   }
+
+   using Clock = std::chrono::steady_clock;
+   const Clock::time_point start = Clock::now();
+   const std::vector<BatchJob> jobs = makeJobs(options->plies);
+   const std::vector<SearchResult> results =
+      searchBatch(jobs, options->batch, [](std::size_t idx, const SearchResult& result) {
+         std::cout << "position " << idx + 1 << ": " << result.nodes << " nodes in "
+                   << result.time.count() << " ms" << std::endl;
+      });
+   const auto elapsed =
+      std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start);
+
+   std::uint64_t nodes = 0;
+   for (const SearchResult& result : results)
+      nodes += result.nodes;
+   const std::uint64_t ms = static_cast<std::uint64_t>(elapsed.count());
+
+   std::cout << "\ntime (ms):    " << ms << "\n";
+   std::cout << "nodes:        " << nodes << "\n";
+   std::cout << "nodes/second: " << nodes * 1000 / std::max<std::uint64_t>(ms, 1)
+             << "\n";
+   std::cout << "signature:    " << nodes << "\n";
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,84 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#pragma once
+#include "square.h"
+#include <cstdint>
+#if defined(_MSC_VER)
+#include <bitset>
+#include <intrin.h>
+#endif
+
+
+///////////////////
+
+// Set of squares with one bit per square. Bit n is set if the square with index n
+// is part of the set.
+using Bitboard = std::uint64_t;
+
+inline constexpr Bitboard EmptyBB = 0;
+
+inline constexpr Bitboard bit(Square sq)
+{
+   return sq ? Bitboard{1} << sq.index() : EmptyBB;
+}
+
+inline constexpr bool isSet(Bitboard bb, Square sq)
+{
+   return (bb & bit(sq)) != 0;
+}
+
+
+///////////////////
+
+// Number of squares in a bitboard.
+inline int popcount(Bitboard bb)
+{
+#if defined(_MSC_VER) && defined(_M_X64) && defined(__AVX__)
+   // The intrinsic needs the POPCNT instruction, which every CPU with AVX has.
+   return static_cast<int>(__popcnt64(bb));
+#elif defined(_MSC_VER)
+   return static_cast<int>(std::bitset<64>{bb}.count());
+#else
+   return __builtin_popcountll(bb);
+#endif
+}
+
+
+// Square with the lowest index in a non-empty bitboard.
+inline Square lsb(Bitboard bb)
+{
+   assert(bb != EmptyBB);
+#if defined(_MSC_VER) && defined(_M_X64)
+   unsigned long idx = 0;
+   _BitScanForward64(&idx, bb);
+   return Square::fromIndex(idx);
+#elif defined(_MSC_VER)
+   unsigned long idx = 0;
+   if (_BitScanForward(&idx, static_cast<unsigned long>(bb)))
+      return Square::fromIndex(idx);
+   _BitScanForward(&idx, static_cast<unsigned long>(bb >> 32));
+   return Square::fromIndex(idx + 32);
+#else
+   return Square::fromIndex(__builtin_ctzll(bb));
+#endif
+}
+
+
+// Removes the square with the lowest index from a non-empty bitboard and returns
+// it.
+inline Square popLsb(Bitboard& bb)
+{
+   const Square sq = lsb(bb);
+   bb &= bb - 1;
+   return sq;
+}
+
+
+// Calls a function for each square of a bitboard in order of increasing index.
+template <typename Fn> void forEachSquare(Bitboard bb, Fn fn)
+{
+   while (bb != EmptyBB)
+      fn(popLsb(bb));
+}
@@ -0,0 +1,113 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#pragma once
+#include "fen.h"
+#include "mapped_file.h"
+#include "move.h"
+#include "piece.h"
+#include "zobrist.h"
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <utility>
+#include <vector>
+
+struct PgnGame;
+
+
+///////////////////
+
+// Entry of an opening book. Books are Polyglot .bin files: entries of 16 big-endian
+// bytes sorted by Polyglot key, so that the moves of a position are found by binary
+// search in the mapped file.
+struct BookEntry
+{
+   static constexpr std::size_t Size = 16;
+
+   HashKey key = 0;
+   std::uint16_t move = 0;
+   std::uint16_t weight = 0;
+   std::uint32_t learn = 0;
+};
+
+
+struct BookMove
+{
+   Move move;
+   std::uint16_t weight = 0;
+};
+
+
+// Polyglot key of a position. Includes the castling rights, the side to move and
+// the en passant file if a pawn can capture en passant.
+HashKey bookKey(const FenPosition& fen);
+
+// Moves are encoded like Polyglot does: the target and start squares in 6 bits
+// each and the promoted figure in 3 bits. Castling is encoded as the king moving
+// onto its own rook.
+std::uint16_t encodeBookMove(const Move& move, const Position& pos);
+// Returns nothing if the move does not fit the position.
+std::optional<Move> decodeBookMove(std::uint16_t code, const Position& pos, Color side);
+
+
+///////////////////
+
+// Opening book in a memory mapped file. Looking up a position touches only the
+// pages on the path of the binary search.
+class OpeningBook
+{
+ public:
+   // Returns nothing if the file cannot be mapped or is not a sequence of entries.
+   static std::optional<OpeningBook> open(const std::filesystem::path& path);
+
+   // Number of entries.
+   std::size_t size() const { return m_size; }
+   // Moves of a position in the book, highest weight first.
+   std::vector<BookMove> moves(const FenPosition& fen) const;
+   // Picks a move of a position with a probability that is proportional to its
+   // weight. Takes a random number, so that callers control the randomness.
+   std::optional<Move> pickMove(const FenPosition& fen, std::uint64_t random) const;
+
+ private:
+   explicit OpeningBook(MappedFile file);
+
+   BookEntry entry(std::size_t idx) const;
+   // Index of the first entry with a key not less than a given key.
+   std::size_t lowerBound(HashKey key) const;
+
+ private:
+   MappedFile m_file;
+   std::size_t m_size = 0;
+};
+
+
+///////////////////
+
+// Builds an opening book from games by counting how often moves were played.
+class BookBuilder
+{
+ public:
+   static constexpr std::size_t DefaultMaxPlies = 30;
+
+   // Only takes moves from the start of games.
+   explicit BookBuilder(std::size_t maxPlies = DefaultMaxPlies);
+
+   // Replays the game from the position of its FEN tag or the standard initial
+   // position.
+   void add(const PgnGame& game);
+   void add(const FenPosition& fen, const Move& move);
+   // Number of distinct moves.
+   std::size_t size() const { return m_counts.size(); }
+   // Writes the book sorted by key. Scales the weights to 16 bits.
+   // Returns false if the file cannot be written.
+   bool write(const std::filesystem::path& path) const;
+
+ private:
+   std::size_t m_maxPlies = DefaultMaxPlies;
+   // Number of times that each move was played per position key.
+   std::map<std::pair<HashKey, std::uint16_t>, std::uint64_t> m_counts;
+};
@@ -0,0 +1,296 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "engine.h"
+#include <utility>
+
+using Clock = std::chrono::steady_clock;
+
+
+namespace
+{
+///////////////////
+
+// Whether a ponder search with given limits finds the same result as a search with
+// other limits.
+bool haveSameLimits(const SearchLimits& a, const SearchLimits& b)
+{
+   return a.plies == b.plies && a.nodes == b.nodes && a.time == b.time &&
+          a.multiPv == b.multiPv && a.isParallel == b.isParallel &&
+          haveSameEvaluation(a, b);
+}
+
+} // namespace
+
+
+///////////////////
+
+Engine::Engine(std::size_t hashSizeMB) : m_tt{hashSizeMB}
+{
+}
+
+
+Engine::~Engine()
+{
+   stop();
+   wait();
+}
+
+
+void Engine::setHashSize(std::size_t sizeMB)
+{
+   stop();
+   wait();
+   m_tt.resize(sizeMB);
+}
+
+
+void Engine::setEvalCacheSize(std::size_t sizeMB)
+{
+   stop();
+   wait();
+   m_evalCache.resize(sizeMB);
+}
+
+
+void Engine::newGame()
+{
+   stop();
+   wait();
+   m_tt.clear();
+   m_evalCache.clear();
+}
+
+
+void Engine::setBook(std::optional<OpeningBook> book)
+{
+   stop();
+   wait();
+   m_book = std::move(book);
+}
+
+
+void Engine::setTablebases(Tablebases tablebases)
+{
+   stop();
+   wait();
+   m_tablebases = std::move(tablebases);
+}
+
+
+void Engine::go(const Position& pos, Color side, const SearchRequest& request,
+                SearchCallback onIteration, SearchCallback onResult)
+{
+   {
+      std::lock_guard lock{m_mutex};
+      if (m_ponderKey.has_value())
+      {
+         if (m_isPondering && !m_stop && *m_ponderKey == searchKey(pos.hash(), side) &&
+             haveSameLimits(m_ponderLimits, request.limits))
+         {
+            // Ponder hit. Keep searching and report to the new callbacks.
+            m_ponderKey.reset();
+            m_onIteration = std::move(onIteration);
+            m_onResult = std::move(onResult);
+            m_isInfinite = request.infinite;
+            if (request.time.has_value())
+               m_timeManager.emplace(*request.time, Clock::now());
+            else
+               m_timeManager.reset();
+            convertPonderSearch();
+            return;
+         }
+
+         // Ponder miss or other limits. Nobody waits for the result of the ponder
+         // search.
+         m_isDiscarded = true;
+      }
+   }
+
+   start(pos, side, request, std::move(onIteration), std::move(onResult));
+}
+
+
+void Engine::ponder(const Position& pos, Color side, const Move& predicted,
+                    const SearchRequest& request)
+{
+   const Position next = pos.makeMove(predicted);
+   SearchRequest ponderRequest = request;
+   ponderRequest.ponder = true;
+   start(next, side, ponderRequest, {}, {});
+
+   std::lock_guard lock{m_mutex};
+   m_ponderKey = searchKey(next.hash(), side);
+   m_ponderLimits = request.limits;
+}
+
+
+void Engine::stop()
+{
+   std::lock_guard lock{m_mutex};
+   m_stop = true;
+   m_changed.notify_all();
+}
+
+
+void Engine::ponderhit()
+{
+   std::lock_guard lock{m_mutex};
+   if (m_isPondering)
+      convertPonderSearch();
+}
+
+
+void Engine::wait()
+{
+   if (m_searchThread.joinable())
+      m_searchThread.join();
+   if (m_timerThread.joinable())
+      m_timerThread.join();
+}
+
+
+bool Engine::isSearching() const
+{
+   std::lock_guard lock{m_mutex};
+   return !m_isDone;
+}
+
+
+void Engine::start(const Position& pos, Color side, const SearchRequest& request,
+                   SearchCallback onIteration, SearchCallback onResult)
+{
+   stop();
+   wait();
+
+   {
+      std::lock_guard lock{m_mutex};
+      m_stop = false;
+      m_isDone = false;
+      m_isDiscarded = false;
+      m_isInfinite = request.infinite;
+      m_isPondering = request.ponder;
+      m_timeManager.reset();
+      m_deadline.reset();
+      if (request.time.has_value())
+      {
+         m_timeManager.emplace(*request.time, Clock::now());
+         if (!m_isPondering)
+            m_deadline = m_timeManager->deadline();
+      }
+      m_onIteration = std::move(onIteration);
+      m_onResult = std::move(onResult);
+      m_ponderKey.reset();
+   }
+
+   const bool useBook = !request.infinite && !request.ponder;
+   FenPosition fen{pos, side, request.castling, request.enPassant};
+   m_searchThread =
+      std::thread{&Engine::runSearch, this, std::move(fen), request.limits, useBook};
+   m_timerThread = std::thread{&Engine::runTimer, this};
+}
+
+
+void Engine::runSearch(FenPosition fen, SearchLimits limits, bool useBook)
+{
+   std::optional<Move> bookMove;
+   if (useBook && m_book.has_value())
+      bookMove = m_book->pickMove(fen, m_random());
+
+   SearchResult result;
+   if (bookMove.has_value())
+   {
+      result.pv.push_back(std::move(*bookMove));
+   }
+   else
+   {
+      const auto onIteration = [this](const SearchResult& iteration) {
+         reportIteration(iteration);
+      };
+      if (!m_evalCacheLimits || !haveSameEvaluation(*m_evalCacheLimits, limits))
+      {
+         m_evalCache.clear();
+         m_evalCacheLimits = limits;
+      }
+      result = search(fen.pos, fen.side, limits, m_tt, m_stop, onIteration,
+                      m_tablebases, &m_evalCache);
+   }
+
+   SearchCallback onResult;
+   {
+      // Infinite and ponder searches that end on their own wait until they get
+      // stopped or converted.
+      std::unique_lock lock{m_mutex};
+      m_changed.wait(lock, [this]() { return canReport(); });
+      if (!m_isDiscarded)
+         onResult = m_onResult;
+   }
+
+   if (onResult)
+      onResult(result);
+
+   std::lock_guard lock{m_mutex};
+   m_isDone = true;
+   m_changed.notify_all();
+}
+
+
+void Engine::reportIteration(const SearchResult& result)
+{
+   SearchCallback onIteration;
+   {
+      // The callback changes when a ponder search gets converted.
+      std::lock_guard lock{m_mutex};
+      onIteration = m_onIteration;
+
+      // Ponder searches learn about the best move but do not stop on their own.
+      const bool isDone =
+         m_timeManager.has_value() && m_timeManager->shouldStop(result, Clock::now());
+      if (isDone && !m_isInfinite && !m_isPondering)
+      {
+         m_stop = true;
+         m_changed.notify_all();
+      }
+   }
+
+   if (onIteration)
+      onIteration(result);
+}
+
+
+void Engine::runTimer()
+{
+   std::unique_lock lock{m_mutex};
+   while (!m_isDone && !m_stop)
+   {
+      if (!m_deadline.has_value())
+      {
+         m_changed.wait(lock);
+      }
+      else if (m_changed.wait_until(lock, *m_deadline) == std::cv_status::timeout &&
+               m_deadline.has_value() && Clock::now() >= *m_deadline)
+      {
+         m_stop = true;
+         m_changed.notify_all();
+      }
+   }
+}
+
+
+bool Engine::canReport() const
+{
+   return m_stop || (!m_isInfinite && !m_isPondering);
+}
+
+
+void Engine::convertPonderSearch()
+{
+   m_isPondering = false;
+   if (m_timeManager.has_value())
+   {
+      m_timeManager->restart(Clock::now());
+      m_deadline = m_timeManager->deadline();
+   }
+   m_changed.notify_all();
+}
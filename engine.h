@@ -0,0 +1,137 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#pragma once
+#include "book.h"
+#include "eval_cache.h"
+#include "fen.h"
+#include "matt.h"
+#include "position.h"
+#include "tablebase.h"
+#include "time_manager.h"
+#include "tt.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <thread>
+
+
+///////////////////
+
+// Parameters of an asynchronous search.
+struct SearchRequest
+{
+   SearchLimits limits;
+   // State of the game beyond the pieces. Only needed to look up the position in
+   // the book.
+   Castling castling = Castling::None;
+   Square enPassant;
+   // Time that the search may take. Unlimited if not given.
+   std::optional<TimeLimits> time;
+   // Searches until stopped. Holds back the result if the search ends on its own.
+   bool infinite = false;
+   // Searches on the opponent's time. Behaves like an infinite search until the
+   // ponder search is converted into a regular search. The move time starts when
+   // the search is converted.
+   bool ponder = false;
+};
+
+
+// Runs searches on a background thread, so that the caller stays responsive while
+// the engine thinks. Keeps the transposition table between searches.
+class Engine
+{
+ public:
+   explicit Engine(std::size_t hashSizeMB = TranspositionTable::DefaultSizeMB);
+   ~Engine();
+   Engine(const Engine&) = delete;
+   Engine& operator=(const Engine&) = delete;
+
+   // Stops a running search before changing the table.
+   void setHashSize(std::size_t sizeMB);
+   void setEvalCacheSize(std::size_t sizeMB);
+   // Forgets the results of earlier searches.
+   void newGame();
+   // Plays moves from a book without searching when the book knows the position.
+   // Infinite and ponder searches do not use the book.
+   void setBook(std::optional<OpeningBook> book);
+   // Replaces the solved endgames that the search looks up, e.g. to add table files
+   // to the built-in tables.
+   void setTablebases(Tablebases tablebases);
+
+   // Starts searching a position. Stops a running search first.
+   // Reports completed iterations and the final result through callbacks that get
+   // called on the search thread. The final result is reported exactly once per
+   // search, also if the search gets stopped.
+   // Continues a search started by ponder() if the position is the predicted one and
+   // the search limits are the same.
+   void go(const Position& pos, Color side, const SearchRequest& request,
+           SearchCallback onIteration, SearchCallback onResult);
+   // Thinks on the opponent's time. Takes a position with the opponent to move and
+   // the reply that the opponent is expected to play, and searches the position
+   // after the reply for the given side.
+   // If the next call of go() is for the predicted position with the same search
+   // limits, the ponder search turns into that regular search without losing its
+   // progress. Otherwise the ponder search is stopped, its result is discarded and
+   // go() starts a new search. Either way the table keeps what the ponder search
+   // found. Evaluations compare like haveSameEvaluation(), so a ponder search with
+   // an evaluation that is not a function pointer is never continued.
+   void ponder(const Position& pos, Color side, const Move& predicted,
+               const SearchRequest& request);
+   // Stops the search as soon as possible. Returns without waiting for the result.
+   void stop();
+   // Converts a ponder search into a regular search.
+   void ponderhit();
+   // Waits for the search to report its result.
+   void wait();
+   bool isSearching() const;
+
+ private:
+   void start(const Position& pos, Color side, const SearchRequest& request,
+              SearchCallback onIteration, SearchCallback onResult);
+   void runSearch(FenPosition fen, SearchLimits limits, bool useBook);
+   void reportIteration(const SearchResult& result);
+   // Stops the search when its hard time limit is reached.
+   void runTimer();
+   // Whether the result may be reported. Expects the mutex to be locked.
+   bool canReport() const;
+   // Starts the move time of a ponder search. Expects the mutex to be locked.
+   void convertPonderSearch();
+
+ private:
+   TranspositionTable m_tt;
+   EvalCache m_evalCache;
+   // Limits of the searches whose scores are in the evaluation cache. Only used by
+   // the search thread.
+   std::optional<SearchLimits> m_evalCacheLimits;
+   std::optional<OpeningBook> m_book;
+   Tablebases m_tablebases;
+   // Picks book moves. Only used by the search thread.
+   std::mt19937_64 m_random{std::random_device{}()};
+   std::atomic<bool> m_stop{false};
+   // Synchronizes the state that the searching and the timing thread share with
+   // the caller.
+   mutable std::mutex m_mutex;
+   std::condition_variable m_changed;
+   bool m_isDone = true;
+   bool m_isInfinite = false;
+   bool m_isPondering = false;
+   // Decides when a search with a time limit ends.
+   std::optional<TimeManager> m_timeManager;
+   std::optional<std::chrono::steady_clock::time_point> m_deadline;
+   SearchCallback m_onIteration;
+   SearchCallback m_onResult;
+   // Table key of the predicted position of a search started by ponder().
+   std::optional<HashKey> m_ponderKey;
+   // Limits of the search started by ponder().
+   SearchLimits m_ponderLimits;
+   // Whether the result of the search gets dropped.
+   bool m_isDiscarded = false;
+   std::thread m_searchThread;
+   std::thread m_timerThread;
+};
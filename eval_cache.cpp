@@ -0,0 +1,76 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "eval_cache.h"
+#include <algorithm>
+#include <cstring>
+
+
+namespace
+{
+///////////////////
+
+// Marks used slots, so that empty slots do not match the key zero.
+constexpr std::uint64_t UsedBit = std::uint64_t{1} << 32;
+
+} // namespace
+
+
+///////////////////
+
+EvalCache::EvalCache(std::size_t sizeMB)
+{
+   resize(sizeMB);
+}
+
+
+void EvalCache::resize(std::size_t sizeMB)
+{
+   const std::size_t maxSlots =
+      std::max<std::size_t>(sizeMB, 1) * 1024 * 1024 / sizeof(Slot);
+   // Round down to a power of two, so that slots are indexed by masking the key.
+   std::size_t size = 1;
+   while (size * 2 <= maxSlots)
+      size *= 2;
+
+   m_slots = std::make_unique<Slot[]>(size);
+   m_size = size;
+}
+
+
+void EvalCache::clear()
+{
+   for (std::size_t i = 0; i < m_size; ++i)
+   {
+      m_slots[i].key.store(0, std::memory_order_relaxed);
+      m_slots[i].data.store(0, std::memory_order_relaxed);
+   }
+}
+
+
+std::optional<float> EvalCache::probe(HashKey key) const
+{
+   const Slot& s = slot(key);
+   const std::uint64_t data = s.data.load(std::memory_order_relaxed);
+   if ((data & UsedBit) == 0 || (s.key.load(std::memory_order_relaxed) ^ data) != key)
+      return std::nullopt;
+
+   const auto scoreBits = static_cast<std::uint32_t>(data);
+   float score = 0.f;
+   std::memcpy(&score, &scoreBits, sizeof(scoreBits));
+   return score;
+}
+
+
+void EvalCache::store(HashKey key, float score)
+{
+   std::uint32_t scoreBits = 0;
+   static_assert(sizeof(scoreBits) == sizeof(score));
+   std::memcpy(&scoreBits, &score, sizeof(scoreBits));
+
+   Slot& s = slot(key);
+   const std::uint64_t data = std::uint64_t{scoreBits} | UsedBit;
+   s.key.store(key ^ data, std::memory_order_relaxed);
+   s.data.store(data, std::memory_order_relaxed);
+}
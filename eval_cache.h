@@ -0,0 +1,51 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#pragma once
+#include "zobrist.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+
+///////////////////
+
+// Static scores of positions shared between searches and searching threads, so
+// that positions that get evaluated again in later iterations or by other threads
+// are looked up instead.
+// Lockless like the transposition table. Each slot stores its key xor-ed with its
+// data, so that a torn slot does not match any key.
+class EvalCache
+{
+ public:
+   static constexpr std::size_t DefaultSizeMB = 1;
+
+   explicit EvalCache(std::size_t sizeMB = DefaultSizeMB);
+
+   // Clears the cache.
+   void resize(std::size_t sizeMB);
+   void clear();
+   std::size_t size() const { return m_size; }
+
+   // Takes the key of the pieces of a position. Scores are from the point of view of
+   // White, so they do not depend on the side to move.
+   std::optional<float> probe(HashKey key) const;
+   void store(HashKey key, float score);
+
+ private:
+   struct Slot
+   {
+      std::atomic<std::uint64_t> key{0};
+      std::atomic<std::uint64_t> data{0};
+   };
+
+   Slot& slot(HashKey key) const { return m_slots[key & (m_size - 1)]; }
+
+ private:
+   std::unique_ptr<Slot[]> m_slots;
+   // Power of two.
+   std::size_t m_size = 0;
+};
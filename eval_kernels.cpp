@@ -0,0 +1,367 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "eval_kernels.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define MATT_X86_SIMD
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+// GCC and Clang compile intrinsics only in functions that target their instruction
+// set. MSVC compiles them anywhere.
+#if defined(MATT_X86_SIMD) && !defined(_MSC_VER)
+#define MATT_TARGET(isa) __attribute__((target(isa)))
+#else
+#define MATT_TARGET(isa)
+#endif
+
+
+namespace
+{
+///////////////////
+
+std::int32_t pieceSquareSumScalar(const BoardCodes& codes,
+                                  const PieceSquareTables& tables)
+{
+   std::int32_t sum = 0;
+   for (std::size_t sq = 0; sq < Square::NumSquares; ++sq)
+      sum += tables[codes[sq] * Square::NumSquares + sq];
+   return sum;
+}
+
+
+std::int32_t weightedPopcountScalar(const Bitboard* boards, const std::int32_t* weights,
+                                    std::size_t count)
+{
+   std::int32_t sum = 0;
+   for (std::size_t i = 0; i < count; ++i)
+      sum += popcount(boards[i]) * weights[i];
+   return sum;
+}
+
+
+std::int32_t dotProductScalar(const std::uint8_t* inputs, const std::int8_t* weights,
+                              std::size_t count)
+{
+   std::int32_t sum = 0;
+   for (std::size_t i = 0; i < count; ++i)
+      sum += std::int32_t{inputs[i]} * std::int32_t{weights[i]};
+   return sum;
+}
+
+
+#ifdef MATT_X86_SIMD
+
+///////////////////
+
+MATT_TARGET("sse4.1") std::int32_t horizontalSum(__m128i v)
+{
+   v = _mm_hadd_epi32(v, v);
+   v = _mm_hadd_epi32(v, v);
+   return _mm_cvtsi128_si32(v);
+}
+
+
+// Counts the bits of each byte with a lookup table of the counts of nibbles.
+MATT_TARGET("sse4.1") __m128i popcountBytes(__m128i v)
+{
+   const __m128i lookup = _mm_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+   const __m128i lowNibbles = _mm_set1_epi8(0x0F);
+   const __m128i low = _mm_shuffle_epi8(lookup, _mm_and_si128(v, lowNibbles));
+   const __m128i high =
+      _mm_shuffle_epi8(lookup, _mm_and_si128(_mm_srli_epi16(v, 4), lowNibbles));
+   return _mm_add_epi8(low, high);
+}
+
+
+MATT_TARGET("sse4.1")
+std::int32_t pieceSquareSumSse41(const BoardCodes& codes, const PieceSquareTables& tables)
+{
+   // There is no gather before AVX2, so the values get loaded one by one and added
+   // four at a time.
+   __m128i sum = _mm_setzero_si128();
+   for (std::size_t sq = 0; sq < Square::NumSquares; sq += 4)
+   {
+      const std::int32_t* base = tables.data() + sq;
+      sum = _mm_add_epi32(
+         sum, _mm_setr_epi32(base[codes[sq] * Square::NumSquares],
+                             base[codes[sq + 1] * Square::NumSquares + 1],
+                             base[codes[sq + 2] * Square::NumSquares + 2],
+                             base[codes[sq + 3] * Square::NumSquares + 3]));
+   }
+   return horizontalSum(sum);
+}
+
+
+MATT_TARGET("sse4.1")
+std::int32_t weightedPopcountSse41(const Bitboard* boards, const std::int32_t* weights,
+                                   std::size_t count)
+{
+   // Two bitboards at a time. Their counts end up in the low halves of two 64-bit
+   // lanes, which get multiplied with the sign-extended weights.
+   __m128i sum = _mm_setzero_si128();
+   std::size_t i = 0;
+   for (; i + 2 <= count; i += 2)
+   {
+      const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(boards + i));
+      const __m128i counts = _mm_sad_epu8(popcountBytes(v), _mm_setzero_si128());
+      std::int64_t pair = 0;
+      std::memcpy(&pair, weights + i, sizeof(pair));
+      const __m128i w = _mm_cvtepi32_epi64(_mm_cvtsi64_si128(pair));
+      sum = _mm_add_epi64(sum, _mm_mul_epi32(counts, w));
+   }
+
+   std::int64_t lanes[2] = {};
+   _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), sum);
+   return static_cast<std::int32_t>(lanes[0] + lanes[1]) +
+          weightedPopcountScalar(boards + i, weights + i, count - i);
+}
+
+
+MATT_TARGET("sse4.1")
+std::int32_t dotProductSse41(const std::uint8_t* inputs, const std::int8_t* weights,
+                             std::size_t count)
+{
+   // Multiplies sixteen pairs at a time and adds adjacent products, first to 16 and
+   // then to 32 bits.
+   const __m128i ones = _mm_set1_epi16(1);
+   __m128i sum = _mm_setzero_si128();
+   std::size_t i = 0;
+   for (; i + 16 <= count; i += 16)
+   {
+      const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(inputs + i));
+      const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(weights + i));
+      sum = _mm_add_epi32(sum, _mm_madd_epi16(_mm_maddubs_epi16(a, b), ones));
+   }
+   return horizontalSum(sum) + dotProductScalar(inputs + i, weights + i, count - i);
+}
+
+
+///////////////////
+
+MATT_TARGET("avx2") std::int32_t horizontalSum(__m256i v)
+{
+   const __m128i half =
+      _mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+   return horizontalSum(half);
+}
+
+
+MATT_TARGET("avx2")
+std::int32_t pieceSquareSumAvx2(const BoardCodes& codes, const PieceSquareTables& tables)
+{
+   // Gathers the values of eight squares at a time.
+   const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+   __m256i sum = _mm256_setzero_si256();
+   for (std::size_t sq = 0; sq < Square::NumSquares; sq += 8)
+   {
+      const __m256i rows = _mm256_cvtepu8_epi32(
+         _mm_loadl_epi64(reinterpret_cast<const __m128i*>(codes.data() + sq)));
+      const __m256i squares =
+         _mm256_add_epi32(lanes, _mm256_set1_epi32(static_cast<int>(sq)));
+      // Rows of 64 values per piece code.
+      const __m256i idx = _mm256_add_epi32(_mm256_slli_epi32(rows, 6), squares);
+      sum = _mm256_add_epi32(sum,
+                             _mm256_i32gather_epi32(
+                                reinterpret_cast<const int*>(tables.data()), idx, 4));
+   }
+   return horizontalSum(sum);
+}
+
+
+MATT_TARGET("avx2")
+std::int32_t weightedPopcountAvx2(const Bitboard* boards, const std::int32_t* weights,
+                                  std::size_t count)
+{
+   const __m256i lookup =
+      _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1, 1, 2, 1, 2,
+                       2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+   const __m256i lowNibbles = _mm256_set1_epi8(0x0F);
+
+   // Four bitboards at a time.
+   __m256i sum = _mm256_setzero_si256();
+   std::size_t i = 0;
+   for (; i + 4 <= count; i += 4)
+   {
+      const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(boards + i));
+      const __m256i low = _mm256_shuffle_epi8(lookup, _mm256_and_si256(v, lowNibbles));
+      const __m256i high = _mm256_shuffle_epi8(
+         lookup, _mm256_and_si256(_mm256_srli_epi16(v, 4), lowNibbles));
+      const __m256i counts =
+         _mm256_sad_epu8(_mm256_add_epi8(low, high), _mm256_setzero_si256());
+      const __m256i w = _mm256_cvtepi32_epi64(
+         _mm_loadu_si128(reinterpret_cast<const __m128i*>(weights + i)));
+      sum = _mm256_add_epi64(sum, _mm256_mul_epi32(counts, w));
+   }
+
+   std::int64_t lanes[4] = {};
+   _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), sum);
+   return static_cast<std::int32_t>(lanes[0] + lanes[1] + lanes[2] + lanes[3]) +
+          weightedPopcountScalar(boards + i, weights + i, count - i);
+}
+
+
+MATT_TARGET("avx2")
+std::int32_t dotProductAvx2(const std::uint8_t* inputs, const std::int8_t* weights,
+                            std::size_t count)
+{
+   const __m256i ones = _mm256_set1_epi16(1);
+   __m256i sum = _mm256_setzero_si256();
+   std::size_t i = 0;
+   for (; i + 32 <= count; i += 32)
+   {
+      const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(inputs + i));
+      const __m256i b =
+         _mm256_loadu_si256(reinterpret_cast<const __m256i*>(weights + i));
+      sum = _mm256_add_epi32(sum, _mm256_madd_epi16(_mm256_maddubs_epi16(a, b), ones));
+   }
+   return horizontalSum(sum) + dotProductScalar(inputs + i, weights + i, count - i);
+}
+
+
+///////////////////
+
+struct CpuFeatures
+{
+   bool sse41 = false;
+   bool avx2 = false;
+};
+
+
+#if defined(_MSC_VER)
+
+CpuFeatures readCpuFeatures()
+{
+   int info[4] = {};
+   __cpuid(info, 0);
+   const int maxLeaf = info[0];
+   __cpuid(info, 1);
+   const int ecx = info[2];
+
+   CpuFeatures features;
+   features.sse41 = (ecx & (1 << 19)) != 0;
+   // AVX registers need to be saved by the operating system.
+   const bool hasAvx = (ecx & (1 << 27)) != 0 && (ecx & (1 << 28)) != 0 &&
+                       (_xgetbv(0) & 6) == 6;
+   if (hasAvx && maxLeaf >= 7)
+   {
+      __cpuidex(info, 7, 0);
+      features.avx2 = (info[1] & (1 << 5)) != 0;
+   }
+   return features;
+}
+
+#else
+
+MATT_TARGET("xsave") unsigned long long readXcr0()
+{
+   return _xgetbv(0);
+}
+
+
+CpuFeatures readCpuFeatures()
+{
+   unsigned int eax = 0;
+   unsigned int ebx = 0;
+   unsigned int ecx = 0;
+   unsigned int edx = 0;
+   const unsigned int maxLeaf = __get_cpuid_max(0, nullptr);
+   if (maxLeaf < 1)
+      return {};
+   __cpuid(1, eax, ebx, ecx, edx);
+
+   CpuFeatures features;
+   features.sse41 = (ecx & bit_SSE4_1) != 0;
+   // AVX registers need to be saved by the operating system.
+   const bool hasAvx =
+      (ecx & bit_OSXSAVE) != 0 && (ecx & bit_AVX) != 0 && (readXcr0() & 6) == 6;
+   if (hasAvx && maxLeaf >= 7)
+   {
+      __cpuid_count(7, 0, eax, ebx, ecx, edx);
+      features.avx2 = (ebx & bit_AVX2) != 0;
+   }
+   return features;
+}
+
+#endif
+#endif // MATT_X86_SIMD
+
+
+SimdLevel readSimdLevel()
+{
+#ifdef MATT_X86_SIMD
+   const CpuFeatures features = readCpuFeatures();
+   if (features.avx2 && features.sse41)
+      return SimdLevel::Avx2;
+   if (features.sse41)
+      return SimdLevel::Sse41;
+#endif
+   return SimdLevel::Scalar;
+}
+
+
+const std::array<EvalKernels, 3>& allKernels()
+{
+   static const std::array<EvalKernels, 3> kernels = {
+      EvalKernels{SimdLevel::Scalar, pieceSquareSumScalar, weightedPopcountScalar,
+                  dotProductScalar},
+#ifdef MATT_X86_SIMD
+      EvalKernels{SimdLevel::Sse41, pieceSquareSumSse41, weightedPopcountSse41,
+                  dotProductSse41},
+      EvalKernels{SimdLevel::Avx2, pieceSquareSumAvx2, weightedPopcountAvx2,
+                  dotProductAvx2},
+#else
+      // Never selected without SIMD support.
+      EvalKernels{},
+      EvalKernels{},
+#endif
+   };
+   return kernels;
+}
+
+} // namespace
+
+
+///////////////////
+
+std::string_view notateSimdLevel(SimdLevel level)
+{
+   switch (level)
+   {
+   case SimdLevel::Sse41:
+      return "sse4.1";
+   case SimdLevel::Avx2:
+      return "avx2";
+   default:
+      return "scalar";
+   }
+}
+
+
+SimdLevel detectSimdLevel()
+{
+   static const SimdLevel level = readSimdLevel();
+   return level;
+}
+
+
+const EvalKernels& evalKernels(SimdLevel level)
+{
+   const SimdLevel supported = std::min(level, detectSimdLevel());
+   return allKernels()[static_cast<std::size_t>(supported)];
+}
+
+
+const EvalKernels& evalKernels()
+{
+   return evalKernels(detectSimdLevel());
+}
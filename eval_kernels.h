@@ -0,0 +1,67 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#pragma once
+#include "bitboard.h"
+#include "piece.h"
+#include "square.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+
+///////////////////
+
+// Instruction sets that the evaluation kernels can use, from slowest to fastest.
+enum class SimdLevel
+{
+   Scalar,
+   Sse41,
+   Avx2
+};
+
+std::string_view notateSimdLevel(SimdLevel level);
+// Best instruction set that the CPU and the operating system support. Asks CPUID
+// once.
+SimdLevel detectSimdLevel();
+
+
+///////////////////
+
+// Codes of the pieces on the board. Zero for empty squares.
+inline constexpr std::size_t NumPieceCodes = 1 + NumColors * NumFigures;
+using BoardCodes = std::array<std::uint8_t, Square::NumSquares>;
+// One value per piece code and square. The values of empty squares are zero.
+using PieceSquareTables = std::array<std::int32_t, NumPieceCodes * Square::NumSquares>;
+
+inline constexpr std::uint8_t pieceCode(Color side, Figure figure)
+{
+   return static_cast<std::uint8_t>(1 + static_cast<std::size_t>(side) * NumFigures +
+                                    static_cast<std::size_t>(figure));
+}
+
+
+// Inner loops of the evaluation. Work on integers, so that all instruction sets
+// compute exactly the same results.
+struct EvalKernels
+{
+   SimdLevel level = SimdLevel::Scalar;
+   // Sum of the table values of the pieces on their squares.
+   std::int32_t (*pieceSquareSum)(const BoardCodes& codes,
+                                  const PieceSquareTables& tables) = nullptr;
+   // Sum of the number of squares of each bitboard times its weight.
+   std::int32_t (*weightedPopcount)(const Bitboard* boards, const std::int32_t* weights,
+                                    std::size_t count) = nullptr;
+   // Sum of the products of the inputs and weights of a quantized network layer.
+   // Expects inputs of at most 127, so that the sums of two products fit 16 bits.
+   std::int32_t (*dotProduct)(const std::uint8_t* inputs, const std::int8_t* weights,
+                              std::size_t count) = nullptr;
+};
+
+// Kernels for a given instruction set. Falls back to the best supported instruction
+// set below it.
+const EvalKernels& evalKernels(SimdLevel level);
+// Kernels for the best supported instruction set.
+const EvalKernels& evalKernels();
@@ -0,0 +1,156 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "evaluation.h"
+#include "attack_tables.h"
+#include "position.h"
+#include <algorithm>
+#include <array>
+
+
+namespace
+{
+///////////////////
+
+// Positional terms are in hundredths of a pawn.
+constexpr float PositionalUnit = 0.01f;
+
+// Indexed by figure.
+constexpr std::array<std::int32_t, NumFigures> MobilityWeights = {0, 2, 3, 5, 4, 0};
+constexpr std::array<std::int32_t, NumFigures> KingZoneWeights = {0, 12, 10, 8, 8, 5};
+
+// Two terms for each piece at most.
+constexpr std::size_t MaxTerms = 2 * Square::NumSquares;
+
+
+// Distance of a file or rank from the center, zero for the central files and ranks.
+constexpr int centerDistance(int coord)
+{
+   return coord < 4 ? 3 - coord : coord - 4;
+}
+
+
+// Value of a white piece on a square. Index zero is a1, index 63 is h8.
+constexpr std::int32_t whiteSquareValue(Figure figure, int file, int rank)
+{
+   // Zero in the four center squares, three on the edges.
+   const int ring = std::max(centerDistance(file), centerDistance(rank));
+   switch (figure)
+   {
+   case Figure::King:
+      // Stays behind its pawns.
+      return rank == 0 ? (file == 1 || file == 2 || file == 6 ? 15 : 5) : -5 * rank;
+   case Figure::Queen:
+      return (3 - ring) * 2 - 3;
+   case Figure::Rook:
+      return (rank == 6 ? 15 : 0) + (centerDistance(file) == 0 ? 3 : 0);
+   case Figure::Bishop:
+      return (3 - ring) * 5 - 5;
+   case Figure::Knight:
+      return (3 - ring) * 8 - 12;
+   case Figure::Pawn:
+      if (rank == 0 || rank == 7)
+         return 0;
+      return (rank - 1) * 6 + (centerDistance(file) == 0 && rank > 1 ? 8 : 0);
+   default:
+      return 0;
+   }
+}
+
+
+// Values of the pieces of both sides from the point of view of White. Black pieces
+// get the values of the white pieces on the squares mirrored by rank.
+constexpr PieceSquareTables makePieceSquareTables()
+{
+   PieceSquareTables tables{};
+   for (std::size_t f = 0; f < NumFigures; ++f)
+   {
+      const Figure figure = static_cast<Figure>(f);
+      const std::size_t whiteRow = pieceCode(Color::White, figure) * Square::NumSquares;
+      const std::size_t blackRow = pieceCode(Color::Black, figure) * Square::NumSquares;
+      for (int idx = 0; idx < static_cast<int>(Square::NumSquares); ++idx)
+      {
+         const std::int32_t value = whiteSquareValue(figure, idx % 8, idx / 8);
+         tables[whiteRow + static_cast<std::size_t>(idx)] = value;
+         tables[blackRow + static_cast<std::size_t>(idx ^ 56)] = -value;
+      }
+   }
+   return tables;
+}
+
+constexpr PieceSquareTables PieceSquareValues = makePieceSquareTables();
+
+
+Bitboard attacksOf(Figure figure, Color side, Square from, Bitboard occupied)
+{
+   switch (figure)
+   {
+   case Figure::King:
+      return kingAttacks(from);
+   case Figure::Queen:
+      return rookAttacks(from, occupied) | bishopAttacks(from, occupied);
+   case Figure::Rook:
+      return rookAttacks(from, occupied);
+   case Figure::Bishop:
+      return bishopAttacks(from, occupied);
+   case Figure::Knight:
+      return knightAttacks(from);
+   case Figure::Pawn:
+      return pawnAttacks(side, from);
+   default:
+      return EmptyBB;
+   }
+}
+
+} // namespace
+
+
+///////////////////
+
+float evaluatePosition(const Position& pos)
+{
+   return evaluatePosition(pos, evalKernels());
+}
+
+
+float evaluatePosition(const Position& pos, const EvalKernels& kernels)
+{
+   BoardCodes codes{};
+   // Squares that the pieces reach and squares around the enemy king that they
+   // attack, weighted by figure.
+   std::array<Bitboard, MaxTerms> boards{};
+   std::array<std::int32_t, MaxTerms> weights{};
+   std::size_t numTerms = 0;
+
+   for (const Color side : {Color::White, Color::Black})
+   {
+      const std::int32_t sign = side == Color::White ? 1 : -1;
+      const Bitboard own = pos.occupied(side);
+      const SquareList& enemyKing = pos.squares(!side, Figure::King);
+      const Bitboard kingZone =
+         enemyKing.empty() ? EmptyBB : kingAttacks(enemyKing[0]) | bit(enemyKing[0]);
+
+      for (std::size_t f = 0; f < NumFigures; ++f)
+      {
+         const Figure figure = static_cast<Figure>(f);
+         for (const Square sq : pos.squares(side, figure))
+         {
+            codes[sq.index()] = pieceCode(side, figure);
+            if (MobilityWeights[f] == 0 && KingZoneWeights[f] == 0)
+               continue;
+
+            const Bitboard attacks = attacksOf(figure, side, sq, pos.occupied());
+            boards[numTerms] = attacks & ~own;
+            weights[numTerms++] = sign * MobilityWeights[f];
+            boards[numTerms] = attacks & kingZone;
+            weights[numTerms++] = sign * KingZoneWeights[f];
+         }
+      }
+   }
+
+   const std::int32_t positional =
+      kernels.pieceSquareSum(codes, PieceSquareValues) +
+      kernels.weightedPopcount(boards.data(), weights.data(), numTerms);
+   return pos.score() + static_cast<float>(positional) * PositionalUnit;
+}
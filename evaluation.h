@@ -0,0 +1,19 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#pragma once
+#include "eval_kernels.h"
+
+class Position;
+
+
+///////////////////
+
+// Scores a position by its material and by positional terms: where the pieces
+// stand, how many squares they reach and how many squares around the enemy king
+// they attack. From the point of view of White in the units of Position::score.
+// Uses the fastest kernels that the CPU supports.
+float evaluatePosition(const Position& pos);
+// Uses given kernels, e.g. to compare the instruction sets.
+float evaluatePosition(const Position& pos, const EvalKernels& kernels);
@@ -0,0 +1,394 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "fen.h"
+#include "attack_tables.h"
+#include <algorithm>
+#include <cassert>
+#include <charconv>
+#include <cstdlib>
+#include <limits>
+
+
+namespace
+{
+///////////////////
+
+// Reads the fields of a FEN string one after the other.
+class FenReader
+{
+ public:
+   explicit FenReader(std::string_view fen) : m_fen{fen} {}
+
+   // Returns the next space separated field. Empty at the end of the input.
+   std::string_view nextField();
+   bool atEnd();
+
+ private:
+   void skipSpaces();
+
+ private:
+   std::string_view m_fen;
+   std::size_t m_pos = 0;
+};
+
+
+std::string_view FenReader::nextField()
+{
+   skipSpaces();
+   const std::size_t start = m_pos;
+   while (m_pos < m_fen.size() && m_fen[m_pos] != ' ')
+      ++m_pos;
+   return m_fen.substr(start, m_pos - start);
+}
+
+
+bool FenReader::atEnd()
+{
+   skipSpaces();
+   return m_pos == m_fen.size();
+}
+
+
+void FenReader::skipSpaces()
+{
+   while (m_pos < m_fen.size() && m_fen[m_pos] == ' ')
+      ++m_pos;
+}
+
+
+///////////////////
+
+constexpr std::size_t BoardSize = 8;
+
+
+std::optional<Figure> fenFigure(char ch)
+{
+   switch (ch)
+   {
+   case 'k':
+      return Figure::King;
+   case 'q':
+      return Figure::Queen;
+   case 'r':
+      return Figure::Rook;
+   case 'b':
+      return Figure::Bishop;
+   case 'n':
+      return Figure::Knight;
+   case 'p':
+      return Figure::Pawn;
+   default:
+      return std::nullopt;
+   }
+}
+
+
+char fenChar(Figure figure, Color side)
+{
+   static constexpr std::array<char, NumFigures> Chars = {'k', 'q', 'r', 'b', 'n', 'p'};
+   const char ch = Chars[static_cast<std::size_t>(figure)];
+   // White pieces are upper case.
+   return side == Color::White ? static_cast<char>(ch - 'a' + 'A') : ch;
+}
+
+
+std::optional<Castling> readCastling(std::string_view field)
+{
+   if (field == "-")
+      return Castling::None;
+   if (field.empty())
+      return std::nullopt;
+
+   Castling rights = Castling::None;
+   for (const char ch : field)
+   {
+      switch (ch)
+      {
+      case 'K':
+         rights = rights | Castling::WhiteKingside;
+         break;
+      case 'Q':
+         rights = rights | Castling::WhiteQueenside;
+         break;
+      case 'k':
+         rights = rights | Castling::BlackKingside;
+         break;
+      case 'q':
+         rights = rights | Castling::BlackQueenside;
+         break;
+      default:
+         return std::nullopt;
+      }
+   }
+   return rights;
+}
+
+
+std::optional<Square> readEnPassant(std::string_view field)
+{
+   if (field == "-")
+      return Square{};
+   if (field.size() != 2)
+      return std::nullopt;
+
+   // Only squares behind a pawn that just moved two squares.
+   const Square sq{field};
+   if (!sq || (sq.rank() != '3' && sq.rank() != '6'))
+      return std::nullopt;
+   return sq;
+}
+
+
+// Reads a move counter. Missing counters get a default value.
+std::optional<std::size_t> readCounter(std::string_view field, std::size_t defaultValue)
+{
+   if (field.empty())
+      return defaultValue;
+
+   std::size_t value = 0;
+   const char* last = field.data() + field.size();
+   const auto [end, ec] = std::from_chars(field.data(), last, value);
+   if (ec != std::errc{} || end != last)
+      return std::nullopt;
+   return value;
+}
+
+
+// Castling rights that are lost when a piece moves from or to a square.
+Castling lostCastling(Square sq)
+{
+   switch (sq.index())
+   {
+   case Square{"e1"}.index():
+      return Castling::WhiteKingside | Castling::WhiteQueenside;
+   case Square{"h1"}.index():
+      return Castling::WhiteKingside;
+   case Square{"a1"}.index():
+      return Castling::WhiteQueenside;
+   case Square{"e8"}.index():
+      return Castling::BlackKingside | Castling::BlackQueenside;
+   case Square{"h8"}.index():
+      return Castling::BlackKingside;
+   case Square{"a8"}.index():
+      return Castling::BlackQueenside;
+   default:
+      return Castling::None;
+   }
+}
+
+
+// Writes characters into a buffer.
+class FenWriter
+{
+ public:
+   explicit FenWriter(FenBuffer& buffer) : m_buffer{buffer} {}
+
+   void put(char ch);
+   void put(std::string_view str);
+   void put(std::size_t number);
+   std::string_view written() const { return {m_buffer.data(), m_size}; }
+
+ private:
+   FenBuffer& m_buffer;
+   std::size_t m_size = 0;
+};
+
+
+void FenWriter::put(char ch)
+{
+   assert(m_size < m_buffer.size());
+   m_buffer[m_size++] = ch;
+}
+
+
+void FenWriter::put(std::string_view str)
+{
+   for (const char ch : str)
+      put(ch);
+}
+
+
+void FenWriter::put(std::size_t number)
+{
+   const auto [end, ec] =
+      std::to_chars(m_buffer.data() + m_size, m_buffer.data() + m_buffer.size(), number);
+   assert(ec == std::errc{});
+   m_size = static_cast<std::size_t>(end - m_buffer.data());
+}
+
+} // namespace
+
+
+///////////////////
+
+std::optional<FenPosition> readFen(std::string_view fen)
+{
+   FenReader reader{fen};
+   FenPosition result;
+   Position& pos = result.pos;
+
+   // Pieces, starting with the 8th rank.
+   const std::string_view board = reader.nextField();
+   std::size_t rank = BoardSize - 1;
+   std::size_t file = 0;
+   for (const char ch : board)
+   {
+      if (ch == '/')
+      {
+         if (file != BoardSize || rank == 0)
+            return std::nullopt;
+         --rank;
+         file = 0;
+      }
+      else if (ch >= '1' && ch <= '8')
+      {
+         file += static_cast<std::size_t>(ch - '0');
+         if (file > BoardSize)
+            return std::nullopt;
+      }
+      else
+      {
+         const bool isWhite = ch >= 'A' && ch <= 'Z';
+         const auto figure = fenFigure(isWhite ? static_cast<char>(ch - 'A' + 'a') : ch);
+         if (!figure.has_value() || file >= BoardSize)
+            return std::nullopt;
+
+         const Color side = isWhite ? Color::White : Color::Black;
+         if (pos.squares(side, *figure).size() == SquareList::Capacity)
+            return std::nullopt;
+         pos.addPiece(Piece{*figure, side, Square::fromIndex(rank * BoardSize + file)});
+         ++file;
+      }
+   }
+   if (rank != 0 || file != BoardSize)
+      return std::nullopt;
+
+   const std::string_view side = reader.nextField();
+   if (side != "w" && side != "b")
+      return std::nullopt;
+   result.side = makeColor(side);
+
+   const auto castling = readCastling(reader.nextField());
+   if (!castling.has_value())
+      return std::nullopt;
+   result.castling = *castling;
+
+   const auto enPassant = readEnPassant(reader.nextField());
+   if (!enPassant.has_value())
+      return std::nullopt;
+   result.enPassant = *enPassant;
+
+   const auto halfmoveClock = readCounter(reader.nextField(), 0);
+   const auto fullmoveNumber = readCounter(reader.nextField(), 1);
+   if (!halfmoveClock.has_value() || !fullmoveNumber.has_value() || !reader.atEnd())
+      return std::nullopt;
+   result.halfmoveClock = *halfmoveClock;
+   result.fullmoveNumber = *fullmoveNumber;
+
+   pos.m_reversiblePlies = static_cast<std::uint16_t>(
+      std::min<std::size_t>(*halfmoveClock, std::numeric_limits<std::uint16_t>::max()));
+   pos.m_record = Record{pos.m_hash};
+   pos.m_score = pos.calcScore();
+   return result;
+}
+
+
+FenPosition makeMove(const FenPosition& fen, const Move& move)
+{
+   const Piece& piece = move.piece();
+   const bool isPawn = piece.figure() == Figure::Pawn;
+   const bool isCapture = fen.pos[move.to()].has_value();
+
+   FenPosition next;
+   next.pos = fen.pos.makeMove(move);
+   next.side = !fen.side;
+   next.castling = fen.castling & ~lostCastling(move.from()) & ~lostCastling(move.to());
+   if (isPawn && std::abs(move.to().rankIndex() - move.from().rankIndex()) == 2)
+   {
+      next.enPassant = Square::fromIndex((move.from().index() + move.to().index()) / 2);
+      if (!canCaptureEnPassant(next))
+         next.enPassant = Square{};
+   }
+   next.halfmoveClock = isPawn || isCapture ? 0 : fen.halfmoveClock + 1;
+   next.fullmoveNumber = fen.fullmoveNumber + (fen.side == Color::Black ? 1 : 0);
+   return next;
+}
+
+
+bool canCaptureEnPassant(const FenPosition& fen)
+{
+   if (!fen.enPassant)
+      return false;
+   for (const Square sq : fen.pos.squares(fen.side, Figure::Pawn))
+      if (isSet(pawnAttacks(fen.side, sq), fen.enPassant))
+         return true;
+   return false;
+}
+
+
+std::string_view writeFen(const FenPosition& fen, FenBuffer& buffer)
+{
+   FenWriter out{buffer};
+
+   for (std::size_t rank = BoardSize; rank-- > 0;)
+   {
+      std::size_t empty = 0;
+      for (std::size_t file = 0; file < BoardSize; ++file)
+      {
+         const auto piece = fen.pos[Square::fromIndex(rank * BoardSize + file)];
+         if (!piece.has_value())
+         {
+            ++empty;
+            continue;
+         }
+         if (empty > 0)
+            out.put(static_cast<char>('0' + empty));
+         empty = 0;
+         out.put(fenChar(piece->figure(), piece->color()));
+      }
+      if (empty > 0)
+         out.put(static_cast<char>('0' + empty));
+      if (rank > 0)
+         out.put('/');
+   }
+
+   out.put(fen.side == Color::White ? " w " : " b ");
+
+   if (fen.castling == Castling::None)
+      out.put('-');
+   if (hasCastling(fen.castling, Castling::WhiteKingside))
+      out.put('K');
+   if (hasCastling(fen.castling, Castling::WhiteQueenside))
+      out.put('Q');
+   if (hasCastling(fen.castling, Castling::BlackKingside))
+      out.put('k');
+   if (hasCastling(fen.castling, Castling::BlackQueenside))
+      out.put('q');
+
+   out.put(' ');
+   if (fen.enPassant)
+   {
+      out.put(fen.enPassant.file());
+      out.put(fen.enPassant.rank());
+   }
+   else
+   {
+      out.put('-');
+   }
+
+   out.put(' ');
+   out.put(fen.halfmoveClock);
+   out.put(' ');
+   out.put(fen.fullmoveNumber);
+
+   return out.written();
+}
+
+
+std::string writeFen(const FenPosition& fen)
+{
+   FenBuffer buffer;
+   return std::string{writeFen(fen, buffer)};
+}
@@ -0,0 +1,95 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#pragma once
+#include "move.h"
+#include "piece.h"
+#include "position.h"
+#include "square.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+
+///////////////////
+
+// Castling rights as a set of flags.
+enum class Castling : std::uint8_t
+{
+   None = 0,
+   WhiteKingside = 1,
+   WhiteQueenside = 2,
+   BlackKingside = 4,
+   BlackQueenside = 8,
+   All = 15
+};
+
+inline constexpr Castling operator|(Castling a, Castling b)
+{
+   return static_cast<Castling>(static_cast<std::uint8_t>(a) |
+                                static_cast<std::uint8_t>(b));
+}
+
+inline constexpr Castling operator&(Castling a, Castling b)
+{
+   return static_cast<Castling>(static_cast<std::uint8_t>(a) &
+                                static_cast<std::uint8_t>(b));
+}
+
+inline constexpr Castling operator~(Castling rights)
+{
+   return static_cast<Castling>(~static_cast<std::uint8_t>(rights) &
+                                static_cast<std::uint8_t>(Castling::All));
+}
+
+inline constexpr bool hasCastling(Castling rights, Castling flag)
+{
+   return (rights & flag) != Castling::None;
+}
+
+
+///////////////////
+
+// Position in Forsyth-Edwards notation together with the game state that the
+// notation describes beyond the pieces.
+struct FenPosition
+{
+   Position pos;
+   Color side = Color::White;
+   Castling castling = Castling::None;
+   // Invalid if no en passant capture is possible.
+   Square enPassant;
+   std::size_t halfmoveClock = 0;
+   std::size_t fullmoveNumber = 1;
+};
+
+
+// Reads a FEN string in a single pass without allocating memory. The move
+// counters are optional and default to 0 and 1.
+// Returns nothing for malformed input.
+std::optional<FenPosition> readFen(std::string_view fen);
+
+// Makes a move and updates the castling rights, the en passant square and the move
+// counters. The en passant square is only set if a pawn can capture en passant.
+FenPosition makeMove(const FenPosition& fen, const Move& move);
+
+// Whether a pawn of the side to move attacks the en passant square. Does not check
+// if the capture leaves the king in check.
+bool canCaptureEnPassant(const FenPosition& fen);
+
+// Enough for the longest possible FEN string.
+inline constexpr std::size_t MaxFenLength = 128;
+using FenBuffer = std::array<char, MaxFenLength>;
+
+// Writes a FEN string into a given buffer without allocating memory. The returned
+// view refers to the buffer.
+std::string_view writeFen(const FenPosition& fen, FenBuffer& buffer);
+std::string writeFen(const FenPosition& fen);
+
+// Standard initial position of a game.
+inline constexpr std::string_view StartFen =
+   "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
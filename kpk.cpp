@@ -0,0 +1,341 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "kpk.h"
+#include "attack_tables.h"
+#include "position.h"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+
+namespace
+{
+///////////////////
+
+// Positions are stored with White as the side with the pawn and the pawn on the
+// files a to d. Other positions are mirrored into this form.
+constexpr std::size_t NumPawnFiles = 4;
+constexpr std::size_t NumPawnRanks = 6;
+constexpr std::size_t NumEntries =
+   NumPawnFiles * NumPawnRanks * Square::NumSquares * Square::NumSquares * 2;
+
+
+struct KpkPosition
+{
+   Square strongKing;
+   Square pawn;
+   Square weakKing;
+   bool isStrongToMove = true;
+};
+
+
+std::size_t index(const KpkPosition& p)
+{
+   const std::size_t pawnIdx =
+      (p.pawn.rankIndex() - 1) * NumPawnFiles + p.pawn.fileIndex();
+   return ((pawnIdx * Square::NumSquares + p.strongKing.index()) * Square::NumSquares +
+           p.weakKing.index()) *
+             2 +
+          (p.isStrongToMove ? 0 : 1);
+}
+
+
+KpkPosition position(std::size_t idx)
+{
+   KpkPosition p;
+   p.isStrongToMove = idx % 2 == 0;
+   idx /= 2;
+   p.weakKing = Square::fromIndex(idx % Square::NumSquares);
+   idx /= Square::NumSquares;
+   p.strongKing = Square::fromIndex(idx % Square::NumSquares);
+   idx /= Square::NumSquares;
+   p.pawn = Square::fromIndex((idx / NumPawnFiles + 1) * 8 + idx % NumPawnFiles);
+   return p;
+}
+
+
+Square forward(Square sq, int ranks)
+{
+   return Square::fromIndex(sq.index() + 8 * ranks);
+}
+
+
+// Plies until the pawn reaches the last rank.
+using Distance = std::uint8_t;
+constexpr Distance NoDistance = std::numeric_limits<Distance>::max();
+
+
+enum class Result : std::uint8_t
+{
+   Invalid,
+   Unknown,
+   Draw,
+   Win
+};
+
+
+// Result of a position that is decided without looking at its moves.
+Result classify(const KpkPosition& p)
+{
+   if (p.strongKing == p.pawn || p.weakKing == p.pawn ||
+       chebyshevDistance(p.strongKing, p.weakKing) <= 1)
+      return Result::Invalid;
+
+   const Bitboard pawnAttacked = pawnAttacks(Color::White, p.pawn);
+   if (p.isStrongToMove)
+   {
+      // The weak king cannot be in check when the strong side moves.
+      if (isSet(pawnAttacked, p.weakKing))
+         return Result::Invalid;
+
+      // Promotes to a queen that cannot be taken.
+      if (p.pawn.rank() == '7')
+      {
+         const Square queen = forward(p.pawn, 1);
+         if (queen != p.strongKing && queen != p.weakKing &&
+             (chebyshevDistance(p.weakKing, queen) > 1 ||
+              chebyshevDistance(p.strongKing, queen) == 1))
+            return Result::Win;
+      }
+   }
+   else
+   {
+      // Takes the undefended pawn.
+      if (chebyshevDistance(p.weakKing, p.pawn) == 1 &&
+          chebyshevDistance(p.strongKing, p.pawn) > 1)
+         return Result::Draw;
+
+      // Stalemate. There is no mate with the pawn on the board.
+      const Bitboard attacked = kingAttacks(p.strongKing) | pawnAttacked;
+      if ((kingAttacks(p.weakKing) & ~attacked) == EmptyBB)
+         return Result::Draw;
+   }
+
+   return Result::Unknown;
+}
+
+
+// Calls a function for the positions after each move. Pawn moves to the last rank
+// are not included because classify() decides positions with promotions.
+template <typename Fn> void forEachSuccessor(const KpkPosition& p, Fn fn)
+{
+   if (p.isStrongToMove)
+   {
+      const Bitboard kingTargets =
+         kingAttacks(p.strongKing) & ~kingAttacks(p.weakKing) & ~bit(p.pawn);
+      forEachSquare(kingTargets, [&](Square to) {
+         fn(KpkPosition{to, p.pawn, p.weakKing, false});
+      });
+
+      if (p.pawn.rank() != '7')
+      {
+         const Square push = forward(p.pawn, 1);
+         if (push != p.strongKing && push != p.weakKing)
+         {
+            fn(KpkPosition{p.strongKing, push, p.weakKing, false});
+
+            const Square doublePush = forward(p.pawn, 2);
+            if (p.pawn.rank() == '2' && doublePush != p.strongKing &&
+                doublePush != p.weakKing)
+               fn(KpkPosition{p.strongKing, doublePush, p.weakKing, false});
+         }
+      }
+   }
+   else
+   {
+      // Capturing the pawn is decided by classify().
+      const Bitboard attacked =
+         kingAttacks(p.strongKing) | pawnAttacks(Color::White, p.pawn) | bit(p.pawn);
+      forEachSquare(kingAttacks(p.weakKing) & ~attacked, [&](Square to) {
+         fn(KpkPosition{p.strongKing, p.pawn, to, true});
+      });
+   }
+}
+
+
+// Decides a position from the results of the positions after its moves. Only counts
+// wins that are decided in fewer plies than a given distance, so that each win is
+// found at the distance of the best play of both sides.
+Result resolve(const KpkPosition& p, const std::vector<Result>& results,
+               const std::vector<Distance>& distances, Distance distance)
+{
+   // The strong side wins if any move wins and draws if all moves draw. The weak side
+   // draws if any move draws and loses if all moves lose.
+   const Result good = p.isStrongToMove ? Result::Win : Result::Draw;
+   const Result bad = p.isStrongToMove ? Result::Draw : Result::Win;
+   bool isAnyGood = false;
+   bool isAllBad = true;
+   forEachSuccessor(p, [&](const KpkPosition& next) {
+      const std::size_t idx = index(next);
+      const Result result =
+         results[idx] == Result::Win && distances[idx] >= distance ? Result::Unknown
+                                                                    : results[idx];
+      isAnyGood = isAnyGood || result == good;
+      isAllBad = isAllBad && result == bad;
+   });
+
+   if (isAnyGood)
+      return good;
+   return isAllBad ? bad : Result::Unknown;
+}
+
+
+// Retrograde analysis. Decides positions from the results of their successors until
+// no more positions change. Each pass finds the wins that take one ply more than the
+// wins of the previous pass. The remaining positions are draws because the strong
+// side cannot force a win.
+// Returns the plies until promotion of each position that the strong side wins and
+// zero for draws.
+std::vector<Distance> generateBitbase()
+{
+   std::vector<Result> results(NumEntries);
+   std::vector<Distance> distances(NumEntries, NoDistance);
+   for (std::size_t idx = 0; idx < NumEntries; ++idx)
+   {
+      results[idx] = classify(position(idx));
+      // Wins by the promotion itself.
+      if (results[idx] == Result::Win)
+         distances[idx] = 1;
+   }
+
+   bool isChanged = true;
+   for (Distance distance = 2; isChanged; ++distance)
+   {
+      isChanged = false;
+      for (std::size_t idx = 0; idx < NumEntries; ++idx)
+      {
+         if (results[idx] != Result::Unknown)
+            continue;
+         results[idx] = resolve(position(idx), results, distances, distance);
+         if (results[idx] == Result::Win)
+            distances[idx] = distance;
+         isChanged = isChanged || results[idx] != Result::Unknown;
+      }
+   }
+
+   for (std::size_t idx = 0; idx < NumEntries; ++idx)
+   {
+      if (results[idx] != Result::Win)
+         distances[idx] = 0;
+   }
+   return distances;
+}
+
+
+const std::vector<Distance>& bitbase()
+{
+   static const std::vector<Distance> distances = generateBitbase();
+   return distances;
+}
+
+
+// Maps a square to the form that positions are stored in.
+Square normalize(Square sq, Color strongSide, bool isMirrored)
+{
+   std::size_t idx = sq.index();
+   if (strongSide == Color::Black)
+      idx ^= 56;
+   if (isMirrored)
+      idx ^= 7;
+   return Square::fromIndex(idx);
+}
+
+
+// Maps a position to the form that positions are stored in. Returns nothing for other
+// material and for positions that cannot occur. The pawn may be on the last rank.
+std::optional<KpkPosition> kpkPosition(const Position& pos, Color side)
+{
+   if (popcount(pos.occupied()) != 3)
+      return std::nullopt;
+
+   Color strongSide = Color::White;
+   if (pos.squares(Color::Black, Figure::Pawn).size() == 1)
+      strongSide = Color::Black;
+   else if (pos.squares(Color::White, Figure::Pawn).size() != 1)
+      return std::nullopt;
+   const Color weakSide = !strongSide;
+   if (pos.squares(strongSide, Figure::King).size() != 1 ||
+       pos.squares(weakSide, Figure::King).size() != 1)
+      return std::nullopt;
+
+   const Square pawn = normalize(pos.squares(strongSide, Figure::Pawn)[0], strongSide,
+                                 false);
+   if (pawn.rank() == '1')
+      return std::nullopt;
+
+   const bool isMirrored = pawn.fileIndex() >= static_cast<int>(NumPawnFiles);
+   KpkPosition p;
+   p.strongKing = normalize(pos.squares(strongSide, Figure::King)[0], strongSide,
+                            isMirrored);
+   p.pawn = normalize(pawn, Color::White, isMirrored);
+   p.weakKing = normalize(pos.squares(weakSide, Figure::King)[0], strongSide,
+                          isMirrored);
+   p.isStrongToMove = side == strongSide;
+
+   if (p.pawn.rank() == '8')
+   {
+      if (p.strongKing == p.pawn || p.weakKing == p.pawn ||
+          chebyshevDistance(p.strongKing, p.weakKing) <= 1)
+         return std::nullopt;
+      return p;
+   }
+   if (classify(p) == Result::Invalid)
+      return std::nullopt;
+   return p;
+}
+
+
+// The engine's move generation does not promote pawns, so a pawn on the last rank
+// stands for a queen. It wins unless the weak king takes it at once, like classify()
+// decides promotions.
+bool isPromotedWin(const KpkPosition& p)
+{
+   return p.isStrongToMove || chebyshevDistance(p.weakKing, p.pawn) > 1 ||
+          chebyshevDistance(p.strongKing, p.pawn) == 1;
+}
+
+} // namespace
+
+
+///////////////////
+
+std::optional<Wdl> probeKpk(const Position& pos, Color side)
+{
+   const std::optional<KpkPosition> p = kpkPosition(pos, side);
+   if (!p.has_value())
+      return std::nullopt;
+
+   const bool isWin =
+      p->pawn.rank() == '8' ? isPromotedWin(*p) : bitbase()[index(*p)] > 0;
+   if (!isWin)
+      return Wdl::Draw;
+   return p->isStrongToMove ? Wdl::Win : Wdl::Loss;
+}
+
+
+std::optional<int> probeKpkDistance(const Position& pos, Color side)
+{
+   const std::optional<KpkPosition> p = kpkPosition(pos, side);
+   if (!p.has_value())
+      return std::nullopt;
+   if (p->pawn.rank() == '8')
+      return 0;
+   return bitbase()[index(*p)];
+}
+
+
+EndgameTable kpkTable()
+{
+   // Generate the bitbase now rather than in the first search that reaches the
+   // endgame, where neither the stop flag nor the deadline can interrupt it.
+   bitbase();
+
+   EndgameTable table;
+   table.maxPieces = 3;
+   table.probeWdl = probeKpk;
+   table.probeDtz = probeKpkDistance;
+   return table;
+}
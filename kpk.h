@@ -0,0 +1,32 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#pragma once
+#include "piece.h"
+#include "tablebase.h"
+#include <optional>
+
+class Position;
+
+
+///////////////////
+
+// King and pawn versus king bitbase. Holds the number of plies until promotion per
+// position that the side with the pawn wins, so that the search makes progress.
+// Generated by retrograde analysis once per process when the first table gets
+// created.
+// The engine's move generation does not promote pawns. A pawn on the last rank
+// stands for a queen and wins unless the weak king takes it at once.
+
+// Result of a king and pawn versus king position from the point of view of a given
+// side to move. Returns nothing for other material and for positions that cannot
+// occur in a game, e.g. if the side that does not move is in check.
+std::optional<Wdl> probeKpk(const Position& pos, Color side);
+// Plies until the pawn of a won position reaches the last rank with best play of
+// both sides. Zero for draws and for pawns on the last rank. Returns nothing for
+// the same positions as probeKpk.
+std::optional<int> probeKpkDistance(const Position& pos, Color side);
+
+// Table for the search to probe. Generates the bitbase if needed.
+EndgameTable kpkTable();
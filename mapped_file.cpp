@@ -0,0 +1,192 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "mapped_file.h"
+#include <utility>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+///////////////////
+
+MappedFile::~MappedFile()
+{
+   close();
+}
+
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+{
+   swap(other);
+}
+
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+   if (this != &other)
+   {
+      close();
+      swap(other);
+   }
+   return *this;
+}
+
+
+void MappedFile::swap(MappedFile& other) noexcept
+{
+   std::swap(m_data, other.m_data);
+   std::swap(m_size, other.m_size);
+   std::swap(m_isWritable, other.m_isWritable);
+#ifdef _WIN32
+   std::swap(m_file, other.m_file);
+   std::swap(m_mapping, other.m_mapping);
+#else
+   std::swap(m_fd, other.m_fd);
+#endif
+}
+
+
+#ifdef _WIN32
+
+std::optional<MappedFile> MappedFile::open(const std::filesystem::path& path)
+{
+   MappedFile mf;
+   mf.m_file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                           OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+   if (mf.m_file == INVALID_HANDLE_VALUE)
+   {
+      mf.m_file = nullptr;
+      return std::nullopt;
+   }
+
+   LARGE_INTEGER size;
+   if (!GetFileSizeEx(mf.m_file, &size))
+      return std::nullopt;
+   mf.m_size = static_cast<std::size_t>(size.QuadPart);
+   // Empty files can not be mapped.
+   if (mf.m_size == 0)
+      return mf;
+
+   mf.m_mapping = CreateFileMappingW(mf.m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+   if (!mf.m_mapping)
+      return std::nullopt;
+   mf.m_data =
+      static_cast<std::byte*>(MapViewOfFile(mf.m_mapping, FILE_MAP_READ, 0, 0, 0));
+   if (!mf.m_data)
+      return std::nullopt;
+   return mf;
+}
+
+
+std::optional<MappedFile> MappedFile::create(const std::filesystem::path& path,
+                                             std::size_t size)
+{
+   MappedFile mf;
+   mf.m_isWritable = true;
+   mf.m_file = CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr,
+                           CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+   if (mf.m_file == INVALID_HANDLE_VALUE)
+   {
+      mf.m_file = nullptr;
+      return std::nullopt;
+   }
+   mf.m_size = size;
+   if (size == 0)
+      return mf;
+
+   const auto size64 = static_cast<unsigned long long>(size);
+   mf.m_mapping = CreateFileMappingW(mf.m_file, nullptr, PAGE_READWRITE,
+                                     static_cast<DWORD>(size64 >> 32),
+                                     static_cast<DWORD>(size64 & 0xFFFFFFFF), nullptr);
+   if (!mf.m_mapping)
+      return std::nullopt;
+   mf.m_data =
+      static_cast<std::byte*>(MapViewOfFile(mf.m_mapping, FILE_MAP_WRITE, 0, 0, 0));
+   if (!mf.m_data)
+      return std::nullopt;
+   return mf;
+}
+
+
+void MappedFile::close()
+{
+   if (m_data)
+      UnmapViewOfFile(m_data);
+   if (m_mapping)
+      CloseHandle(m_mapping);
+   if (m_file)
+      CloseHandle(m_file);
+   m_data = nullptr;
+   m_mapping = nullptr;
+   m_file = nullptr;
+   m_size = 0;
+}
+
+#else
+
+std::optional<MappedFile> MappedFile::open(const std::filesystem::path& path)
+{
+   MappedFile mf;
+   mf.m_fd = ::open(path.c_str(), O_RDONLY);
+   if (mf.m_fd < 0)
+      return std::nullopt;
+
+   struct stat st;
+   if (fstat(mf.m_fd, &st) != 0)
+      return std::nullopt;
+   mf.m_size = static_cast<std::size_t>(st.st_size);
+   // Empty files can not be mapped.
+   if (mf.m_size == 0)
+      return mf;
+
+   void* data = mmap(nullptr, mf.m_size, PROT_READ, MAP_SHARED, mf.m_fd, 0);
+   if (data == MAP_FAILED)
+      return std::nullopt;
+   mf.m_data = static_cast<std::byte*>(data);
+   return mf;
+}
+
+
+std::optional<MappedFile> MappedFile::create(const std::filesystem::path& path,
+                                             std::size_t size)
+{
+   MappedFile mf;
+   mf.m_isWritable = true;
+   mf.m_fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+   if (mf.m_fd < 0)
+      return std::nullopt;
+   if (ftruncate(mf.m_fd, static_cast<off_t>(size)) != 0)
+      return std::nullopt;
+   mf.m_size = size;
+   if (size == 0)
+      return mf;
+
+   void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, mf.m_fd, 0);
+   if (data == MAP_FAILED)
+      return std::nullopt;
+   mf.m_data = static_cast<std::byte*>(data);
+   return mf;
+}
+
+
+void MappedFile::close()
+{
+   if (m_data)
+      munmap(m_data, m_size);
+   if (m_fd >= 0)
+      ::close(m_fd);
+   m_data = nullptr;
+   m_fd = -1;
+   m_size = 0;
+}
+
+#endif
@@ -0,0 +1,51 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#pragma once
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+
+
+///////////////////
+
+// File that is mapped into memory. The operating system pages the file in on
+// demand, so large files can be accessed without reading them as a whole.
+class MappedFile
+{
+ public:
+   // Maps an existing file for reading.
+   static std::optional<MappedFile> open(const std::filesystem::path& path);
+   // Creates or truncates a file of a given size and maps it for writing.
+   static std::optional<MappedFile> create(const std::filesystem::path& path,
+                                           std::size_t size);
+
+   MappedFile() = default;
+   ~MappedFile();
+   MappedFile(const MappedFile&) = delete;
+   MappedFile& operator=(const MappedFile&) = delete;
+   MappedFile(MappedFile&& other) noexcept;
+   MappedFile& operator=(MappedFile&& other) noexcept;
+
+   const std::byte* data() const { return m_data; }
+   // Null for files that are mapped for reading.
+   std::byte* writableData() { return m_isWritable ? m_data : nullptr; }
+   std::size_t size() const { return m_size; }
+   bool empty() const { return m_size == 0; }
+
+ private:
+   void close();
+   void swap(MappedFile& other) noexcept;
+
+ private:
+   std::byte* m_data = nullptr;
+   std::size_t m_size = 0;
+   bool m_isWritable = false;
+#ifdef _WIN32
+   void* m_file = nullptr;
+   void* m_mapping = nullptr;
+#else
+   int m_fd = -1;
+#endif
+};
@@ -3,180 +3,810 @@
 // MIT license
 //
 #include "matt.h"
+#include "arena.h"
+#include "eval_cache.h"
+#include "move_picker.h"
+#include "nnue.h"
 #include "position.h"
+#include "repetition.h"
+#include "tt.h"
 #include <algorithm>
+#include <cmath>
 #include <execution>
+#include <functional>
 #include <iterator>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 
 namespace
 {
 ///////////////////
 
-template <typename T> class VectorSlice
+using Clock = std::chrono::steady_clock;
+
+constexpr float Infinity = std::numeric_limits<float>::infinity();
+constexpr float DrawScore = 0.f;
+// Prefers quicker wins and slower losses in solved endgames.
+constexpr float TablebasePlyScore = 0.01f;
+// Size of the table that each call of makeMove or bestLines searches with.
+constexpr std::size_t MakeMoveTableSizeMB = 4;
+// Nodes that a thread visits between checks whether its search should stop.
+constexpr std::uint64_t StopPollNodes = 1024;
+
+// The game positions and the positions of the deepest line have to fit.
+static_assert(RepetitionHistory::Capacity >=
+              RepetitionHistory::FiftyMovePlies + 1 + MaxSearchPlies);
+
+
+// Decides when a search stops. Shared by all threads of the search, which report
+// their nodes every few nodes.
+class StopCondition
 {
  public:
-   using const_iterator = typename std::vector<T>::const_iterator;
-
-   VectorSlice(const std::vector<T>& source, std::size_t start, std::size_t size);
-   VectorSlice(const std::vector<T>& source);
+   StopCondition(const SearchLimits& limits, const std::atomic<bool>& stop,
+                 Clock::time_point start);
 
-   std::size_t size() const { return m_size; }
-   const const_iterator cbegin() const { return m_source->begin() + m_start; }
-   const const_iterator cend() const { return m_source->begin() + m_start + m_size; }
-   const const_iterator begin() const { return cbegin(); }
-   const const_iterator end() const { return cend(); }
-   const T& operator[](std::size_t idx) const { return (*m_source)[idx]; }
+   // Adds the nodes that a thread visited since its last poll. Returns whether the
+   // search should stop.
+   bool poll(std::uint64_t nodes);
+   bool isStopped() const;
 
  private:
-   const std::vector<T>* m_source = nullptr;
-   std::size_t m_start = 0;
-   std::size_t m_size = 0;
+   const std::atomic<bool>& m_stop;
+   std::optional<std::uint64_t> m_maxNodes;
+   std::optional<Clock::time_point> m_deadline;
+   std::atomic<std::uint64_t> m_nodes{0};
+   // Set once a limit is reached.
+   std::atomic<bool> m_isLimitReached{false};
 };
 
 
-template <typename T>
-inline VectorSlice<T>::VectorSlice(const std::vector<T>& source, std::size_t start,
-                                   std::size_t size)
-: m_source{&source}, m_start{start}, m_size{size}
+StopCondition::StopCondition(const SearchLimits& limits, const std::atomic<bool>& stop,
+                             Clock::time_point start)
+: m_stop{stop}, m_maxNodes{limits.nodes}
 {
+   if (limits.time.has_value())
+      m_deadline = start + *limits.time;
 }
 
 
-template <typename T>
-inline VectorSlice<T>::VectorSlice(const std::vector<T>& source)
-: m_source{&source}, m_start{0}, m_size{source.size()}
+bool StopCondition::poll(std::uint64_t nodes)
 {
+   const std::uint64_t total =
+      m_nodes.fetch_add(nodes, std::memory_order_relaxed) + nodes;
+   if ((m_maxNodes.has_value() && total >= *m_maxNodes) ||
+       (m_deadline.has_value() && Clock::now() >= *m_deadline))
+      m_isLimitReached.store(true, std::memory_order_relaxed);
+   return isStopped();
 }
 
 
-template <typename T>
-typename VectorSlice<T>::const_iterator begin(const VectorSlice<T>& slice)
+bool StopCondition::isStopped() const
 {
-   return slice.begin();
+   return m_isLimitReached.load(std::memory_order_relaxed) ||
+          m_stop.load(std::memory_order_relaxed);
 }
 
 
-template <typename T>
-typename VectorSlice<T>::const_iterator end(const VectorSlice<T>& slice)
+// Scores the positions at the leaves of a search.
+struct Evaluator
+{
+   // Scores by material if empty.
+   const Evaluation& evaluation;
+   // Looked up before evaluating with an evaluation or a network if given.
+   EvalCache* cache = nullptr;
+   // Takes precedence over the evaluation if given.
+   const Network* network = nullptr;
+
+   // Score from the point of view of White.
+   float score(const Position& pos) const
+   {
+      if (network)
+         return network->evaluate(pos);
+      return evaluation ? evaluation(pos) : pos.score();
+   }
+   // Positions know their material, so only other scores are worth caching.
+   bool isCached() const { return cache && (network || evaluation); }
+};
+
+
+// State of a search that is local to one searching thread.
+class SearchState
+{
+ public:
+   // Takes the keys of the game positions that the search starts from. The search
+   // counts its nodes for the stop condition but only stops if it can.
+   SearchState(std::size_t maxPlies, const std::vector<HashKey>& gameKeys,
+               TranspositionTable& tt, const Tablebases& tablebases,
+               const Evaluator& evaluator, StopCondition& stop, bool canStop);
+
+   // Scratch memory for move lists. Belongs to the searching thread.
+   Arena& arena() { return m_arena; }
+   const MovePicker::Killers& killers(std::size_t ply) const { return m_killers[ply]; }
+   void addKiller(std::size_t ply, const Move& move);
+   RepetitionHistory& history() { return m_history; }
+   TranspositionTable& tt() { return m_tt; }
+   const Tablebases& tablebases() const { return m_tablebases; }
+   // Counters of this thread.
+   SearchStats& stats() { return m_stats; }
+   // Keep the accumulators of the network up to date with the position that the
+   // search starts from at ply 0 and the positions that moves lead to.
+   void enterRoot(const Position& pos);
+   void enterChild(std::size_t ply, const Position& parent, const Position& child,
+                   const Move& move);
+   // Returns the static score of the position at a given ply from the point of view
+   // of a given side.
+   float evaluate(const Position& pos, Color side, std::size_t ply);
+
+   // Counts a visited node and checks every few nodes whether the search should
+   // stop.
+   bool enterNode();
+   // Whether the search was stopped at the last visited node.
+   bool isStopped() const { return m_isStopped; }
+   // Reports the nodes since the last poll when the thread is done.
+   void flushNodes();
+
+ private:
+   // Quiet moves that caused a cutoff, per ply.
+   std::vector<MovePicker::Killers> m_killers;
+   Arena& m_arena;
+   RepetitionHistory m_history;
+   TranspositionTable& m_tt;
+   const Tablebases& m_tablebases;
+   const Evaluator& m_evaluator;
+   // Accumulators of the network per ply. Empty without a network.
+   std::vector<Accumulator> m_accumulators;
+   StopCondition& m_stop;
+   bool m_canStop = false;
+   bool m_isStopped = false;
+   std::uint64_t m_unpolledNodes = 0;
+   SearchStats m_stats;
+};
+
+
+SearchState::SearchState(std::size_t maxPlies, const std::vector<HashKey>& gameKeys,
+                         TranspositionTable& tt, const Tablebases& tablebases,
+                         const Evaluator& evaluator, StopCondition& stop, bool canStop)
+: m_killers(maxPlies + 1), m_arena{threadArena()}, m_history{gameKeys}, m_tt{tt},
+  m_tablebases{tablebases}, m_evaluator{evaluator},
+  m_accumulators(evaluator.network ? maxPlies + 1 : 0), m_stop{stop}, m_canStop{canStop},
+  m_isStopped{canStop && stop.isStopped()}
 {
-   return slice.end();
 }
 
 
-template <typename T>
-typename VectorSlice<T>::const_iterator cbegin(const VectorSlice<T>& slice)
+void SearchState::addKiller(std::size_t ply, const Move& move)
 {
-   return slice.cbegin();
+   MovePicker::Killers& killers = m_killers[ply];
+   if (killers[0].has_value() && isSameMove(*killers[0], move))
+      return;
+   killers[1] = std::move(killers[0]);
+   killers[0] = move;
 }
 
 
-template <typename T>
-typename VectorSlice<T>::const_iterator cend(const VectorSlice<T>& slice)
+void SearchState::enterRoot(const Position& pos)
 {
-   return slice.cend();
+   if (m_evaluator.network)
+      m_evaluator.network->refresh(m_accumulators[0], pos);
 }
 
 
-///////////////////
+void SearchState::enterChild(std::size_t ply, const Position& parent,
+                             const Position& child, const Move& move)
+{
+   if (m_evaluator.network)
+      m_evaluator.network->update(m_accumulators[ply - 1], m_accumulators[ply], parent,
+                                  child, move);
+}
 
-std::optional<Position> bestPosition(const VectorSlice<Position>& positions, Color side)
+
+float SearchState::evaluate(const Position& pos, Color side, std::size_t ply)
 {
-   // Use best scoring position depending on the piece's color.
-   const auto endPos = end(positions);
-   auto bestPos = endPos;
-   if (side == Color::White)
-      bestPos = std::max_element(begin(positions), endPos);
+   const auto scorePosition = [&]() {
+      if (m_evaluator.network)
+         return m_evaluator.network->evaluate(m_accumulators[ply]);
+      return m_evaluator.score(pos);
+   };
+
+   EvalCache* cache = m_evaluator.cache;
+   float score = 0.f;
+   if (!m_evaluator.isCached())
+   {
+      score = scorePosition();
+   }
    else
-      bestPos = std::min_element(begin(positions), endPos);
-
-   if (bestPos == endPos)
-      return std::nullopt;
-   return *bestPos;
+   {
+      ++m_stats.evalProbes;
+      if (const std::optional<float> cached = cache->probe(pos.hash());
+          cached.has_value())
+      {
+         ++m_stats.evalHits;
+         score = *cached;
+      }
+      else
+      {
+         score = scorePosition();
+         cache->store(pos.hash(), score);
+      }
+   }
+   return side == Color::White ? score : -score;
 }
 
 
-std::vector<Position> allMoves(const Position& pos, Color side)
+bool SearchState::enterNode()
 {
-   std::vector<Position> allMoves;
-   const auto pieces = pos.pieces(side);
-   for (const auto& piece : pieces)
+   ++m_stats.nodes;
+   if (++m_unpolledNodes == StopPollNodes)
    {
-      const auto pieceMoves = piece.nextPositions(pos);
-      allMoves.insert(std::end(allMoves), std::begin(pieceMoves), std::end(pieceMoves));
+      const bool shouldStop = m_stop.poll(m_unpolledNodes);
+      m_unpolledNodes = 0;
+      m_isStopped = m_canStop && shouldStop;
    }
+   return !m_isStopped;
+}
+
+
+void SearchState::flushNodes()
+{
+   m_stop.poll(m_unpolledNodes);
+   m_unpolledNodes = 0;
+}
+
+
+///////////////////
+
+// Score of a solved position from the point of view of the side to move.
+float tablebaseScore(const Position& pos, Color side, Wdl wdl,
+                     const Tablebases& tablebases)
+{
+   if (wdl == Wdl::Draw)
+      return DrawScore;
+
+   const auto distance = static_cast<float>(tablebases.probeDtz(pos, side).value_or(0));
+   const float score = TablebaseWinScore - distance * TablebasePlyScore;
+   return wdl == Wdl::Win ? score : -score;
+}
+
 
-   return allMoves;
+// Checks for draws by the fifty-move rule or by repetition. Expects the key of the
+// position to be the newest key of the history.
+bool isDraw(const Position& pos, std::size_t ply, SearchState& state)
+{
+   const std::size_t reversible = pos.reversiblePlies();
+   return reversible >= RepetitionHistory::FiftyMovePlies ||
+          state.history().isRepetition(reversible, ply);
+}
+
+
+// Makes the best move of a table entry for a position. The entry might belong to
+// a different position with the same slot, so the move gets validated.
+std::optional<Move> tableMove(const TranspositionTable::Entry& entry,
+                              const Position& pos, Color side)
+{
+   if (!entry.from || !entry.to)
+      return std::nullopt;
+   const std::optional<Piece> piece = pos[entry.from];
+   if (!piece.has_value() || piece->color() != side || !piece->canMoveTo(entry.to, pos))
+      return std::nullopt;
+   return Move{*piece, entry.to, pos};
+}
+
+
+// Checks if a table entry's score decides the score of a position for a given
+// window.
+bool isTableCutoff(const TranspositionTable::Entry& entry, std::size_t plies,
+                   float alpha, float beta)
+{
+   if (entry.depth < plies)
+      return false;
+   return entry.bound == Bound::Exact ||
+          (entry.bound == Bound::Lower && entry.score >= beta) ||
+          (entry.bound == Bound::Upper && entry.score <= alpha);
 }
 
 
-std::optional<Position> processMovesUnthreaded(const VectorSlice<Position>& moves,
-                                               Color side, std::size_t plies)
+// Alpha-beta search of the moves of a given side.
+// Returns the score of the position from the point of view of the side. The score
+// is meaningless if the search was stopped.
+float alphaBeta(const Position& pos, Color side, std::size_t plies, std::size_t ply,
+                float alpha, float beta, SearchState& state)
 {
-   if (plies > 1)
+   if (!state.enterNode())
+      return DrawScore;
+
+   RepetitionScope repetition{state.history(), pos.hash()};
+   if (isDraw(pos, ply, state))
+      return DrawScore;
+
+   SearchStats& stats = state.stats();
+   // Solved endgames need no search, also not at the horizon.
+   if (const auto wdl = state.tablebases().probeWdl(pos, side); wdl.has_value())
+   {
+      ++stats.tablebaseHits;
+      return tablebaseScore(pos, side, *wdl, state.tablebases());
+   }
+
+   if (plies == 0)
    {
-      // Look further ahead by, for each move, calculating all following moves of the
-      // opposite color.
-      std::vector<Position> bestNextMoves;
-      bestNextMoves.reserve(moves.size());
+      ++stats.leafNodes;
+      return state.evaluate(pos, side, ply);
+   }
 
-      for (const auto& move : moves)
+   const HashKey key = searchKey(pos.hash(), side);
+   const auto entry = state.tt().probe(key);
+   ++stats.hashProbes;
+   if (entry.has_value())
+   {
+      ++stats.hashHits;
+      if (isTableCutoff(*entry, plies, alpha, beta))
       {
-         if (const auto nextMove =
-                processMovesUnthreaded(allMoves(move, side), !side, plies - 1);
-             nextMove.has_value())
-         {
-            bestNextMoves.push_back(*nextMove);
-         }
+         ++stats.hashCutoffs;
+         return entry->score;
       }
-
-      return bestPosition(bestNextMoves, side);
    }
-   else
+
+   // Release the moves of this node when done with it.
+   ArenaScope scope{state.arena()};
+   std::optional<Move> hashMove;
+   if (entry.has_value())
+      hashMove = tableMove(*entry, pos, side);
+   MovePicker picker{pos, side, std::move(hashMove), state.killers(ply), &state.arena()};
+   std::optional<Move> move = picker.next();
+   // Score positions without moves by their material.
+   if (!move.has_value())
+      return state.evaluate(pos, side, ply);
+
+   const float origAlpha = alpha;
+   float best = -Infinity;
+   TranspositionTable::Entry update;
+   std::size_t numSearched = 0;
+   for (; move.has_value(); move = picker.next())
    {
-      // Final step. Simply find best of the given moves.
-      return bestPosition(moves, side);
+      ++numSearched;
+      const Position next = pos.makeUnrecordedMove(*move);
+      state.enterChild(ply + 1, pos, next, *move);
+      const float value =
+         -alphaBeta(next, !side, plies - 1, ply + 1, -beta, -alpha, state);
+      if (state.isStopped())
+         return best;
+
+      if (value > best)
+      {
+         best = value;
+         update.from = move->from();
+         update.to = move->to();
+      }
+      alpha = std::max(alpha, value);
+      if (alpha >= beta)
+      {
+         ++stats.betaCutoffs;
+         if (numSearched == 1)
+            ++stats.firstMoveCutoffs;
+         if (!isCapture(*move, pos))
+            state.addKiller(ply, *move);
+         break;
+      }
    }
+
+   update.score = best;
+   update.depth = static_cast<std::uint8_t>(plies);
+   update.bound = best <= origAlpha ? Bound::Upper
+                  : best >= beta    ? Bound::Lower
+                                    : Bound::Exact;
+   state.tt().store(key, update);
+   return best;
 }
 
 
-std::optional<Position> processMoves(const VectorSlice<Position>& moves, Color side,
-                                     std::size_t plies)
+std::vector<Move> allMoves(const Position& pos, Color side)
 {
-   if (plies > 1)
-   {
-      // Look further ahead by, for each move, calculating all following moves of the
-      // opposite color.
-      std::mutex bestMovesMx;
-      std::vector<Position> bestNextMoves;
-      bestNextMoves.reserve(moves.size());
-
-      std::for_each(std::execution::par, begin(moves), end(moves), [&](const auto& move) {
-         if (const auto nextMove = processMoves(allMoves(move, side), !side, plies - 1);
-             nextMove.has_value())
-         {
-            std::lock_guard<std::mutex> lock(bestMovesMx);
-            bestNextMoves.push_back(*nextMove);
-         }
-      });
-
-      return bestPosition(bestNextMoves, side);
-   }
+   std::vector<Move> moves;
+   MovePicker picker{pos, side};
+   for (auto move = picker.next(); move.has_value(); move = picker.next())
+      moves.push_back(std::move(*move));
+   return moves;
+}
+
+
+///////////////////
+
+struct RootMove
+{
+   Move move;
+   float score = -Infinity;
+   // Whether the score is exact. Otherwise it is an upper bound of a move that is not
+   // one of the best lines.
+   bool isExact = false;
+};
+
+
+// Score that a root move has to beat to be one of the best lines of an iteration.
+// Shared by the threads that search the root moves.
+class RootBound
+{
+ public:
+   explicit RootBound(std::size_t numLines) : m_numLines{numLines} {}
+
+   // Minus infinity until as many moves as there are lines have exact scores.
+   float alpha() const { return m_alpha.load(std::memory_order_relaxed); }
+   // Adds the exact score of a move.
+   void add(float score);
+
+ private:
+   std::size_t m_numLines = 1;
+   std::mutex m_mutex;
+   // Best exact scores so far, best first.
+   std::vector<float> m_best;
+   std::atomic<float> m_alpha{-Infinity};
+};
+
+
+void RootBound::add(float score)
+{
+   std::lock_guard lock{m_mutex};
+   m_best.insert(std::upper_bound(std::begin(m_best), std::end(m_best), score,
+                                  std::greater<float>{}),
+                 score);
+   if (m_best.size() > m_numLines)
+      m_best.pop_back();
+   if (m_best.size() == m_numLines)
+      m_alpha.store(m_best.back(), std::memory_order_relaxed);
+}
+
+
+// Search of the moves of the position that a search starts from.
+class RootSearch
+{
+ public:
+   RootSearch(const Position& pos, Color side, TranspositionTable& tt,
+              const Tablebases& tablebases, const Evaluator& evaluator,
+              StopCondition& stop);
+
+   bool hasMoves() const { return !m_moves.empty(); }
+   // Best move first after each completed iteration.
+   const std::vector<RootMove>& moves() const { return m_moves; }
+   std::uint64_t nodes() const { return m_nodes.load(std::memory_order_relaxed); }
+   // Counters of all threads so far.
+   SearchStats stats() const;
+
+   // Searches the root moves to a given depth, optionally on several threads. Finds
+   // exact scores for a given number of best moves and upper bounds for the others.
+   // Returns false if the search was stopped before completing the iteration. Only
+   // iterations that can be stopped check the stop condition.
+   bool iterate(std::size_t plies, std::size_t numLines, bool canStop, bool isParallel);
+   // Follows the best moves stored in the table after one of the root moves.
+   std::vector<Move> principalVariation(const RootMove& root, std::size_t plies) const;
+
+ private:
+   // Adds the counters of the calling thread.
+   void addStats(const SearchStats& stats);
+
+ private:
+   const Position& m_pos;
+   Color m_side = Color::White;
+   TranspositionTable& m_tt;
+   const Tablebases& m_tablebases;
+   const Evaluator& m_evaluator;
+   StopCondition& m_stop;
+   const std::vector<HashKey> m_gameKeys;
+   std::vector<RootMove> m_moves;
+   std::atomic<std::uint64_t> m_nodes{0};
+   // Collects the counters of the threads when they finish a root move.
+   mutable std::mutex m_statsMutex;
+   SearchStats m_stats;
+   std::map<std::thread::id, std::uint64_t> m_threadNodes;
+};
+
+
+RootSearch::RootSearch(const Position& pos, Color side, TranspositionTable& tt,
+                       const Tablebases& tablebases, const Evaluator& evaluator,
+                       StopCondition& stop)
+: m_pos{pos}, m_side{side}, m_tt{tt}, m_tablebases{tablebases}, m_evaluator{evaluator},
+  m_stop{stop}, m_gameKeys{pos.reversibleHistory()}
+{
+   for (Move& move : allMoves(pos, side))
+      m_moves.push_back(RootMove{std::move(move)});
+}
+
+
+bool RootSearch::iterate(std::size_t plies, std::size_t numLines, bool canStop,
+                         bool isParallel)
+{
+   // The moves that were best in the last iteration come first and get searched with
+   // a full window. The other moves only get searched for their exact scores if a
+   // null window search shows that they beat the worst of the best lines so far.
+   RootBound bound{numLines};
+   std::vector<RootMove> scores(m_moves.size());
+   const auto searchMove = [&](const RootMove& root) {
+      SearchState state{plies, m_gameKeys, m_tt, m_tablebases, m_evaluator,
+                        m_stop, canStop};
+      const std::size_t idx = &root - m_moves.data();
+      const Position next = m_pos.makeUnrecordedMove(root.move);
+      state.enterRoot(m_pos);
+      state.enterChild(1, m_pos, next, root.move);
+
+      const float alpha = bound.alpha();
+      float score = 0.f;
+      bool isExact = true;
+      if (alpha == -Infinity)
+      {
+         score = -alphaBeta(next, !m_side, plies - 1, 1, -Infinity, Infinity, state);
+      }
+      else
+      {
+         const float beta = std::nextafter(alpha, Infinity);
+         score = -alphaBeta(next, !m_side, plies - 1, 1, -beta, -alpha, state);
+         if (score > alpha && !state.isStopped())
+            score = -alphaBeta(next, !m_side, plies - 1, 1, -Infinity, -alpha, state);
+         isExact = score > alpha;
+      }
+      if (isExact && !state.isStopped())
+         bound.add(score);
+      scores[idx].score = score;
+      scores[idx].isExact = isExact;
+
+      state.flushNodes();
+      addStats(state.stats());
+   };
+   if (isParallel)
+      std::for_each(std::execution::par, std::begin(m_moves), std::end(m_moves),
+                    searchMove);
    else
+      std::for_each(std::begin(m_moves), std::end(m_moves), searchMove);
+
+   if (canStop && m_stop.isStopped())
+      return false;
+
+   for (std::size_t i = 0; i < m_moves.size(); ++i)
    {
-      // Final step. Simply find best of the given moves.
-      return bestPosition(moves, side);
+      m_moves[i].score = scores[i].score;
+      m_moves[i].isExact = scores[i].isExact;
    }
+   // Keep the earlier order for equal scores, so that the best move of the last
+   // iteration stays best. Bounds never beat exact scores of the best lines.
+   std::stable_sort(std::begin(m_moves), std::end(m_moves),
+                    [](const RootMove& a, const RootMove& b) {
+                       if (a.score != b.score)
+                          return a.score > b.score;
+                       return a.isExact && !b.isExact;
+                    });
+
+   TranspositionTable::Entry entry;
+   entry.score = m_moves[0].score;
+   entry.depth = static_cast<std::uint8_t>(plies);
+   entry.bound = Bound::Exact;
+   entry.from = m_moves[0].move.from();
+   entry.to = m_moves[0].move.to();
+   m_tt.store(searchKey(m_pos.hash(), m_side), entry);
+   return true;
+}
+
+
+SearchStats RootSearch::stats() const
+{
+   std::lock_guard lock{m_statsMutex};
+   SearchStats stats = m_stats;
+   for (const auto& [thread, nodes] : m_threadNodes)
+      stats.threadNodes.push_back(nodes);
+   return stats;
 }
 
 
+void RootSearch::addStats(const SearchStats& stats)
+{
+   m_nodes.fetch_add(stats.nodes, std::memory_order_relaxed);
+
+   std::lock_guard lock{m_statsMutex};
+   m_stats += stats;
+   m_threadNodes[std::this_thread::get_id()] += stats.nodes;
+}
+
+
+std::vector<Move> RootSearch::principalVariation(const RootMove& root,
+                                                 std::size_t plies) const
+{
+   std::vector<Move> pv{root.move};
+   Position pos = m_pos.makeUnrecordedMove(pv.back());
+   Color side = !m_side;
+
+   while (pv.size() < plies)
+   {
+      const auto entry = m_tt.probe(searchKey(pos.hash(), side));
+      if (!entry.has_value())
+         break;
+      std::optional<Move> move = tableMove(*entry, pos, side);
+      if (!move.has_value())
+         break;
+
+      pos = pos.makeUnrecordedMove(*move);
+      pv.push_back(std::move(*move));
+      side = !side;
+   }
+   return pv;
+}
+
 } // namespace
 
 
 ///////////////////
 
+std::optional<Move> SearchResult::bestMove() const
+{
+   if (pv.empty())
+      return std::nullopt;
+   return pv.front();
+}
+
+
+std::optional<Move> SearchResult::ponderMove() const
+{
+   if (pv.size() < 2)
+      return std::nullopt;
+   return pv[1];
+}
+
+
+double SearchStats::branchingFactor() const
+{
+   const std::size_t n = iterationNodes.size();
+   if (n < 2 || iterationNodes[n - 2] == 0)
+      return 0.;
+   return static_cast<double>(iterationNodes[n - 1]) /
+          static_cast<double>(iterationNodes[n - 2]);
+}
+
+
+double SearchStats::firstMoveCutoffRate() const
+{
+   if (betaCutoffs == 0)
+      return 0.;
+   return static_cast<double>(firstMoveCutoffs) / static_cast<double>(betaCutoffs);
+}
+
+
+double SearchStats::evalHitRate() const
+{
+   if (evalProbes == 0)
+      return 0.;
+   return static_cast<double>(evalHits) / static_cast<double>(evalProbes);
+}
+
+
+SearchStats& SearchStats::operator+=(const SearchStats& other)
+{
+   nodes += other.nodes;
+   leafNodes += other.leafNodes;
+   hashProbes += other.hashProbes;
+   hashHits += other.hashHits;
+   hashCutoffs += other.hashCutoffs;
+   tablebaseHits += other.tablebaseHits;
+   evalProbes += other.evalProbes;
+   evalHits += other.evalHits;
+   betaCutoffs += other.betaCutoffs;
+   firstMoveCutoffs += other.firstMoveCutoffs;
+   return *this;
+}
+
+
+bool haveSameEvaluation(const SearchLimits& a, const SearchLimits& b)
+{
+   using EvalFn = float (*)(const Position&);
+
+   if (a.network != b.network)
+      return false;
+   if (!a.evaluation || !b.evaluation)
+      return !a.evaluation && !b.evaluation;
+   // Other callables may hold state, so they never compare equal.
+   const EvalFn* fnA = a.evaluation.target<EvalFn>();
+   const EvalFn* fnB = b.evaluation.target<EvalFn>();
+   return fnA && fnB && *fnA == *fnB;
+}
+
+
+SearchResult search(const Position& pos, Color side, const SearchLimits& limits,
+                    TranspositionTable& tt, const std::atomic<bool>& stop,
+                    const SearchCallback& onIteration, const Tablebases& tablebases,
+                    EvalCache* evalCache)
+{
+   const Clock::time_point start = Clock::now();
+   StopCondition stopCondition{limits, stop, start};
+
+   tt.newSearch();
+   const Evaluator evaluator{limits.evaluation, evalCache, limits.network.get()};
+   RootSearch root{pos, side, tt, tablebases, evaluator, stopCondition};
+   SearchResult result;
+   if (!root.hasMoves())
+      return result;
+
+   const std::size_t maxPlies =
+      std::clamp<std::size_t>(limits.plies, 1, MaxSearchPlies);
+   // Only the moves of the requested lines get exact scores.
+   const std::size_t numLines =
+      std::clamp<std::size_t>(limits.multiPv, 1, root.moves().size());
+   // Takes the counters of the threads and keeps the iterations.
+   const auto updateStats = [&root, &result]() {
+      SearchStats stats = root.stats();
+      stats.iterationNodes = std::move(result.stats.iterationNodes);
+      stats.iterationTimes = std::move(result.stats.iterationTimes);
+      result.stats = std::move(stats);
+   };
+
+   for (std::size_t plies = 1; plies <= maxPlies; ++plies)
+   {
+      if (!root.iterate(plies, numLines, plies > 1, limits.isParallel))
+         break;
+
+      result.depth = plies;
+      result.lines.clear();
+      for (std::size_t i = 0; i < numLines; ++i)
+      {
+         const RootMove& move = root.moves()[i];
+         result.lines.push_back(
+            SearchLine{move.score, root.principalVariation(move, plies)});
+      }
+      result.score = result.lines[0].score;
+      result.pv = result.lines[0].pv;
+      result.bestMoveMargin =
+         root.moves().size() > 1 ? result.score - root.moves()[1].score : Infinity;
+      const std::uint64_t prevNodes = result.nodes;
+      const std::chrono::milliseconds prevTime = result.time;
+      result.nodes = root.nodes();
+      result.time =
+         std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start);
+      result.hashfull = tt.hashfull();
+      updateStats();
+      result.stats.iterationNodes.push_back(result.nodes - prevNodes);
+      result.stats.iterationTimes.push_back(result.time - prevTime);
+      if (onIteration)
+         onIteration(result);
+
+      if (stopCondition.isStopped())
+         break;
+   }
+
+   // Include the nodes of an interrupted iteration.
+   result.nodes = root.nodes();
+   updateStats();
+   return result;
+}
+
+
 std::optional<Position> makeMove(const Position& pos, Color side, std::size_t turns)
+{
+   const std::vector<SearchLine> lines = bestLines(pos, side, turns, 1);
+   if (lines.empty())
+      return std::nullopt;
+   return pos.makeMove(lines[0].pv.front());
+}
+
+
+std::vector<SearchLine> bestLines(const Position& pos, Color side, std::size_t turns,
+                                  std::size_t numLines)
 {
    // Convert turns (one move of each player) to plies (one move of one player).
-   return processMoves(allMoves(pos, side), side, 2 * turns);
+   // Always look at least at the immediate moves.
+   SearchLimits limits;
+   limits.plies = std::max<std::size_t>(2 * turns, 1);
+   limits.multiPv = numLines;
+
+   TranspositionTable tt{MakeMoveTableSizeMB};
+   const std::atomic<bool> noStop{false};
+   return search(pos, side, limits, tt, noStop).lines;
+}
+
+
+std::optional<Position> makeMove(const Position& pos, Color side,
+                                 const SearchLimits& limits,
+                                 const std::atomic<bool>& cancel)
+{
+   TranspositionTable tt{MakeMoveTableSizeMB};
+   const std::optional<Move> move = search(pos, side, limits, tt, cancel).bestMove();
+   if (!move.has_value())
+      return std::nullopt;
+   return pos.makeMove(*move);
 }
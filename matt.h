@@ -3,10 +3,171 @@
 // MIT license
 //
 #pragma once
+#include "move.h"
 #include "piece.h"
+#include "tablebase.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <cstdlib>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
 
+class EvalCache;
+class Network;
 class Position;
+class TranspositionTable;
 
 
+// Returns the position after the best move of a given side looking ahead a given
+// number of turns.
 std::optional<Position> makeMove(const Position& pos, Color side, std::size_t turns);
+
+
+///////////////////
+
+// Deepest search in plies.
+inline constexpr std::size_t MaxSearchPlies = 64;
+
+// Score of a position that a table knows to be won. Larger than any advantage in
+// material without kings.
+inline constexpr float TablebaseWinScore = 50.f;
+
+// Static evaluation of a position from the point of view of White.
+using Evaluation = std::function<float(const Position&)>;
+
+
+struct SearchLimits
+{
+   // Maximal depth in plies.
+   std::size_t plies = MaxSearchPlies;
+   // Stops the search after about this many nodes.
+   std::optional<std::uint64_t> nodes;
+   // Stops the search after this time since its start.
+   std::optional<std::chrono::milliseconds> time;
+   // Number of best moves to report with their principal variations.
+   std::size_t multiPv = 1;
+   // Scores the positions at the depth limit. Scores by material if empty.
+   Evaluation evaluation;
+   // Scores the positions at the depth limit instead of the evaluation if given.
+   // Updates its accumulators incrementally along the searched lines.
+   std::shared_ptr<const Network> network;
+   // Searches the root moves on several threads. Many searches that run side by side
+   // are faster with one thread each.
+   bool isParallel = true;
+};
+
+
+// Principal variation of a move of the searching side.
+struct SearchLine
+{
+   // Score from the point of view of the searching side.
+   float score = 0.f;
+   // Starts with the move.
+   std::vector<Move> pv;
+};
+
+
+// Counters of a search, summed over all threads. Used to detect changes of the
+// search performance.
+struct SearchStats
+{
+   std::uint64_t nodes = 0;
+   // Nodes at the depth limit, which get scored by their material.
+   std::uint64_t leafNodes = 0;
+   std::uint64_t hashProbes = 0;
+   std::uint64_t hashHits = 0;
+   // Hash hits whose score decides the node without searching it.
+   std::uint64_t hashCutoffs = 0;
+   std::uint64_t tablebaseHits = 0;
+   // Leaf scores looked up in the evaluation cache and found there.
+   std::uint64_t evalProbes = 0;
+   std::uint64_t evalHits = 0;
+   std::uint64_t betaCutoffs = 0;
+   // Beta cutoffs by the first searched move. The more, the better the move order.
+   std::uint64_t firstMoveCutoffs = 0;
+   // Nodes and time of each completed iteration, starting at depth one.
+   std::vector<std::uint64_t> iterationNodes;
+   std::vector<std::chrono::milliseconds> iterationTimes;
+   // Nodes of each thread that took part in the search.
+   std::vector<std::uint64_t> threadNodes;
+
+   // Ratio of the nodes of the last two completed iterations. Zero if there are
+   // fewer.
+   double branchingFactor() const;
+   // Share of the beta cutoffs that the first move caused.
+   double firstMoveCutoffRate() const;
+   // Share of the evaluation cache probes that found the score.
+   double evalHitRate() const;
+   // Adds the counters of another search or thread. Keeps the iterations and
+   // threads.
+   SearchStats& operator+=(const SearchStats& other);
+};
+
+
+// Result of a completed iteration of a search.
+struct SearchResult
+{
+   // Depth in plies.
+   std::size_t depth = 0;
+   std::uint64_t nodes = 0;
+   std::chrono::milliseconds time{0};
+   // Score from the point of view of the searching side.
+   float score = 0.f;
+   // Principal variation. Starts with the best move. Empty if the side has no moves.
+   std::vector<Move> pv;
+   // Lead of the best move over the second best. Infinite if there is only one move.
+   // At least the lead if the second best move is not one of the lines, because
+   // the search only bounds the scores of the other moves.
+   float bestMoveMargin = 0.f;
+   // Used transposition table slots in permill.
+   std::size_t hashfull = 0;
+   // Lines of the best moves up to the requested number, best first. The first line
+   // has the score and principal variation of the result.
+   std::vector<SearchLine> lines;
+   // Includes the counters of an interrupted iteration in the final result.
+   SearchStats stats;
+
+   std::optional<Move> bestMove() const;
+   // Expected reply of the opponent to the best move.
+   std::optional<Move> ponderMove() const;
+};
+
+using SearchCallback = std::function<void(const SearchResult&)>;
+
+
+// Whether searches with given limits score the positions at the depth limit the same
+// way, so that they may share an evaluation cache. Evaluations only compare equal if
+// both are empty or both are the same function pointer. Networks compare by address.
+bool haveSameEvaluation(const SearchLimits& a, const SearchLimits& b);
+
+
+// Searches the moves of a given side with iterative deepening until a limit is
+// reached or the search is stopped. The threads poll the stop flag and the node and
+// time limits every few nodes. Returns the result of the deepest completed
+// iteration. The first iteration always completes, so that there is a move to play.
+// Reports each completed iteration to an optional callback.
+// Threads searching the same table share their results.
+// Looks up positions of solved endgames in tablebases instead of searching them.
+// Looks up the scores of positions in an optional evaluation cache before
+// evaluating them with an evaluation or a network. Material scores skip the cache.
+SearchResult search(const Position& pos, Color side, const SearchLimits& limits,
+                    TranspositionTable& tt, const std::atomic<bool>& stop,
+                    const SearchCallback& onIteration = {},
+                    const Tablebases& tablebases = Tablebases::builtIn(),
+                    EvalCache* evalCache = nullptr);
+
+// Returns up to a given number of the best moves of a side with their scores and
+// principal variations, best first. Looks ahead a given number of turns like
+// makeMove and finds all lines in one search.
+std::vector<SearchLine> bestLines(const Position& pos, Color side, std::size_t turns,
+                                  std::size_t numLines);
+
+// Returns the position after the best move of a given side found within given search
+// limits. Stops early when a cancel flag gets set and makes the best move found so
+// far. Clients that abandon a request set the flag to free the threads at once.
+std::optional<Position> makeMove(const Position& pos, Color side,
+                                 const SearchLimits& limits,
+                                 const std::atomic<bool>& cancel);
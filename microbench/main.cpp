@@ -0,0 +1,360 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "eval_kernels.h"
+#include "evaluation.h"
+#include "fen.h"
+#include "move.h"
+#include "nnue.h"
+#include "piece.h"
+#include "position.h"
+#include "square.h"
+#include "dscpp/SboVector.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Measures the time per operation of the primitives that the search spends its time
+// in, e.g.
+//    matt_microbench --filter makeMove --repetitions 20
+// Each benchmark runs in batches that are long enough to time reliably and reports
+// statistics over repeated batches.
+
+
+namespace
+{
+///////////////////
+
+using Clock = std::chrono::steady_clock;
+
+// Time that each batch of operations runs at least.
+constexpr std::chrono::milliseconds MinBatchTime{20};
+constexpr std::size_t DefaultRepetitions = 10;
+
+// Middlegame with all kinds of pieces.
+constexpr std::string_view MiddlegameFen =
+   "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1";
+constexpr std::string_view StartNotation =
+   "Rwa1 Nwb1 Bwc1 Qwd1 Kwe1 Bwf1 Nwg1 Rwh1 wa2 wb2 wc2 wd2 we2 wf2 wg2 wh2 "
+   "Rba8 Nbb8 Bbc8 Qbd8 Kbe8 Bbf8 Nbg8 Rbh8 ba7 bb7 bc7 bd7 be7 bf7 bg7 bh7";
+
+
+// Keeps the compiler from optimizing away a computed value.
+template <typename T> void doNotOptimize(const T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+   asm volatile("" : : "r,m"(value) : "memory");
+#else
+   static const void* volatile sink = nullptr;
+   sink = &value;
+#endif
+}
+
+
+struct Benchmark
+{
+   std::string name;
+   // Runs the operation a given number of times.
+   std::function<void(std::size_t)> run;
+};
+
+
+struct Stats
+{
+   double median = 0.;
+   double mean = 0.;
+   double stddev = 0.;
+   double min = 0.;
+};
+
+
+double measureBatch(const Benchmark& benchmark, std::size_t iterations)
+{
+   const Clock::time_point start = Clock::now();
+   benchmark.run(iterations);
+   const std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+   return elapsed.count();
+}
+
+
+// Doubles the batch size until a batch takes long enough.
+std::size_t calibrate(const Benchmark& benchmark)
+{
+   const double minNs = std::chrono::duration<double, std::nano>{MinBatchTime}.count();
+   std::size_t iterations = 1;
+   while (measureBatch(benchmark, iterations) < minNs)
+      iterations *= 2;
+   return iterations;
+}
+
+
+// Nanoseconds per operation over repeated batches.
+Stats measure(const Benchmark& benchmark, std::size_t repetitions)
+{
+   const std::size_t iterations = calibrate(benchmark);
+   std::vector<double> nsPerOp;
+   for (std::size_t i = 0; i < repetitions; ++i)
+      nsPerOp.push_back(measureBatch(benchmark, iterations) /
+                        static_cast<double>(iterations));
+
+   std::sort(std::begin(nsPerOp), std::end(nsPerOp));
+   const auto n = static_cast<double>(nsPerOp.size());
+   Stats stats;
+   stats.min = nsPerOp.front();
+   stats.median = nsPerOp[nsPerOp.size() / 2];
+   stats.mean = std::accumulate(std::begin(nsPerOp), std::end(nsPerOp), 0.) / n;
+   double variance = 0.;
+   for (const double ns : nsPerOp)
+      variance += (ns - stats.mean) * (ns - stats.mean);
+   stats.stddev = std::sqrt(variance / n);
+   return stats;
+}
+
+
+///////////////////
+
+Piece pieceOf(const Position& pos, Figure figure)
+{
+   return *pos[pos.squares(Color::White, figure)[0]];
+}
+
+
+std::vector<Benchmark> makeBenchmarks()
+{
+   static const Position middlegame = readFen(MiddlegameFen)->pos;
+   static const std::vector<Piece> pieces = [] {
+      std::vector<Piece> all = middlegame.pieces(Color::White);
+      const std::vector<Piece> black = middlegame.pieces(Color::Black);
+      all.insert(std::end(all), std::begin(black), std::end(black));
+      return all;
+   }();
+
+   std::vector<Benchmark> benchmarks;
+   benchmarks.push_back({"Position from notation", [](std::size_t n) {
+                            for (std::size_t i = 0; i < n; ++i)
+                               doNotOptimize(Position{StartNotation});
+                         }});
+   // Includes scoring the material, which every new position does.
+   benchmarks.push_back({"Position from pieces", [](std::size_t n) {
+                            for (std::size_t i = 0; i < n; ++i)
+                               doNotOptimize(Position{pieces});
+                         }});
+
+   static const Move quiet{pieceOf(middlegame, Figure::Queen), Square{"g3"}, middlegame};
+   static const Move capture{pieceOf(middlegame, Figure::Queen), Square{"f6"},
+                             middlegame};
+   benchmarks.push_back({"Position::makeMove quiet", [](std::size_t n) {
+                            for (std::size_t i = 0; i < n; ++i)
+                               doNotOptimize(middlegame.makeMove(quiet));
+                         }});
+   benchmarks.push_back({"Position::makeMove capture", [](std::size_t n) {
+                            for (std::size_t i = 0; i < n; ++i)
+                               doNotOptimize(middlegame.makeMove(capture));
+                         }});
+   // What the search does at each node.
+   benchmarks.push_back({"Position::makeUnrecordedMove quiet", [](std::size_t n) {
+                            for (std::size_t i = 0; i < n; ++i)
+                               doNotOptimize(middlegame.makeUnrecordedMove(quiet));
+                         }});
+
+   for (const Figure figure : {Figure::King, Figure::Queen, Figure::Rook,
+                               Figure::Bishop, Figure::Knight, Figure::Pawn})
+   {
+      const Piece piece = pieceOf(middlegame, figure);
+      benchmarks.push_back({"Piece::nextMoves " + piece.notate(Piece::Notation::FCL),
+                            [piece](std::size_t n) {
+                               for (std::size_t i = 0; i < n; ++i)
+                                  doNotOptimize(piece.nextMoves(middlegame));
+                            }});
+   }
+
+   // Squares with and without attackers.
+   static const std::array<Square, 4> targets = {Square{"e1"}, Square{"d5"},
+                                                 Square{"h8"}, Square{"a4"}};
+   benchmarks.push_back({"Position::isThreatenedBy", [](std::size_t n) {
+                            for (std::size_t i = 0; i < n; ++i)
+                               doNotOptimize(middlegame.isThreatenedBy(
+                                  targets[i % targets.size()], Color::Black));
+                         }});
+   benchmarks.push_back({"notateMove", [](std::size_t n) {
+                            const Piece queen = pieceOf(middlegame, Figure::Queen);
+                            for (std::size_t i = 0; i < n; ++i)
+                               doNotOptimize(notateMove(queen, Square{"f6"}, middlegame));
+                         }});
+
+   // Compares the instruction sets that the CPU supports.
+   static const BoardCodes codes = [] {
+      BoardCodes board{};
+      for (const Piece& piece : pieces)
+         board[piece.coord().index()] = pieceCode(piece.color(), piece.figure());
+      return board;
+   }();
+   static const PieceSquareTables tables = [] {
+      PieceSquareTables values{};
+      for (std::size_t i = Square::NumSquares; i < values.size(); ++i)
+         values[i] = static_cast<std::int32_t>(i % 23) - 11;
+      return values;
+   }();
+   // About as many bitboards as the evaluation counts for a middlegame.
+   static const std::vector<Bitboard> boards = [] {
+      std::vector<Bitboard> all;
+      for (const Piece& piece : pieces)
+         all.push_back(piece.coord().index() * 0x9E3779B97F4A7C15);
+      return all;
+   }();
+   static const std::vector<std::int32_t> weights(boards.size(), 3);
+   // About as many inputs as a hidden layer of a network.
+   static const std::vector<std::uint8_t> inputs(256, 100);
+   static const std::vector<std::int8_t> inputWeights(inputs.size(), -3);
+   for (const SimdLevel level : {SimdLevel::Scalar, SimdLevel::Sse41, SimdLevel::Avx2})
+   {
+      if (level > detectSimdLevel())
+         continue;
+      const EvalKernels& kernels = evalKernels(level);
+      const std::string suffix = " " + std::string{notateSimdLevel(level)};
+      benchmarks.push_back({"pieceSquareSum" + suffix, [&kernels](std::size_t n) {
+                               for (std::size_t i = 0; i < n; ++i)
+                                  doNotOptimize(kernels.pieceSquareSum(codes, tables));
+                            }});
+      benchmarks.push_back({"weightedPopcount" + suffix, [&kernels](std::size_t n) {
+                               for (std::size_t i = 0; i < n; ++i)
+                                  doNotOptimize(kernels.weightedPopcount(
+                                     boards.data(), weights.data(), boards.size()));
+                            }});
+      benchmarks.push_back({"dotProduct" + suffix, [&kernels](std::size_t n) {
+                               for (std::size_t i = 0; i < n; ++i)
+                                  doNotOptimize(kernels.dotProduct(
+                                     inputs.data(), inputWeights.data(), inputs.size()));
+                            }});
+      benchmarks.push_back({"evaluatePosition" + suffix, [&kernels](std::size_t n) {
+                               for (std::size_t i = 0; i < n; ++i)
+                                  doNotOptimize(evaluatePosition(middlegame, kernels));
+                            }});
+   }
+
+   // Compares updating the accumulator of a network for a move to summing all
+   // features.
+   static const Network network = [] {
+      NetworkWeights netWeights;
+      netWeights.hiddenSize = 256;
+      netWeights.layerSize = 32;
+      netWeights.featureWeights.assign(Network::NumFeatures * netWeights.hiddenSize, 1);
+      netWeights.featureBiases.assign(netWeights.hiddenSize, 0);
+      netWeights.layerWeights.assign(netWeights.layerSize * netWeights.hiddenSize, 1);
+      netWeights.layerBiases.assign(netWeights.layerSize, 0);
+      netWeights.outputWeights.assign(netWeights.layerSize, 1);
+      netWeights.outputScale = 0.01f;
+      return *Network::make(std::move(netWeights));
+   }();
+   static const Accumulator accumulator = [] {
+      Accumulator acc;
+      network.refresh(acc, middlegame);
+      return acc;
+   }();
+   static const Position afterCapture = middlegame.makeMove(capture);
+   benchmarks.push_back({"Network::refresh", [](std::size_t n) {
+                            Accumulator acc;
+                            for (std::size_t i = 0; i < n; ++i)
+                            {
+                               network.refresh(acc, afterCapture);
+                               doNotOptimize(acc);
+                            }
+                         }});
+   benchmarks.push_back({"Network::update capture", [](std::size_t n) {
+                            Accumulator acc;
+                            for (std::size_t i = 0; i < n; ++i)
+                            {
+                               network.update(accumulator, acc, middlegame, afterCapture,
+                                              capture);
+                               doNotOptimize(acc);
+                            }
+                         }});
+   benchmarks.push_back({"Network::evaluate", [](std::size_t n) {
+                            for (std::size_t i = 0; i < n; ++i)
+                               doNotOptimize(network.evaluate(accumulator));
+                         }});
+
+   using Squares = ds::SboVector<Square, 32>;
+   benchmarks.push_back({"SboVector push_back 32", [](std::size_t n) {
+                            for (std::size_t i = 0; i < n; ++i)
+                            {
+                               Squares squares;
+                               for (std::size_t idx = 0; idx < 32; ++idx)
+                                  squares.push_back(Square::fromIndex(idx));
+                               doNotOptimize(squares);
+                            }
+                         }});
+   static const Squares full = [] {
+      Squares squares;
+      for (std::size_t idx = 0; idx < 32; ++idx)
+         squares.push_back(Square::fromIndex(idx));
+      return squares;
+   }();
+   benchmarks.push_back({"SboVector copy 32", [](std::size_t n) {
+                            for (std::size_t i = 0; i < n; ++i)
+                               doNotOptimize(Squares{full});
+                         }});
+   return benchmarks;
+}
+
+
+struct Options
+{
+   std::string filter;
+   std::size_t repetitions = DefaultRepetitions;
+};
+
+
+std::optional<Options> readOptions(int argc, char* argv[])
+{
+   Options options;
+   for (int i = 1; i + 1 < argc; i += 2)
+   {
+      const std::string arg = argv[i];
+      if (arg == "--filter")
+         options.filter = argv[i + 1];
+      else if (arg == "--repetitions")
+         options.repetitions = std::max(std::strtoul(argv[i + 1], nullptr, 10), 1ul);
+      else
+         return std::nullopt;
+   }
+   if (argc % 2 == 0)
+      return std::nullopt;
+   return options;
+}
+
+} // namespace
+
+
+int main(int argc, char* argv[])
+{
+   const std::optional<Options> options = readOptions(argc, argv);
+   if (!options.has_value())
+   {
+      std::cerr << "usage: matt_microbench [--filter <name>] [--repetitions <n>]\n";
+      return EXIT_FAILURE;
+   }
+
+   std::printf("%-32s %12s %12s %12s %12s\n", "benchmark (ns/op)", "median", "mean",
+               "stddev", "min");
+   for (const Benchmark& benchmark : makeBenchmarks())
+   {
+      if (benchmark.name.find(options->filter) == std::string::npos)
+         continue;
+      const Stats stats = measure(benchmark, options->repetitions);
+      std::printf("%-32s %12.1f %12.1f %12.1f %12.1f\n", benchmark.name.c_str(),
+                  stats.median, stats.mean, stats.stddev, stats.min);
+   }
+   return EXIT_SUCCESS;
+}
@@ -14,14 +14,24 @@ Move::Move(const Piece& piece, Square to, const Position& pos)
 }
 
 
-std::string notateMove(const Piece& piece, Square to, const Position& pos)
+Move::Move(const Piece& pawn, Square to, Figure promotion, const Position& pos)
+   : Move{pawn, to, promotion, notateMove(pawn, to, pos, promotion)}
+{
+}
+
+
+std::string notateMove(const Piece& piece, Square to, const Position& pos,
+                       std::optional<Figure> promotion)
 {
    // todo - check for ambiguities
-   pos;
+
+   if (isCastling(piece, to))
+      return to.file() == 'g' ? "O-O" : "O-O-O";
 
    std::string notation = piece.notate();
 
-   const bool isCapture = pos.isOccupiedBy(to, !piece.color());
+   const bool isCapture =
+      pos.isOccupiedBy(to, !piece.color()) || isEnPassant(piece, to, pos);
    if (isCapture)
    {
       // For capturing pawn moves the departing file is notated.
@@ -31,5 +41,32 @@ std::string notateMove(const Piece& piece, Square to, const Position& pos)
    }
    
    notation += to.notate();
+   if (promotion.has_value())
+   {
+      notation += "=";
+      notation += notateFigure(*promotion);
+   }
    return notation;
 }
+
+
+bool isCastling(const Piece& piece, Square to)
+{
+   if (piece.figure() != Figure::King || !to)
+      return false;
+   const int df = to.fileIndex() - piece.coord().fileIndex();
+   return to.rankIndex() == piece.coord().rankIndex() && (df == 2 || df == -2);
+}
+
+
+bool isEnPassant(const Piece& piece, Square to, const Position& pos)
+{
+   if (piece.figure() != Figure::Pawn || !to ||
+       to.fileIndex() == piece.coord().fileIndex() || pos[to].has_value())
+   {
+      return false;
+   }
+   // The captured pawn stands next to the capturing pawn.
+   const Square passed{to.file(), piece.coord().rank()};
+   return pos[passed] == Piece{Figure::Pawn, !piece.color(), passed};
+}
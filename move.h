@@ -5,6 +5,7 @@
 #pragma once
 #include "piece.h"
 #include "square.h"
+#include <optional>
 #include <string>
 
 class Position;
@@ -18,12 +19,16 @@ class Move
    Move() = default;
    Move(const Piece& piece, Square to, std::string notation);
    Move(const Piece& piece, Square to, const Position& pos);
+   // Pawn moves that promote the pawn to a given figure.
+   Move(const Piece& pawn, Square to, Figure promotion, std::string notation);
+   Move(const Piece& pawn, Square to, Figure promotion, const Position& pos);
 
    const Piece& piece() const { return m_piece; }
    Square from() const { return m_piece.coord(); }
    Square to() const { return m_to; }
    const std::string& notate() const { return m_notation; }
-   Piece movedPiece() const { return m_piece.move(m_to); }
+   std::optional<Figure> promotion() const { return m_promotion; }
+   Piece movedPiece() const;
 
    friend void swap(Move& a, Move& b) noexcept
    {
@@ -31,11 +36,13 @@ class Move
       swap(a.m_piece, b.m_piece);
       swap(a.m_to, b.m_to);
       swap(a.m_notation, b.m_notation);
+      swap(a.m_promotion, b.m_promotion);
    }
 
  private:
    Piece m_piece;
    Square m_to;
+   std::optional<Figure> m_promotion;
    // Need to store the move's notation because to resolve ambiguities the position from
    // which the move was made is needed to generate the notation.
    std::string m_notation;
@@ -47,9 +54,20 @@ inline Move::Move(const Piece& piece, Square to, std::string notation)
 {
 }
 
+inline Move::Move(const Piece& pawn, Square to, Figure promotion, std::string notation)
+: m_piece{pawn}, m_to{to}, m_promotion{promotion}, m_notation{std::move(notation)}
+{
+}
+
+inline Piece Move::movedPiece() const
+{
+   return Piece{m_promotion.value_or(m_piece.figure()), m_piece.color(), m_to};
+}
+
 inline bool operator==(const Move& a, const Move& b)
 {
-   return a.piece() == b.piece() && a.to() == b.to() && a.notate() == b.notate();
+   return a.piece() == b.piece() && a.to() == b.to() && a.promotion() == b.promotion() &&
+          a.notate() == b.notate();
 }
 
 inline bool operator!=(const Move& a, const Move& b)
@@ -62,4 +80,13 @@ inline bool operator!=(const Move& a, const Move& b)
 
 // Returns notation for moving a given piece to a square.
 // Does not check if the move is valid.
-std::string notateMove(const Piece& piece, Square to, const Position& pos);
+std::string notateMove(const Piece& piece, Square to, const Position& pos,
+                       std::optional<Figure> promotion = std::nullopt);
+
+// Special moves. Recognized by how the piece moves, so that they need no extra
+// state.
+// Castling moves the king two files towards the rook.
+bool isCastling(const Piece& piece, Square to);
+// En passant captures move a pawn diagonally onto an empty square behind a pawn of
+// the other side.
+bool isEnPassant(const Piece& piece, Square to, const Position& pos);
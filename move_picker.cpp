@@ -0,0 +1,226 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "move_picker.h"
+#include "position.h"
+#include <algorithm>
+#include <iterator>
+
+
+namespace
+{
+///////////////////
+
+// Rank of figures for ordering captures.
+int orderValue(Figure f)
+{
+   switch (f)
+   {
+   case Figure::King:
+      return 6;
+   case Figure::Queen:
+      return 5;
+   case Figure::Rook:
+      return 4;
+   case Figure::Bishop:
+      return 3;
+   case Figure::Knight:
+      return 2;
+   case Figure::Pawn:
+      return 1;
+   default:
+      return 0;
+   }
+}
+
+
+// Most valuable victim first, least valuable attacker first for the same
+// victim.
+int captureOrder(const Move& capture, const Position& pos)
+{
+   const auto victim = pos[capture.to()];
+   const int victimValue = victim.has_value() ? orderValue(victim->figure()) : 0;
+   return victimValue * 8 - orderValue(capture.piece().figure());
+}
+
+} // namespace
+
+
+///////////////////
+
+MovePicker::MovePicker(const Position& pos, Color side, std::optional<Move> hashMove,
+                       const Killers& killers, std::pmr::memory_resource* mem)
+: m_pos{pos}, m_side{side}, m_hashMove{std::move(hashMove)}, m_killers{killers},
+  m_moves{mem}
+{
+}
+
+
+std::optional<Move> MovePicker::next()
+{
+   std::optional<Move> move;
+
+   while (!move.has_value() && m_stage != Stage::Done)
+   {
+      switch (m_stage)
+      {
+      case Stage::HashMove:
+         move = pickHashMove();
+         m_stage = Stage::GenerateCaptures;
+         break;
+      case Stage::GenerateCaptures:
+         generateCaptures();
+         m_stage = Stage::Captures;
+         break;
+      case Stage::Captures:
+         move = pickCapture();
+         if (!move.has_value())
+            m_stage = Stage::Killers;
+         break;
+      case Stage::Killers:
+         move = pickKiller();
+         if (!move.has_value())
+            m_stage = Stage::Quiets;
+         break;
+      case Stage::Quiets:
+         move = pickQuiet();
+         if (!move.has_value())
+            m_stage = Stage::Done;
+         break;
+      default:
+         m_stage = Stage::Done;
+         break;
+      }
+   }
+
+   return move;
+}
+
+
+std::optional<Move> MovePicker::pickHashMove()
+{
+   m_hashMove = validate(m_hashMove);
+   return m_hashMove;
+}
+
+
+void MovePicker::generateCaptures()
+{
+   m_moves.clear();
+   m_moveIdx = 0;
+   forEachPiece(m_pos, m_side,
+                [this](const Piece& piece) { piece.nextCaptures(m_pos, m_moves); });
+
+   std::stable_sort(std::begin(m_moves), std::end(m_moves),
+                    [this](const Move& a, const Move& b) {
+                       return captureOrder(a, m_pos) > captureOrder(b, m_pos);
+                    });
+}
+
+
+std::optional<Move> MovePicker::pickCapture()
+{
+   while (m_moveIdx < m_moves.size())
+   {
+      const Move& move = m_moves[m_moveIdx++];
+      if (!wasPicked(move))
+         return move;
+   }
+   return std::nullopt;
+}
+
+
+std::optional<Move> MovePicker::pickKiller()
+{
+   while (m_killerIdx < m_killers.size())
+   {
+      const std::size_t idx = m_killerIdx++;
+      // Killers are quiet moves that caused a cutoff in a sibling position.
+      auto killer = validate(m_killers[idx]);
+      if (killer.has_value() && !isCapture(*killer, m_pos) && !wasPicked(*killer))
+      {
+         m_pickedKillers[idx] = killer;
+         return killer;
+      }
+   }
+   return std::nullopt;
+}
+
+
+std::optional<Move> MovePicker::pickQuiet()
+{
+   while (true)
+   {
+      while (m_moveIdx < m_moves.size())
+      {
+         const Move& move = m_moves[m_moveIdx++];
+         if (!wasPicked(move))
+            return move;
+      }
+
+      const std::optional<Piece> piece = nextPiece();
+      if (!piece.has_value())
+         return std::nullopt;
+
+      // Generate the quiet moves of the next piece. Reuses the list's memory.
+      m_moves.clear();
+      m_moveIdx = 0;
+      piece->nextQuietMoves(m_pos, m_moves);
+   }
+}
+
+
+std::optional<Piece> MovePicker::nextPiece()
+{
+   while (m_figureIdx < NumFigures)
+   {
+      const Figure figure = static_cast<Figure>(m_figureIdx);
+      const SquareList& squares = m_pos.squares(m_side, figure);
+      if (m_squareIdx < squares.size())
+         return Piece{figure, m_side, squares[m_squareIdx++]};
+
+      ++m_figureIdx;
+      m_squareIdx = 0;
+   }
+   return std::nullopt;
+}
+
+
+bool MovePicker::wasPicked(const Move& move) const
+{
+   if (m_hashMove.has_value() && isSameMove(move, *m_hashMove))
+      return true;
+   return std::any_of(std::begin(m_pickedKillers), std::end(m_pickedKillers),
+                      [&move](const std::optional<Move>& killer) {
+                         return killer.has_value() && isSameMove(move, *killer);
+                      });
+}
+
+
+std::optional<Move> MovePicker::validate(const std::optional<Move>& move) const
+{
+   if (!move.has_value() || move->piece().color() != m_side ||
+       m_pos[move->from()] != move->piece() ||
+       !move->piece().canMoveTo(move->to(), m_pos))
+   {
+      return std::nullopt;
+   }
+
+   // Rebuild the move because its notation depends on the position.
+   return Move{move->piece(), move->to(), m_pos};
+}
+
+
+///////////////////
+
+bool isSameMove(const Move& a, const Move& b)
+{
+   return a.piece() == b.piece() && a.to() == b.to();
+}
+
+
+bool isCapture(const Move& move, const Position& pos)
+{
+   return pos.isOccupiedBy(move.to(), !move.piece().color());
+}
@@ -0,0 +1,83 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#pragma once
+#include "move.h"
+#include "piece.h"
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+#include <optional>
+
+class Position;
+
+
+///////////////////
+
+// Yields the moves of one side in stages so that a search that cuts off early
+// does not pay for generating moves it never looks at:
+// - the hash move, without generating any moves
+// - captures, most valuable victim first
+// - killer moves, without generating any moves
+// - quiet moves, generated piece by piece on demand
+class MovePicker
+{
+ public:
+   using Killers = std::array<std::optional<Move>, 2>;
+
+   // Generated moves are allocated from a given memory resource, e.g. an arena that
+   // the search rewinds after each node.
+   MovePicker(const Position& pos, Color side,
+              std::optional<Move> hashMove = std::nullopt, const Killers& killers = {},
+              std::pmr::memory_resource* mem = std::pmr::get_default_resource());
+
+   std::optional<Move> next();
+
+ private:
+   enum class Stage
+   {
+      HashMove,
+      GenerateCaptures,
+      Captures,
+      Killers,
+      Quiets,
+      Done
+   };
+
+   std::optional<Move> pickHashMove();
+   void generateCaptures();
+   std::optional<Move> pickCapture();
+   std::optional<Move> pickKiller();
+   std::optional<Move> pickQuiet();
+   // Iterates the pieces of the side.
+   std::optional<Piece> nextPiece();
+   // Checks if a given move was yielded in an earlier stage.
+   bool wasPicked(const Move& move) const;
+   // Makes a move for the current position if it is a valid move.
+   std::optional<Move> validate(const std::optional<Move>& move) const;
+
+ private:
+   const Position& m_pos;
+   Color m_side = Color::White;
+   Stage m_stage = Stage::HashMove;
+   std::optional<Move> m_hashMove;
+   Killers m_killers;
+   std::size_t m_killerIdx = 0;
+   // Killers that were yielded.
+   std::array<std::optional<Move>, 2> m_pickedKillers;
+   // Position of the next piece to generate quiet moves for.
+   std::size_t m_figureIdx = 0;
+   std::size_t m_squareIdx = 0;
+   // Generated moves of the current stage.
+   MoveList m_moves;
+   std::size_t m_moveIdx = 0;
+};
+
+
+///////////////////
+
+// Checks if two moves move the same piece to the same square. Ignores their
+// notation.
+bool isSameMove(const Move& a, const Move& b);
+bool isCapture(const Move& move, const Position& pos);
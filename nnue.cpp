@@ -0,0 +1,228 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "nnue.h"
+#include "mapped_file.h"
+#include "move.h"
+#include "position.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+
+namespace
+{
+///////////////////
+
+// The outputs of both layers get clipped to 0..127, which fits the unsigned 8-bit
+// inputs of the next layer. The 8-bit weights are scaled by 64.
+constexpr std::int32_t ClipMax = 127;
+constexpr std::int32_t WeightScale = 64;
+
+// File layout: magic bytes, sizes of the layers, output scale and bias, then the
+// weights and biases in the order of NetworkWeights.
+constexpr char Magic[] = {'M', 'N', 'N', '1'};
+constexpr std::size_t HeaderSize = sizeof(Magic) + 2 * sizeof(std::uint32_t) +
+                                   sizeof(float) + sizeof(std::int32_t);
+
+
+std::size_t fileSize(std::size_t hiddenSize, std::size_t layerSize)
+{
+   return HeaderSize +
+          (Network::NumFeatures * hiddenSize + hiddenSize) * sizeof(std::int16_t) +
+          layerSize * hiddenSize * sizeof(std::int8_t) +
+          layerSize * sizeof(std::int32_t) + layerSize * sizeof(std::int8_t);
+}
+
+
+std::size_t featureIndex(const Piece& piece)
+{
+   return (pieceCode(piece.color(), piece.figure()) - 1u) * Square::NumSquares +
+          piece.coord().index();
+}
+
+
+template <typename T>
+const std::byte* readValues(const std::byte* data, std::vector<T>& values)
+{
+   std::memcpy(values.data(), data, values.size() * sizeof(T));
+   return data + values.size() * sizeof(T);
+}
+
+
+template <typename T>
+std::byte* writeValues(std::byte* data, const std::vector<T>& values)
+{
+   std::memcpy(data, values.data(), values.size() * sizeof(T));
+   return data + values.size() * sizeof(T);
+}
+
+} // namespace
+
+
+///////////////////
+
+std::optional<Network> Network::make(NetworkWeights weights)
+{
+   const std::size_t hidden = weights.hiddenSize;
+   const std::size_t layer = weights.layerSize;
+   if (hidden == 0 || hidden > MaxHiddenSize || layer == 0 || layer > MaxLayerSize ||
+       weights.featureWeights.size() != NumFeatures * hidden ||
+       weights.featureBiases.size() != hidden ||
+       weights.layerWeights.size() != layer * hidden ||
+       weights.layerBiases.size() != layer || weights.outputWeights.size() != layer)
+      return std::nullopt;
+   return Network{std::move(weights)};
+}
+
+
+std::optional<Network> Network::load(const std::filesystem::path& path)
+{
+   const std::optional<MappedFile> file = MappedFile::open(path);
+   if (!file.has_value() || file->size() < HeaderSize ||
+       std::memcmp(file->data(), Magic, sizeof(Magic)) != 0)
+      return std::nullopt;
+
+   const std::byte* data = file->data() + sizeof(Magic);
+   std::uint32_t hiddenSize = 0;
+   std::uint32_t layerSize = 0;
+   NetworkWeights weights;
+   std::memcpy(&hiddenSize, data, sizeof(hiddenSize));
+   data += sizeof(hiddenSize);
+   std::memcpy(&layerSize, data, sizeof(layerSize));
+   data += sizeof(layerSize);
+   std::memcpy(&weights.outputScale, data, sizeof(weights.outputScale));
+   data += sizeof(weights.outputScale);
+   std::memcpy(&weights.outputBias, data, sizeof(weights.outputBias));
+   data += sizeof(weights.outputBias);
+
+   weights.hiddenSize = hiddenSize;
+   weights.layerSize = layerSize;
+   if (hiddenSize > MaxHiddenSize || layerSize > MaxLayerSize ||
+       file->size() != fileSize(hiddenSize, layerSize))
+      return std::nullopt;
+
+   weights.featureWeights.resize(NumFeatures * hiddenSize);
+   weights.featureBiases.resize(hiddenSize);
+   weights.layerWeights.resize(layerSize * hiddenSize);
+   weights.layerBiases.resize(layerSize);
+   weights.outputWeights.resize(layerSize);
+   data = readValues(data, weights.featureWeights);
+   data = readValues(data, weights.featureBiases);
+   data = readValues(data, weights.layerWeights);
+   data = readValues(data, weights.layerBiases);
+   readValues(data, weights.outputWeights);
+   return make(std::move(weights));
+}
+
+
+bool Network::save(const std::filesystem::path& path) const
+{
+   std::optional<MappedFile> file =
+      MappedFile::create(path, fileSize(m_weights.hiddenSize, m_weights.layerSize));
+   if (!file.has_value() || file->writableData() == nullptr)
+      return false;
+
+   std::byte* data = file->writableData();
+   const auto hiddenSize = static_cast<std::uint32_t>(m_weights.hiddenSize);
+   const auto layerSize = static_cast<std::uint32_t>(m_weights.layerSize);
+   std::memcpy(data, Magic, sizeof(Magic));
+   data += sizeof(Magic);
+   std::memcpy(data, &hiddenSize, sizeof(hiddenSize));
+   data += sizeof(hiddenSize);
+   std::memcpy(data, &layerSize, sizeof(layerSize));
+   data += sizeof(layerSize);
+   std::memcpy(data, &m_weights.outputScale, sizeof(m_weights.outputScale));
+   data += sizeof(m_weights.outputScale);
+   std::memcpy(data, &m_weights.outputBias, sizeof(m_weights.outputBias));
+   data += sizeof(m_weights.outputBias);
+
+   data = writeValues(data, m_weights.featureWeights);
+   data = writeValues(data, m_weights.featureBiases);
+   data = writeValues(data, m_weights.layerWeights);
+   data = writeValues(data, m_weights.layerBiases);
+   writeValues(data, m_weights.outputWeights);
+   return true;
+}
+
+
+Network::Network(NetworkWeights weights)
+: m_weights{std::move(weights)}, m_kernels{&evalKernels()}
+{
+}
+
+
+void Network::refresh(Accumulator& acc, const Position& pos) const
+{
+   acc = m_weights.featureBiases;
+   for (const Color side : {Color::White, Color::Black})
+      forEachPiece(pos, side,
+                   [&](const Piece& piece) { addFeature(acc, featureIndex(piece)); });
+}
+
+
+void Network::update(const Accumulator& before, Accumulator& after, const Position& prev,
+                     const Position& next, const Move& move) const
+{
+   after = before;
+   // Squares that get emptied or filled, including castling rooks and pawns captured
+   // en passant, and the target square, whose piece changes on captures.
+   const Bitboard changed = (prev.occupied() ^ next.occupied()) | bit(move.to());
+   forEachSquare(changed, [&](Square sq) {
+      if (const std::optional<Piece> piece = prev[sq]; piece.has_value())
+         removeFeature(after, featureIndex(*piece));
+      if (const std::optional<Piece> piece = next[sq]; piece.has_value())
+         addFeature(after, featureIndex(*piece));
+   });
+}
+
+
+float Network::evaluate(const Accumulator& acc) const
+{
+   const std::size_t hiddenSize = m_weights.hiddenSize;
+   const std::size_t layerSize = m_weights.layerSize;
+
+   std::array<std::uint8_t, MaxHiddenSize> inputs;
+   for (std::size_t i = 0; i < hiddenSize; ++i)
+      inputs[i] = static_cast<std::uint8_t>(std::clamp<std::int32_t>(acc[i], 0, ClipMax));
+
+   std::array<std::uint8_t, MaxLayerSize> layer;
+   for (std::size_t j = 0; j < layerSize; ++j)
+   {
+      const std::int8_t* weights = m_weights.layerWeights.data() + j * hiddenSize;
+      const std::int32_t sum = m_weights.layerBiases[j] +
+                               m_kernels->dotProduct(inputs.data(), weights, hiddenSize);
+      const std::int32_t scaled = sum / WeightScale;
+      layer[j] = static_cast<std::uint8_t>(std::clamp<std::int32_t>(scaled, 0, ClipMax));
+   }
+
+   const std::int32_t output =
+      m_weights.outputBias +
+      m_kernels->dotProduct(layer.data(), m_weights.outputWeights.data(), layerSize);
+   return static_cast<float>(output) * m_weights.outputScale;
+}
+
+
+float Network::evaluate(const Position& pos) const
+{
+   Accumulator acc;
+   refresh(acc, pos);
+   return evaluate(acc);
+}
+
+
+void Network::addFeature(Accumulator& acc, std::size_t feature) const
+{
+   const std::int16_t* row = m_weights.featureWeights.data() + feature * acc.size();
+   for (std::size_t i = 0; i < acc.size(); ++i)
+      acc[i] = static_cast<std::int16_t>(acc[i] + row[i]);
+}
+
+
+void Network::removeFeature(Accumulator& acc, std::size_t feature) const
+{
+   const std::int16_t* row = m_weights.featureWeights.data() + feature * acc.size();
+   for (std::size_t i = 0; i < acc.size(); ++i)
+      acc[i] = static_cast<std::int16_t>(acc[i] - row[i]);
+}
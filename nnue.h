@@ -0,0 +1,86 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#pragma once
+#include "eval_kernels.h"
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <vector>
+
+class Move;
+class Position;
+
+
+///////////////////
+
+// Quantized weights of an efficiently updatable neural network. The inputs are one
+// feature for each piece on each square. The first layer is summed into an
+// accumulator of 16-bit values, the second layer and the output use 8-bit
+// weights.
+struct NetworkWeights
+{
+   // Outputs of the first layer.
+   std::size_t hiddenSize = 0;
+   // Outputs of the second layer.
+   std::size_t layerSize = 0;
+   // One row of hiddenSize weights per feature.
+   std::vector<std::int16_t> featureWeights;
+   std::vector<std::int16_t> featureBiases;
+   // One row of hiddenSize weights per output of the second layer.
+   std::vector<std::int8_t> layerWeights;
+   std::vector<std::int32_t> layerBiases;
+   std::vector<std::int8_t> outputWeights;
+   std::int32_t outputBias = 0;
+   // Pawns per unit of the output.
+   float outputScale = 0.f;
+};
+
+
+// Sums of the first layer for the features of a position.
+using Accumulator = std::vector<std::int16_t>;
+
+
+// Evaluates positions with a network. The search keeps an accumulator per ply and
+// updates it for the pieces that a move changes instead of summing all features
+// again.
+class Network
+{
+ public:
+   // One feature per piece code and square.
+   static constexpr std::size_t NumFeatures = (NumPieceCodes - 1) * Square::NumSquares;
+   // Largest layers that the evaluation keeps on the stack.
+   static constexpr std::size_t MaxHiddenSize = 1024;
+   static constexpr std::size_t MaxLayerSize = 64;
+
+   // Returns nothing if the sizes of the weights do not match.
+   static std::optional<Network> make(NetworkWeights weights);
+   // Returns nothing if the file cannot be read or is not a network.
+   static std::optional<Network> load(const std::filesystem::path& path);
+   // Returns false if the file cannot be written.
+   bool save(const std::filesystem::path& path) const;
+
+   const NetworkWeights& weights() const { return m_weights; }
+
+   void refresh(Accumulator& acc, const Position& pos) const;
+   // Computes the accumulator of the position after a move from the accumulator of
+   // the position before it.
+   void update(const Accumulator& before, Accumulator& after, const Position& prev,
+               const Position& next, const Move& move) const;
+   // Score from the point of view of White in the units of Position::score.
+   float evaluate(const Accumulator& acc) const;
+   // Sums all features of the position first.
+   float evaluate(const Position& pos) const;
+
+ private:
+   explicit Network(NetworkWeights weights);
+
+   void addFeature(Accumulator& acc, std::size_t feature) const;
+   void removeFeature(Accumulator& acc, std::size_t feature) const;
+
+ private:
+   NetworkWeights m_weights;
+   const EvalKernels* m_kernels = nullptr;
+};
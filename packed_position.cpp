@@ -0,0 +1,149 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "packed_position.h"
+#include "bitboard.h"
+#include <algorithm>
+#include <limits>
+
+
+namespace
+{
+///////////////////
+
+constexpr std::size_t OccupiedOffset = 0;
+constexpr std::size_t PiecesOffset = 8;
+constexpr std::size_t StateOffset = 24;
+constexpr std::size_t EnPassantOffset = 25;
+constexpr std::size_t HalfmoveOffset = 26;
+constexpr std::size_t FullmoveOffset = 28;
+constexpr std::uint8_t NoEnPassant = 0xFF;
+
+
+template <typename T> void writeLE(PackedPosition& packed, std::size_t offset, T value)
+{
+   for (std::size_t i = 0; i < sizeof(T); ++i)
+      packed.bytes[offset + i] = static_cast<std::uint8_t>(value >> (8 * i));
+}
+
+
+template <typename T> T readLE(const PackedPosition& packed, std::size_t offset)
+{
+   T value = 0;
+   for (std::size_t i = 0; i < sizeof(T); ++i)
+      value |= static_cast<T>(static_cast<T>(packed.bytes[offset + i]) << (8 * i));
+   return value;
+}
+
+
+std::uint16_t clamp16(std::size_t value)
+{
+   return static_cast<std::uint16_t>(
+      std::min<std::size_t>(value, std::numeric_limits<std::uint16_t>::max()));
+}
+
+
+std::uint8_t pieceNibble(const Piece& piece)
+{
+   return static_cast<std::uint8_t>(static_cast<std::size_t>(piece.color()) * NumFigures +
+                                    static_cast<std::size_t>(piece.figure()));
+}
+
+} // namespace
+
+
+///////////////////
+
+std::optional<PackedPosition> pack(const FenPosition& fen)
+{
+   PackedPosition packed;
+
+   const Bitboard occupied = fen.pos.occupied();
+   if (popcount(occupied) > static_cast<int>(PackedPosition::MaxPieces))
+      return std::nullopt;
+   writeLE(packed, OccupiedOffset, occupied);
+
+   std::size_t pieceIdx = 0;
+   forEachSquare(occupied, [&](Square sq) {
+      const std::uint8_t nibble = pieceNibble(*fen.pos[sq]);
+      std::uint8_t& byte = packed.bytes[PiecesOffset + pieceIdx / 2];
+      byte |= (pieceIdx % 2 == 0) ? nibble : static_cast<std::uint8_t>(nibble << 4);
+      ++pieceIdx;
+   });
+
+   packed.bytes[StateOffset] = static_cast<std::uint8_t>(
+      static_cast<std::uint8_t>(fen.side) | static_cast<std::uint8_t>(fen.castling) << 1);
+   packed.bytes[EnPassantOffset] =
+      fen.enPassant ? static_cast<std::uint8_t>(fen.enPassant.index()) : NoEnPassant;
+   writeLE(packed, HalfmoveOffset, clamp16(fen.halfmoveClock));
+   writeLE(packed, FullmoveOffset, clamp16(fen.fullmoveNumber));
+   return packed;
+}
+
+
+FenPosition unpack(const PackedPosition& packed)
+{
+   FenPosition fen;
+   Position& pos = fen.pos;
+
+   std::size_t pieceIdx = 0;
+   forEachSquare(readLE<Bitboard>(packed, OccupiedOffset), [&](Square sq) {
+      // Corrupted data may have more occupied squares than piece codes.
+      if (pieceIdx == PackedPosition::MaxPieces)
+         return;
+      const std::uint8_t byte = packed.bytes[PiecesOffset + pieceIdx / 2];
+      const std::size_t nibble = (pieceIdx % 2 == 0) ? (byte & 0xF) : (byte >> 4);
+      ++pieceIdx;
+      // Skip invalid codes of corrupted data.
+      if (nibble >= NumColors * NumFigures)
+         return;
+      const auto figure = static_cast<Figure>(nibble % NumFigures);
+      const auto side = static_cast<Color>(nibble / NumFigures);
+      // Skip pieces that a position cannot hold, like reading a FEN string does.
+      if (pos.squares(side, figure).size() == SquareList::Capacity)
+         return;
+      pos.addPiece(Piece{figure, side, sq});
+   });
+
+   const std::uint8_t state = packed.bytes[StateOffset];
+   fen.side = static_cast<Color>(state & 1);
+   fen.castling = static_cast<Castling>((state >> 1) & static_cast<int>(Castling::All));
+   const std::uint8_t enPassant = packed.bytes[EnPassantOffset];
+   fen.enPassant = enPassant == NoEnPassant ? Square{} : Square::fromIndex(enPassant);
+   fen.halfmoveClock = readLE<std::uint16_t>(packed, HalfmoveOffset);
+   fen.fullmoveNumber = readLE<std::uint16_t>(packed, FullmoveOffset);
+
+   pos.m_reversiblePlies = static_cast<std::uint16_t>(fen.halfmoveClock);
+   pos.m_record = Record{pos.m_hash};
+   pos.m_score = pos.calcScore();
+   return fen;
+}
+
+
+///////////////////
+
+PackedPositionReader::PackedPositionReader(const std::byte* data, std::size_t size)
+: m_positions{reinterpret_cast<const PackedPosition*>(data)},
+  m_size{size / PackedPosition::Size}
+{
+}
+
+
+PackedPositionWriter::PackedPositionWriter(std::byte* data, std::size_t size)
+: m_positions{reinterpret_cast<PackedPosition*>(data)},
+  m_capacity{size / PackedPosition::Size}
+{
+}
+
+
+bool PackedPositionWriter::write(std::size_t idx, const FenPosition& fen)
+{
+   if (idx >= m_capacity)
+      return false;
+   const std::optional<PackedPosition> packed = pack(fen);
+   if (!packed.has_value())
+      return false;
+   m_positions[idx] = *packed;
+   return true;
+}
@@ -0,0 +1,91 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#pragma once
+#include "fen.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+
+///////////////////
+
+// Position with its game state packed into 32 bytes:
+// - bytes 0-7: occupied squares, one bit per square
+// - bytes 8-23: a four bit piece code per occupied square in order of the squares
+// - byte 24: side to move (bit 0) and castling rights (bits 1-4)
+// - byte 25: en passant square, 0xFF if none
+// - bytes 26-27: halfmove clock
+// - bytes 28-29: fullmove number
+// - bytes 30-31: zero
+// Multi-byte values are little-endian, so that files can be shared across
+// platforms. Positions are stored back to back without any header, so that a file
+// of packed positions can be read in place.
+struct PackedPosition
+{
+   static constexpr std::size_t Size = 32;
+   // Holds at most the pieces of a legal game.
+   static constexpr std::size_t MaxPieces = 32;
+
+   std::array<std::uint8_t, Size> bytes{};
+};
+
+static_assert(sizeof(PackedPosition) == PackedPosition::Size);
+static_assert(alignof(PackedPosition) == 1);
+
+inline bool operator==(const PackedPosition& a, const PackedPosition& b)
+{
+   return a.bytes == b.bytes;
+}
+
+// Returns nothing if the position has too many pieces. Move counters that do not
+// fit into 16 bits are clamped.
+std::optional<PackedPosition> pack(const FenPosition& fen);
+// Skips the pieces of corrupted data that have invalid codes, that exceed the
+// maximal number of pieces or that a position cannot hold.
+FenPosition unpack(const PackedPosition& packed);
+
+
+///////////////////
+
+// Packed positions in memory, e.g. a memory mapped file. Does not copy the memory.
+class PackedPositionReader
+{
+ public:
+   // Trailing bytes that do not make up a whole position are ignored.
+   PackedPositionReader(const std::byte* data, std::size_t size);
+
+   std::size_t size() const { return m_size; }
+   const PackedPosition& packed(std::size_t idx) const { return m_positions[idx]; }
+   FenPosition operator[](std::size_t idx) const { return unpack(m_positions[idx]); }
+
+ private:
+   const PackedPosition* m_positions = nullptr;
+   std::size_t m_size = 0;
+};
+
+
+// Writes packed positions into memory, e.g. a memory mapped file.
+class PackedPositionWriter
+{
+ public:
+   PackedPositionWriter(std::byte* data, std::size_t size);
+
+   // Number of positions that fit into the memory.
+   std::size_t capacity() const { return m_capacity; }
+   // Returns false if the position can not be packed.
+   bool write(std::size_t idx, const FenPosition& fen);
+
+ private:
+   PackedPosition* m_positions = nullptr;
+   std::size_t m_capacity = 0;
+};
+
+
+// Number of bytes needed for a given number of packed positions.
+inline constexpr std::size_t packedSize(std::size_t numPositions)
+{
+   return numPositions * PackedPosition::Size;
+}
@@ -0,0 +1,442 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "pgn.h"
+#include "attack_tables.h"
+#include "fen.h"
+#include <algorithm>
+#include <array>
+#include <istream>
+
+
+namespace
+{
+///////////////////
+
+bool isSpace(char ch)
+{
+   return ch == ' ' || ch == '\t' || ch == '\r' || ch == '\n';
+}
+
+
+std::string_view trim(std::string_view str)
+{
+   while (!str.empty() && isSpace(str.front()))
+      str.remove_prefix(1);
+   while (!str.empty() && isSpace(str.back()))
+      str.remove_suffix(1);
+   return str;
+}
+
+
+bool isResult(std::string_view token)
+{
+   return token == "1-0" || token == "0-1" || token == "1/2-1/2" || token == "*";
+}
+
+
+// Ends a token in the movetext.
+bool isDelimiter(char ch)
+{
+   return isSpace(ch) || ch == '{' || ch == '}' || ch == '(' || ch == ')' || ch == ';';
+}
+
+
+// Removes a leading move number like "12." or "12..." from a token.
+std::string_view skipMoveNumber(std::string_view token)
+{
+   std::size_t idx = 0;
+   while (idx < token.size() && token[idx] >= '0' && token[idx] <= '9')
+      ++idx;
+   if (idx == 0 || idx == token.size() || token[idx] != '.')
+      return idx == token.size() ? std::string_view{} : token;
+   while (idx < token.size() && token[idx] == '.')
+      ++idx;
+   return token.substr(idx);
+}
+
+
+std::optional<Figure> sanFigure(char ch)
+{
+   switch (ch)
+   {
+   case 'K':
+   case 'Q':
+   case 'R':
+   case 'B':
+   case 'N':
+      return makeFigure(ch);
+   default:
+      return std::nullopt;
+   }
+}
+
+
+bool leavesKingInCheck(const Move& move, const Position& pos, Color side)
+{
+   const Position next = pos.makeMove(move);
+   const SquareList& kings = next.squares(side, Figure::King);
+   return !kings.empty() && next.isThreatenedBy(kings[0], !side);
+}
+
+
+std::optional<Move> readCastling(std::string_view san, const Position& pos, Color side)
+{
+   const SquareList& kings = pos.squares(side, Figure::King);
+   if (kings.empty())
+      return std::nullopt;
+
+   const Piece king{Figure::King, side, kings[0]};
+   const bool isKingside = san == "O-O" || san == "0-0";
+   const Square to = Square::fromIndex(king.coord().index() + (isKingside ? 2 : -2));
+   if (!to || to.rankIndex() != king.coord().rankIndex())
+      return std::nullopt;
+   return Move{king, to, isKingside ? "O-O" : "O-O-O"};
+}
+
+} // namespace
+
+
+///////////////////
+
+std::optional<std::string_view> PgnGame::tag(std::string_view name) const
+{
+   const auto it = std::find_if(tags.begin(), tags.end(),
+                                [name](const PgnTag& tag) { return tag.name == name; });
+   if (it == tags.end())
+      return std::nullopt;
+   return it->value;
+}
+
+
+void PgnGame::clear()
+{
+   tags.clear();
+   moves.clear();
+   positions.clear();
+   firstSide = Color::White;
+   result.clear();
+   isComplete = true;
+}
+
+
+///////////////////
+
+PgnReader::PgnReader(std::istream& in) : m_in{&in}
+{
+}
+
+
+PgnReader::PgnReader(std::string_view buffer) : m_buffer{buffer}
+{
+}
+
+
+bool PgnReader::next(PgnGame& game)
+{
+   game.clear();
+   m_isInComment = false;
+   m_variationDepth = 0;
+
+   bool hasTags = false;
+   bool hasMoves = false;
+   std::string_view line;
+   while (nextLine(line))
+   {
+      line = trim(line);
+      // Lines starting with a percent sign are escaped.
+      if (line.empty() || (line[0] == '%' && !m_isInComment))
+         continue;
+
+      if (line[0] == '[' && !m_isInComment)
+      {
+         // Tags after moves belong to the next game that follows a game without
+         // result.
+         if (hasMoves)
+         {
+            unreadLine(line);
+            return true;
+         }
+         readTag(line, game);
+         hasTags = true;
+         continue;
+      }
+
+      if (!hasMoves)
+      {
+         startGame(game);
+         hasMoves = true;
+      }
+      if (readMovetext(line, game))
+         return true;
+   }
+
+   // A game may end without a result at the end of the input.
+   if (hasTags && !hasMoves)
+      startGame(game);
+   return hasTags || hasMoves;
+}
+
+
+bool PgnReader::nextLine(std::string_view& line)
+{
+   if (m_unreadLine.has_value())
+   {
+      line = *m_unreadLine;
+      m_unreadLine.reset();
+      return true;
+   }
+
+   if (m_in)
+   {
+      if (!std::getline(*m_in, m_line))
+         return false;
+      line = m_line;
+      return true;
+   }
+
+   if (m_offset >= m_buffer.size())
+      return false;
+   std::size_t end = m_buffer.find('\n', m_offset);
+   if (end == std::string_view::npos)
+      end = m_buffer.size();
+   line = m_buffer.substr(m_offset, end - m_offset);
+   m_offset = end + 1;
+   return true;
+}
+
+
+void PgnReader::unreadLine(std::string_view line)
+{
+   // For streams the line refers to the line storage, which stays untouched until
+   // the line is read again.
+   m_unreadLine = line;
+}
+
+
+void PgnReader::readTag(std::string_view line, PgnGame& game)
+{
+   // Format: [Name "Value"]
+   const std::size_t nameEnd = line.find_first_of(" \t", 1);
+   const std::size_t valueStart = line.find('"');
+   const std::size_t valueEnd = line.rfind('"');
+   if (nameEnd == std::string_view::npos || valueStart == std::string_view::npos ||
+       valueEnd <= valueStart)
+   {
+      return;
+   }
+
+   PgnTag tag;
+   tag.name = line.substr(1, nameEnd - 1);
+   // Unescape quotes and backslashes.
+   for (std::size_t idx = valueStart + 1; idx < valueEnd; ++idx)
+   {
+      if (line[idx] == '\\' && idx + 1 < valueEnd)
+         ++idx;
+      tag.value += line[idx];
+   }
+   game.tags.push_back(std::move(tag));
+}
+
+
+void PgnReader::startGame(PgnGame& game)
+{
+   std::optional<FenPosition> start;
+   if (const auto fen = game.tag("FEN"); fen.has_value())
+   {
+      start = readFen(*fen);
+      if (!start.has_value())
+         game.isComplete = false;
+   }
+
+   m_side = start.has_value() ? start->side : Color::White;
+   game.firstSide = m_side;
+   if (game.isComplete)
+      game.positions.push_back(start.has_value() ? start->pos : StartPos);
+}
+
+
+bool PgnReader::readMovetext(std::string_view line, PgnGame& game)
+{
+   std::size_t idx = 0;
+   while (idx < line.size())
+   {
+      if (m_isInComment)
+      {
+         const std::size_t end = line.find('}', idx);
+         if (end == std::string_view::npos)
+            return false;
+         m_isInComment = false;
+         idx = end + 1;
+         continue;
+      }
+
+      const char ch = line[idx];
+      if (isSpace(ch))
+      {
+         ++idx;
+      }
+      else if (ch == '{')
+      {
+         m_isInComment = true;
+         ++idx;
+      }
+      else if (ch == ';')
+      {
+         // Comment to the end of the line.
+         return false;
+      }
+      else if (ch == '(')
+      {
+         ++m_variationDepth;
+         ++idx;
+      }
+      else if (ch == ')')
+      {
+         if (m_variationDepth > 0)
+            --m_variationDepth;
+         ++idx;
+      }
+      else
+      {
+         std::size_t end = idx;
+         while (end < line.size() && !isDelimiter(line[end]))
+            ++end;
+         const std::string_view token = line.substr(idx, end - idx);
+         idx = end;
+
+         if (m_variationDepth > 0)
+            continue;
+         if (isResult(token))
+         {
+            game.result = token;
+            return true;
+         }
+         readToken(token, game);
+      }
+   }
+   return false;
+}
+
+
+void PgnReader::readToken(std::string_view token, PgnGame& game)
+{
+   // Numeric annotation glyph.
+   if (token[0] == '$')
+      return;
+   const std::string_view san = skipMoveNumber(token);
+   if (san.empty() || !game.isComplete)
+      return;
+
+   const Position& pos = game.positions.back();
+   std::optional<Move> move = readSan(san, pos, m_side);
+   if (!move.has_value())
+   {
+      game.isComplete = false;
+      return;
+   }
+
+   game.positions.push_back(pos.makeMove(*move));
+   game.moves.push_back(std::move(*move));
+   m_side = !m_side;
+}
+
+
+///////////////////
+
+std::optional<Move> readSan(std::string_view san, const Position& pos, Color side)
+{
+   // Check and annotation marks do not matter for finding the move.
+   while (!san.empty() && (san.back() == '+' || san.back() == '#' || san.back() == '!' ||
+                           san.back() == '?'))
+   {
+      san.remove_suffix(1);
+   }
+
+   if (san == "O-O" || san == "0-0" || san == "O-O-O" || san == "0-0-0")
+      return readCastling(san, pos, side);
+
+   std::string_view rest = san;
+   std::optional<Figure> promotion;
+   if (!rest.empty())
+   {
+      promotion = sanFigure(rest.back());
+      if (promotion.has_value())
+      {
+         rest.remove_suffix(1);
+         if (!rest.empty() && rest.back() == '=')
+            rest.remove_suffix(1);
+      }
+   }
+
+   if (rest.size() < 2)
+      return std::nullopt;
+   const Square to{rest.substr(rest.size() - 2)};
+   if (!to)
+      return std::nullopt;
+   rest.remove_suffix(2);
+
+   Figure figure = Figure::Pawn;
+   if (!rest.empty())
+   {
+      if (const auto sanFig = sanFigure(rest.front()); sanFig.has_value())
+      {
+         figure = *sanFig;
+         rest.remove_prefix(1);
+      }
+   }
+   if (!rest.empty() && rest.back() == 'x')
+      rest.remove_suffix(1);
+
+   // Disambiguation by departing file, rank or both.
+   char fromFile = 0;
+   char fromRank = 0;
+   for (const char ch : rest)
+   {
+      if (ch >= 'a' && ch <= 'h')
+         fromFile = ch;
+      else if (ch >= '1' && ch <= '8')
+         fromRank = ch;
+      else
+         return std::nullopt;
+   }
+   if (promotion.has_value() && figure != Figure::Pawn)
+      return std::nullopt;
+
+   // Pieces that can make the move. Usually only one.
+   std::array<Piece, SquareList::Capacity> candidates;
+   std::size_t numCandidates = 0;
+   for (const Square from : pos.squares(side, figure))
+   {
+      if ((fromFile && from.file() != fromFile) || (fromRank && from.rank() != fromRank))
+         continue;
+
+      const Piece piece{figure, side, from};
+      if (piece.canMoveTo(to, pos) ||
+          (isEnPassant(piece, to, pos) && isSet(pawnAttacks(side, from), to)))
+      {
+         candidates[numCandidates++] = piece;
+      }
+   }
+
+   const auto makeMove = [&](const Piece& piece) {
+      return promotion.has_value() ? Move{piece, to, *promotion, std::string{san}}
+                                   : Move{piece, to, std::string{san}};
+   };
+
+   // Pinned pieces are not considered when disambiguating.
+   if (numCandidates > 1)
+   {
+      const auto last =
+         std::remove_if(candidates.begin(), candidates.begin() + numCandidates,
+                        [&](const Piece& piece) {
+                           return leavesKingInCheck(makeMove(piece), pos, side);
+                        });
+      numCandidates = static_cast<std::size_t>(last - candidates.begin());
+   }
+
+   if (numCandidates != 1)
+      return std::nullopt;
+   return makeMove(candidates[0]);
+}
@@ -0,0 +1,91 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#pragma once
+#include "move.h"
+#include "piece.h"
+#include "position.h"
+#include <cstddef>
+#include <iosfwd>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+///////////////////
+
+struct PgnTag
+{
+   std::string name;
+   std::string value;
+};
+
+
+// Game read from a PGN file.
+struct PgnGame
+{
+   std::vector<PgnTag> tags;
+   std::vector<Move> moves;
+   // Position before each move and the final position. Holds one more position than
+   // there are moves.
+   std::vector<Position> positions;
+   // Side to move in the first position.
+   Color firstSide = Color::White;
+   std::string result;
+   // False if a move could not be read. The moves and positions hold the game up to
+   // that move.
+   bool isComplete = true;
+
+   std::optional<std::string_view> tag(std::string_view name) const;
+   // Keeps the allocated memory for reuse.
+   void clear();
+};
+
+
+///////////////////
+
+// Reads the games of a PGN archive one at a time, so that the archive never has
+// to be in memory as a whole. Moves are resolved against the game's positions.
+// Variations, comments and annotations are skipped.
+class PgnReader
+{
+ public:
+   explicit PgnReader(std::istream& in);
+   // Reads from memory, e.g. a memory mapped file. The memory has to outlive the
+   // reader.
+   explicit PgnReader(std::string_view buffer);
+
+   // Reads the next game into a given game. Returns false if there are no more
+   // games.
+   bool next(PgnGame& game);
+
+ private:
+   bool nextLine(std::string_view& line);
+   void unreadLine(std::string_view line);
+   void readTag(std::string_view line, PgnGame& game);
+   void startGame(PgnGame& game);
+   // Returns true if the line ends the game.
+   bool readMovetext(std::string_view line, PgnGame& game);
+   void readToken(std::string_view token, PgnGame& game);
+
+ private:
+   std::istream* m_in = nullptr;
+   std::string_view m_buffer;
+   std::size_t m_offset = 0;
+   // Storage for lines read from a stream.
+   std::string m_line;
+   std::optional<std::string_view> m_unreadLine;
+   // State of the game that is read.
+   Color m_side = Color::White;
+   bool m_isInComment = false;
+   std::size_t m_variationDepth = 0;
+};
+
+
+///////////////////
+
+// Resolves a move in standard algebraic notation made by a given side.
+// Returns nothing if no piece or more than one piece can make the move.
+std::optional<Move> readSan(std::string_view san, const Position& pos, Color side);
@@ -3,11 +3,12 @@
 // MIT license
 //
 #include "piece.h"
+#include "attack_tables.h"
 #include "move.h"
 #include "position.h"
+#include "dscpp/SboVector.h"
 #include <algorithm>
 #include <array>
-#include <algorithm>
 #include <cassert>
 #include <iterator>
 #include <stdexcept>
@@ -18,10 +19,14 @@ namespace
 {
 ///////////////////
 
+// Destination squares of one piece. Large enough to never allocate.
+using Squares = ds::SboVector<Square, 32>;
+
+
 // Adds a given square to a collection if the move is possible.
 // Returns whether the destination square was occupied by a piece.
 bool collectSquare(const Piece& piece, Square to, const Position& pos,
-                   std::vector<Square>& squares)
+                   Squares& squares)
 {
    const auto& occupant = pos[to];
    if (!occupant)
@@ -45,16 +50,13 @@ bool collectSquare(const Piece& piece, Square to, const Position& pos,
 
 
 // Adds the reachable squares in a given direction to a collection.
-void collectSquaresInDirection(const Piece& piece, const Position& pos, Offset dir,
-                               std::vector<Square>& squares)
+void collectSquaresInDirection(const Piece& piece, const Position& pos, Direction dir,
+                               Squares& squares)
 {
-   std::optional<Square> to = piece.coord() + dir;
-   while (to.has_value())
+   for (const Square to : ray(piece.coord(), dir))
    {
-      if (collectSquare(piece, *to, pos, squares))
-         to = std::nullopt;
-      else
-         to = to + dir;
+      if (collectSquare(piece, to, pos, squares))
+         break;
    }
 }
 
@@ -63,7 +65,7 @@ void collectSquaresInDirection(const Piece& piece, const Position& pos, Offset d
 template <typename DirectionIter>
 void collectSquaresInDirections(const Piece& piece, const Position& pos,
                                 DirectionIter first, DirectionIter last,
-                                std::vector<Square>& squares)
+                                Squares& squares)
 {
    std::for_each(first, last, [&](const auto& dir) {
       collectSquaresInDirection(piece, pos, dir, squares);
@@ -71,30 +73,46 @@ void collectSquaresInDirections(const Piece& piece, const Position& pos,
 }
 
 
-// Adds the reachable squares for given offsets to a collection.
-template <typename OffsetIter>
-void collectSquares(const Piece& piece, const Position& pos, OffsetIter first,
-                    OffsetIter last, std::vector<Square>& squares)
+// Adds the reachable squares of a given set of target squares to a collection.
+void collectSquares(const Piece& piece, const Position& pos, Bitboard targets,
+                    Squares& squares)
 {
-   std::for_each(first, last, [&](const auto& off) {
-      std::optional<Square> to = piece.coord() + off;
-      if (to.has_value())
-         collectSquare(piece, *to, pos, squares);
-   });
+   forEachSquare(targets, [&](Square to) { collectSquare(piece, to, pos, squares); });
 }
 
 
-// Builds moves from given destination squares.
-std::vector<Move> buildMoves(const Piece& piece, const std::vector<Square>& squares,
-                             const Position& pos)
+// Kinds of moves to generate.
+enum class MoveKind
 {
-   std::vector<Move> moves;
-   moves.reserve(squares.size());
-   std::transform(std::begin(squares), std::end(squares), std::back_inserter(moves),
-                  [&](const auto& to) {
-                     return Move{piece, to, pos};
-                  });
-   return moves;
+   All,
+   Captures,
+   Quiets
+};
+
+
+// Checks if moving to a given square is a move of a given kind.
+bool isMoveKind(MoveKind kind, const Piece& piece, Square to, const Position& pos)
+{
+   switch (kind)
+   {
+   case MoveKind::Captures:
+      return pos.isOccupiedBy(to, !piece.color());
+   case MoveKind::Quiets:
+      return !pos.isOccupiedBy(to, !piece.color());
+   default:
+      return true;
+   }
+}
+
+
+// Adds moves of a given kind for given destination squares to a collection.
+template <typename Moves>
+void buildMoves(const Piece& piece, const Squares& squares, const Position& pos,
+                MoveKind kind, Moves& moves)
+{
+   for (const auto& to : squares)
+      if (isMoveKind(kind, piece, to, pos))
+         moves.push_back(Move{piece, to, pos});
 }
 
 
@@ -109,13 +127,15 @@ bool isCheck(const Position& pos, Square at)
 }
 
 
-// Remove moves that lead into check.
-void removeChecks(const Position& pos, std::vector<Move>& moves)
+// Remove moves that lead into check starting at a given index of a collection.
+template <typename Moves>
+void removeChecks(const Position& pos, Moves& moves, std::size_t first)
 {
-   moves.erase(std::remove_if(moves.begin(), moves.end(),
+   moves.erase(std::remove_if(moves.begin() + first, moves.end(),
                               [&pos](const Move& move) {
                                  // Create the position and test for check.
-                                 return isCheck(pos.makeMove(move), move.to());
+                                 return isCheck(pos.makeUnrecordedMove(move),
+                                                move.to());
                               }),
                moves.end());
 }
@@ -125,22 +145,19 @@ void removeChecks(const Position& pos, std::vector<Move>& moves)
 
 // Returns collection of squares that a given king can move to using its basic
 // movement rule. Does not account for castling.
-std::vector<Square> kingBasicSquares(const Piece& king, const Position& pos)
+Squares kingBasicSquares(const Piece& king, const Position& pos)
 {
    assert(king.figure() == Figure::King);
    assert(pos[king.coord()] == king);
 
-   static const std::array<Offset, 8> Offsets{Offset{1, 1}, {1, 0},  {1, -1}, {0, 1},
-                                              {0, -1},      {-1, 1}, {-1, 0}, {-1, -1}};
-
-   std::vector<Square> to;
-   collectSquares(king, pos, std::begin(Offsets), std::end(Offsets), to);
+   Squares to;
+   collectSquares(king, pos, kingAttacks(king.coord()), to);
    return to;
 }
 
 
 // Returns collection of squares that a given king is threatening.
-std::vector<Square> kingThreatenedSquares(const Piece& king, const Position& pos)
+Squares kingThreatenedSquares(const Piece& king, const Position& pos)
 {
    // Ignore squares that can be reached by castling because castling is not allowed
    // if the target square is occupied.
@@ -148,105 +165,109 @@ std::vector<Square> kingThreatenedSquares(const Piece& king, const Position& pos
 }
 
 
-// Returns collection of moves that a given king can make.
-std::vector<Move> kingMoves(const Piece& king, const Position& pos)
+// Adds the moves that a given king can make to a collection.
+template <typename Moves>
+void kingMoves(const Piece& king, const Position& pos, MoveKind kind, Moves& moves)
 {
-   const std::vector<Square> to = kingBasicSquares(king, pos);
-   std::vector<Move> moves = buildMoves(king, to, pos);
+   const std::size_t first = moves.size();
+   buildMoves(king, kingBasicSquares(king, pos), pos, kind, moves);
    // Special rule - king can not move into check.
-   removeChecks(pos, moves);
-   return moves;
+   removeChecks(pos, moves, first);
 }
 
 
-std::vector<Square> queenSquares(const Piece& queen, const Position& pos)
+Squares queenSquares(const Piece& queen, const Position& pos)
 {
    assert(queen.figure() == Figure::Queen);
    assert(pos[queen.coord()] == queen);
 
-   static const std::array<Offset, 8> Directions{
-      Offset{1, 1}, {1, 0}, {1, -1}, {0, 1}, {0, -1}, {-1, 1}, {-1, 0}, {-1, -1}};
+   static constexpr std::array<Direction, 8> Directions{
+      Direction::North, Direction::NorthEast, Direction::East, Direction::SouthEast,
+      Direction::South, Direction::SouthWest, Direction::West, Direction::NorthWest};
 
-   std::vector<Square> to;
+   Squares to;
    collectSquaresInDirections(queen, pos, begin(Directions), end(Directions), to);
    return to;
 }
 
 
-std::vector<Move> queenMoves(const Piece& queen, const Position& pos)
+template <typename Moves>
+void queenMoves(const Piece& queen, const Position& pos, MoveKind kind, Moves& moves)
 {
-   return buildMoves(queen, queenSquares(queen, pos), pos);
+   buildMoves(queen, queenSquares(queen, pos), pos, kind, moves);
 }
 
 
-std::vector<Square> rookSquares(const Piece& rook, const Position& pos)
+Squares rookSquares(const Piece& rook, const Position& pos)
 {
    assert(rook.figure() == Figure::Rook);
    assert(pos[rook.coord()] == rook);
 
-   static const std::array<Offset, 4> Directions{Offset{1, 0}, {0, 1}, {0, -1}, {-1, 0}};
+   static constexpr std::array<Direction, 4> Directions{
+      Direction::North, Direction::East, Direction::South, Direction::West};
 
-   std::vector<Square> to;
+   Squares to;
    collectSquaresInDirections(rook, pos, begin(Directions), end(Directions), to);
    return to;
 }
 
 
-std::vector<Move> rookMoves(const Piece& rook, const Position& pos)
+template <typename Moves>
+void rookMoves(const Piece& rook, const Position& pos, MoveKind kind, Moves& moves)
 {
-   return buildMoves(rook, rookSquares(rook, pos), pos);
+   buildMoves(rook, rookSquares(rook, pos), pos, kind, moves);
 }
 
 
-std::vector<Square> bishopSquares(const Piece& bishop, const Position& pos)
+Squares bishopSquares(const Piece& bishop, const Position& pos)
 {
    assert(bishop.figure() == Figure::Bishop);
    assert(pos[bishop.coord()] == bishop);
 
-   static const std::array<Offset, 4> Directions{
-      Offset{1, 1}, {-1, 1}, {1, -1}, {-1, -1}};
+   static constexpr std::array<Direction, 4> Directions{
+      Direction::NorthEast, Direction::SouthEast, Direction::SouthWest,
+      Direction::NorthWest};
 
-   std::vector<Square> to;
+   Squares to;
    collectSquaresInDirections(bishop, pos, begin(Directions), end(Directions), to);
    return to;
 }
 
 
-std::vector<Move> bishopMoves(const Piece& bishop, const Position& pos)
+template <typename Moves>
+void bishopMoves(const Piece& bishop, const Position& pos, MoveKind kind, Moves& moves)
 {
-   return buildMoves(bishop, bishopSquares(bishop, pos), pos);
+   buildMoves(bishop, bishopSquares(bishop, pos), pos, kind, moves);
 }
 
 
-std::vector<Square> knightSquares(const Piece& knight, const Position& pos)
+Squares knightSquares(const Piece& knight, const Position& pos)
 {
    assert(knight.figure() == Figure::Knight);
    assert(pos[knight.coord()] == knight);
 
-   static const std::array<Offset, 8> Offsets{Offset{2, 1}, {2, -1}, {-2, 1}, {-2, -1},
-                                              {1, 2},       {-1, 2}, {1, -2}, {-1, -2}};
-
-   std::vector<Square> to;
-   collectSquares(knight, pos, begin(Offsets), end(Offsets), to);
+   Squares to;
+   collectSquares(knight, pos, knightAttacks(knight.coord()), to);
    return to;
 }
 
 
-std::vector<Move> knightMoves(const Piece& knight, const Position& pos)
+template <typename Moves>
+void knightMoves(const Piece& knight, const Position& pos, MoveKind kind, Moves& moves)
 {
-   return buildMoves(knight, knightSquares(knight, pos), pos);
+   buildMoves(knight, knightSquares(knight, pos), pos, kind, moves);
 }
 
 
 // Returns collection of squares that a given pawn can move to using its basic
 // movement rule. Does not include squares reached by capturing diagonally or
 // en passant.
-std::vector<Square> pawnBasicSquares(const Piece& pawn, const Position& pos)
+Squares pawnBasicSquares(const Piece& pawn, const Position& pos)
 {
    assert(pawn.figure() == Figure::Pawn);
    assert(pos[pawn.coord()] == pawn);
 
-   std::vector<Square> squares;
+   Squares squares;
    const Offset dir = pawnDirection(pawn);
 
    // Move one square forward.
@@ -266,30 +287,16 @@ std::vector<Square> pawnBasicSquares(const Piece& pawn, const Position& pos)
 }
 
 
-std::vector<Square> pawnThreatenedSquares(const Piece& pawn, const Position& pos)
+Squares pawnThreatenedSquares(const Piece& pawn, const Position& pos)
 {
    assert(pawn.figure() == Figure::Pawn);
 
-   std::vector<Square> squares;
-   const Offset dir = pawnDirection(pawn);
-
-   // Capture diagonally on lower file.
-   if (const auto to = pawn.coord() + dir + Offset{-1, 0}; to.has_value())
-      // Only if square is not occupied by the same color.
-      if (const auto target = pos[*to];
-          !target.has_value() || pawn.color() != target->color())
-      {
-         squares.push_back(*to);
-      }
-
-   // Capture diagonally on higher file.
-   if (const auto to = pawn.coord() + dir + Offset{1, 0}; to.has_value())
+   Squares squares;
+   forEachSquare(pawnAttacks(pawn.color(), pawn.coord()), [&](Square to) {
       // Only if square is not occupied by the same color.
-      if (const auto target = pos[*to];
-          !target.has_value() || pawn.color() != target->color())
-      {
-         squares.push_back(*to);
-      }
+      if (!pos.isOccupiedBy(to, pawn.color()))
+         squares.push_back(to);
+   });
 
    // todo - capture en passant
 
@@ -297,9 +304,14 @@ std::vector<Square> pawnThreatenedSquares(const Piece& pawn, const Position& pos
 }
 
 
-std::vector<Move> pawnMoves(const Piece& pawn, const Position& pos)
+template <typename Moves>
+void pawnMoves(const Piece& pawn, const Position& pos, MoveKind kind, Moves& moves)
 {
-   auto squares = buildMoves(pawn, pawnBasicSquares(pawn, pos), pos);
+   // Moving forward never captures.
+   if (kind != MoveKind::Captures)
+      buildMoves(pawn, pawnBasicSquares(pawn, pos), pos, MoveKind::All, moves);
+   if (kind == MoveKind::Quiets)
+      return;
 
    // Add squares that pawn can capture on if occupied by opposite piece.
    const auto threatened = pawnThreatenedSquares(pawn, pos);
@@ -308,11 +320,108 @@ std::vector<Move> pawnMoves(const Piece& pawn, const Position& pos)
       if (const auto target = pos[sq];
           target.has_value() && pawn.color() != target->color())
       {
-         squares.push_back(Move{pawn, sq, pos});
+         moves.push_back(Move{pawn, sq, pos});
       }
    }
+}
 
-   return squares;
+
+// Adds the moves of a given kind that a given piece can make to a collection.
+template <typename Moves>
+void pieceMoves(const Piece& piece, const Position& pos, MoveKind kind, Moves& moves)
+{
+   switch (piece.figure())
+   {
+   case Figure::King:
+      return kingMoves(piece, pos, kind, moves);
+   case Figure::Queen:
+      return queenMoves(piece, pos, kind, moves);
+   case Figure::Rook:
+      return rookMoves(piece, pos, kind, moves);
+   case Figure::Bishop:
+      return bishopMoves(piece, pos, kind, moves);
+   case Figure::Knight:
+      return knightMoves(piece, pos, kind, moves);
+   case Figure::Pawn:
+      return pawnMoves(piece, pos, kind, moves);
+   default:
+      assert(false && "Invalid figure");
+      return;
+   }
+}
+
+
+// Returns the moves of a given kind that a given piece can make.
+std::vector<Move> pieceMoves(const Piece& piece, const Position& pos, MoveKind kind)
+{
+   std::vector<Move> moves;
+   pieceMoves(piece, pos, kind, moves);
+   return moves;
+}
+
+
+///////////////////
+
+// Checks if all squares strictly between two squares are empty.
+bool isBetweenEmpty(Square from, Square to, const Position& pos)
+{
+   Bitboard squares = between(from, to);
+   while (squares != EmptyBB)
+      if (pos[popLsb(squares)].has_value())
+         return false;
+   return true;
+}
+
+
+// Checks if a sliding piece can move from one square to another along a rank or
+// file (straight) or a diagonal.
+bool canSlideTo(Square from, Square to, const Position& pos, bool straight,
+                bool diagonal)
+{
+   if (line(from, to) == EmptyBB)
+      return false;
+
+   const bool isStraight = from.fileIndex() == to.fileIndex() ||
+                           from.rankIndex() == to.rankIndex();
+   if (isStraight ? !straight : !diagonal)
+      return false;
+
+   return isBetweenEmpty(from, to, pos);
+}
+
+
+bool kingCanMoveTo(const Piece& king, Square to, const Position& pos)
+{
+   if (!isSet(kingAttacks(king.coord()), to))
+      return false;
+   // Special rule - king can not move into check.
+   return !isCheck(pos.makeUnrecordedMove(Move{king, to, pos}), to);
+}
+
+
+bool knightCanMoveTo(const Piece& knight, Square to)
+{
+   return isSet(knightAttacks(knight.coord()), to);
+}
+
+
+bool pawnCanMoveTo(const Piece& pawn, Square to, const Position& pos)
+{
+   const int df = to.file() - pawn.coord().file();
+   const int dr = to.rank() - pawn.coord().rank();
+   const int dir = pawnDirection(pawn).dr();
+
+   // Capture diagonally.
+   if (isSet(pawnAttacks(pawn.color(), pawn.coord()), to))
+      return pos.isOccupiedBy(to, !pawn.color());
+   if (df != 0 || pos[to].has_value())
+      return false;
+   // Move one square forward.
+   if (dr == dir)
+      return true;
+   // Move two squares forward from starting square.
+   return dr == 2 * dir && isPawnOnInitialRank(pawn) &&
+          isBetweenEmpty(pawn.coord(), to, pos);
 }
 
 } // namespace
@@ -348,46 +457,89 @@ Piece::Piece(std::string_view notation, Color side)
 
 std::vector<Square> Piece::threatenedSquares(const Position& pos) const
 {
+   Squares squares;
    switch (m_figure)
    {
    case Figure::King:
-      return kingThreatenedSquares(*this, pos);
+      squares = kingThreatenedSquares(*this, pos);
+      break;
    case Figure::Queen:
-      return queenSquares(*this, pos);
+      squares = queenSquares(*this, pos);
+      break;
    case Figure::Rook:
-      return rookSquares(*this, pos);
+      squares = rookSquares(*this, pos);
+      break;
    case Figure::Bishop:
-      return bishopSquares(*this, pos);
+      squares = bishopSquares(*this, pos);
+      break;
    case Figure::Knight:
-      return knightSquares(*this, pos);
+      squares = knightSquares(*this, pos);
+      break;
    case Figure::Pawn:
-      return pawnThreatenedSquares(*this, pos);
+      squares = pawnThreatenedSquares(*this, pos);
+      break;
    default:
       assert(false && "Invalid figure");
-      return {};
+      break;
    }
+   return {squares.begin(), squares.end()};
 }
 
 
 std::vector<Move> Piece::nextMoves(const Position& pos) const
 {
+   return pieceMoves(*this, pos, MoveKind::All);
+}
+
+
+std::vector<Move> Piece::nextCaptures(const Position& pos) const
+{
+   return pieceMoves(*this, pos, MoveKind::Captures);
+}
+
+
+std::vector<Move> Piece::nextQuietMoves(const Position& pos) const
+{
+   return pieceMoves(*this, pos, MoveKind::Quiets);
+}
+
+
+void Piece::nextCaptures(const Position& pos, MoveList& moves) const
+{
+   pieceMoves(*this, pos, MoveKind::Captures, moves);
+}
+
+
+void Piece::nextQuietMoves(const Position& pos, MoveList& moves) const
+{
+   pieceMoves(*this, pos, MoveKind::Quiets, moves);
+}
+
+
+bool Piece::canMoveTo(Square to, const Position& pos) const
+{
+   assert(pos[m_coord] == *this);
+
+   if (!to || to == m_coord || pos.isOccupiedBy(to, m_color))
+      return false;
+
    switch (m_figure)
    {
    case Figure::King:
-      return kingMoves(*this, pos);
+      return kingCanMoveTo(*this, to, pos);
    case Figure::Queen:
-      return queenMoves(*this, pos);
+      return canSlideTo(m_coord, to, pos, true, true);
    case Figure::Rook:
-      return rookMoves(*this, pos);
+      return canSlideTo(m_coord, to, pos, true, false);
    case Figure::Bishop:
-      return bishopMoves(*this, pos);
+      return canSlideTo(m_coord, to, pos, false, true);
    case Figure::Knight:
-      return knightMoves(*this, pos);
+      return knightCanMoveTo(*this, to);
    case Figure::Pawn:
-      return pawnMoves(*this, pos);
+      return pawnCanMoveTo(*this, to, pos);
    default:
       assert(false && "Invalid figure");
-      return {};
+      return false;
    }
 }
 
@@ -4,6 +4,8 @@
 //
 #pragma once
 #include "square.h"
+#include <cstddef>
+#include <memory_resource>
 #include <optional>
 #include <string>
 #include <vector>
@@ -11,6 +13,9 @@
 class Move;
 class Position;
 
+// Move collection that allocates from a custom memory resource.
+using MoveList = std::pmr::vector<Move>;
+
 
 ///////////////////
 
@@ -20,6 +25,8 @@ enum class Color
    Black
 };
 
+inline constexpr std::size_t NumColors = 2;
+
 inline Color operator!(Color c)
 {
    return c == Color::White ? Color::Black : Color::White;
@@ -71,6 +78,8 @@ enum class Figure
    Pawn
 };
 
+inline constexpr std::size_t NumFigures = 6;
+
 inline std::string notateFigure(Figure f)
 {
    switch (f)
@@ -139,6 +148,15 @@ class Piece
    // is not the same as the squares that pawns can move to.
    std::vector<Square> threatenedSquares(const Position& pos) const;
    std::vector<Move> nextMoves(const Position& pos) const;
+   // Subsets of the next moves. Allow generating moves in stages.
+   std::vector<Move> nextCaptures(const Position& pos) const;
+   std::vector<Move> nextQuietMoves(const Position& pos) const;
+   // Append to a given list, so that callers control where the moves are allocated.
+   void nextCaptures(const Position& pos, MoveList& moves) const;
+   void nextQuietMoves(const Position& pos, MoveList& moves) const;
+   // Checks whether the piece can move to a given square without generating all its
+   // moves. Applies the same rules as nextMoves.
+   bool canMoveTo(Square to, const Position& pos) const;
    std::vector<Position> nextPositions(const Position& pos) const;
 
    bool operator==(const Piece& other) const;
@@ -3,14 +3,10 @@
 // MIT license
 //
 #include "position.h"
+#include "attack_tables.h"
 #include "move.h"
-#include "essentutils/rand_util.h"
-#include "essentutils/string_util.h"
 #include <algorithm>
-#include <iterator>
-#include <map>
-#include <numeric>
-#include <sstream>
+#include <cassert>
 
 
 ///////////////////
@@ -21,75 +17,108 @@ const Position StartPos{"Rba8 Nbb8 Bbc8 Qbd8 Kbe8 Bbf8 Nbg8 Rbh8 "
                         "Rwa1 Nwb1 Bwc1 Qwd1 Kwe1 Bwf1 Nwg1 Rwh1"};
 
 static constexpr char PieceDelimCh = ' ';
-static constexpr char PieceDelim[] = {PieceDelimCh};
 
-static constexpr unsigned char OccuppiedField = 1;
-static constexpr unsigned char EmptyField = 0;
+static constexpr std::uint8_t EmptyField = 0;
 
-static std::size_t BoardIndex(const Square& coord)
+// Codes pieces as consecutive numbers starting at one.
+static std::uint8_t pieceCode(Color side, Figure figure)
 {
-   return (coord.file() - 'a') * 8 + (coord.rank() - '1');
+   return static_cast<std::uint8_t>(1 + static_cast<std::size_t>(side) * NumFigures +
+                                    static_cast<std::size_t>(figure));
 }
 
-
-///////////////////
-
-Position::Position(const std::vector<Piece>& pieces)
-: m_pieces{pieces.begin(), pieces.end()}, m_record{notate()}, m_score{calcScore()}
+static Piece makePiece(std::uint8_t code, Square coord)
 {
-   populateBoard();
+   assert(code != EmptyField);
+   const std::size_t idx = code - 1u;
+   return Piece{static_cast<Figure>(idx % NumFigures),
+                static_cast<Color>(idx / NumFigures), coord};
 }
 
 
-Position::Position(ds::SboVector<Piece, 32>&& pieces, Record&& record)
-: m_pieces{std::move(pieces)}, m_record{std::move(record)}, m_score{calcScore()}
+///////////////////
+
+Position::Position(const std::vector<Piece>& pieces)
 {
-   populateBoard();
+   for (const auto& piece : pieces)
+      addPiece(piece);
+   m_record = Record{m_hash};
+   m_score = calcScore();
 }
 
 
-Position::Position(std::string_view notation) : m_record{std::string{notation}}
+Position::Position(std::string_view notation)
 {
-   const std::vector<std::string> pieceNotations =
-      esl::split(std::string{notation}, PieceDelim);
-
-   m_pieces.reserve(pieceNotations.size());
-   std::transform(begin(pieceNotations), end(pieceNotations),
-                  std::back_inserter(m_pieces),
-                  [](const std::string& pieceNotation) { return Piece(pieceNotation); });
+   // Read the pieces in place without splitting the notation into strings.
+   std::size_t start = 0;
+   while (start < notation.size())
+   {
+      std::size_t end = notation.find(PieceDelimCh, start);
+      if (end == std::string_view::npos)
+         end = notation.size();
+      if (end > start)
+         addPiece(Piece(notation.substr(start, end - start)));
+      start = end + 1;
+   }
 
-   populateBoard();
+   m_record = Record{m_hash};
    m_score = calcScore();
 }
 
 
 bool Position::isOccupiedBy(Square coord, Color side) const
 {
-   const auto it = at(coord);
-   return it != m_pieces.end() && it->color() == side;
+   return isSet(m_occupied[colorIdx(side)], coord);
 }
 
 
 bool Position::isThreatenedBy(Square coord, Color side) const
 {
-   for (const auto& piece : m_pieces)
-   {
-      if (piece.color() == side)
-      {
-         const auto threatened = piece.threatenedSquares(*this);
-         if (std::find(threatened.begin(), threatened.end(), coord) != threatened.end())
-            return true;
-      }
-   }
+   // Pieces do not threaten squares occupied by their own color.
+   if (isOccupiedBy(coord, side))
+      return false;
 
-   return false;
+   // Look from the threatened square back to the threatening pieces.
+   const Bitboard occupiedSquares = occupied();
+   const auto isAttackedFrom = [&](Figure figure, auto isAttacking) {
+      const SquareList& from = squares(side, figure);
+      return std::any_of(from.begin(), from.end(), isAttacking);
+   };
+   const auto canSlide = [&](Square from, bool straight) {
+      const bool isStraight = from.fileIndex() == coord.fileIndex() ||
+                              from.rankIndex() == coord.rankIndex();
+      return line(from, coord) != EmptyBB && isStraight == straight &&
+             (between(from, coord) & occupiedSquares) == EmptyBB;
+   };
+
+   const auto isPawnAttack = [&](Square from) {
+      return isSet(pawnAttacks(side, from), coord);
+   };
+   const auto isKnightAttack = [&](Square from) {
+      return isSet(knightAttacks(from), coord);
+   };
+   const auto isKingAttack = [&](Square from) { return isSet(kingAttacks(from), coord); };
+   const auto isRookAttack = [&](Square from) { return canSlide(from, true); };
+   const auto isBishopAttack = [&](Square from) { return canSlide(from, false); };
+   const auto isQueenAttack = [&](Square from) {
+      return canSlide(from, true) || canSlide(from, false);
+   };
+
+   return isAttackedFrom(Figure::Pawn, isPawnAttack) ||
+          isAttackedFrom(Figure::Knight, isKnightAttack) ||
+          isAttackedFrom(Figure::King, isKingAttack) ||
+          isAttackedFrom(Figure::Rook, isRookAttack) ||
+          isAttackedFrom(Figure::Bishop, isBishopAttack) ||
+          isAttackedFrom(Figure::Queen, isQueenAttack);
 }
 
 
 std::optional<Piece> Position::operator[](Square coord) const
 {
-   if (const auto it = at(coord); it != m_pieces.end())
-      return *it;
+   if (!coord)
+      return std::nullopt;
+   if (const std::uint8_t code = m_board[coord.index()]; code != EmptyField)
+      return makePiece(code, coord);
    return std::nullopt;
 }
 
@@ -97,106 +126,194 @@ std::optional<Piece> Position::operator[](Square coord) const
 std::vector<Piece> Position::pieces(Color side) const
 {
    std::vector<Piece> result;
-   result.reserve(m_pieces.size());
-   std::copy_if(m_pieces.begin(), m_pieces.end(), std::back_inserter(result),
-                [side](const auto& piece) { return piece.color() == side; });
+   forEachPiece(*this, side, [&result](const Piece& piece) { result.push_back(piece); });
    return result;
 }
 
 
 std::string Position::notate() const
 {
-   std::stringstream notation;
-   std::transform(m_pieces.begin(), m_pieces.end(),
-                  std::ostream_iterator<std::string>(notation, PieceDelim),
-                  [](const auto& piece) { return piece.notate(Piece::Notation::FCL); });
-   return esl::trimRight(notation.str(), PieceDelimCh);
+   std::string notation;
+   for (const Color side : {Color::White, Color::Black})
+   {
+      forEachPiece(*this, side, [&notation](const Piece& piece) {
+         if (!notation.empty())
+            notation += PieceDelimCh;
+         notation += piece.notate(Piece::Notation::FCL);
+      });
+   }
+   return notation;
 }
 
 
-Position Position::makeMove(const Move& move) const
+std::string Position::initialPosition() const
 {
-   const Piece movingPiece = move.piece();
-   const Square to = move.to();
-
-   ds::SboVector<Piece, 32> movedPieces;
-   movedPieces.reserve(m_pieces.size());
-   std::copy_if(std::begin(m_pieces), std::end(m_pieces), std::back_inserter(movedPieces),
-                [&movingPiece, &to](const Piece& elem) {
-                   // Skip moving piece and piece at moved-to coordinate.
-                   return elem != movingPiece && elem.coord() != to;
-                });
-   movedPieces.push_back(move.movedPiece());
+   // Without a recorded notation no moves were made yet.
+   return m_record.hasInitialPosition() ? m_record.initialPosition() : notate();
+}
 
-   Record movedRecord = m_record;
-   movedRecord.add(move.notate());
 
-   return Position{std::move(movedPieces), std::move(movedRecord)};
+Position Position::makeMove(const Move& move) const
+{
+   Position next{*this};
+   // Notate the initial position only once the game moves away from it. Keeps
+   // constructing positions cheap.
+   if (!m_record.hasInitialPosition())
+      next.m_record = Record{notate(), m_hash};
+
+   next.applyMove(move);
+   // Shares the history with this position.
+   next.m_record.add(move.notate(), next.m_hash);
+   return next;
 }
 
 
-void Position::populateBoard()
+Position Position::makeUnrecordedMove(const Move& move) const
 {
-   memset(m_board.data(), EmptyField, m_board.size());
+   Position next = unrecordedCopy();
+   next.applyMove(move);
+   next.m_record = Record{next.m_hash};
+   return next;
+}
 
-   for (const auto& piece : m_pieces)
-      m_board[BoardIndex(piece.coord())] = OccuppiedField;
+
+Position Position::unrecordedCopy() const
+{
+   Position copy;
+   copy.m_squares = m_squares;
+   copy.m_board = m_board;
+   copy.m_listIdx = m_listIdx;
+   copy.m_occupied = m_occupied;
+   copy.m_hash = m_hash;
+   copy.m_reversiblePlies = m_reversiblePlies;
+   copy.m_score = m_score;
+   return copy;
 }
 
 
-Position::Iter Position::at(Square coord)
+void Position::applyMove(const Move& move)
 {
-   if (m_board[BoardIndex(coord)] == OccuppiedField)
+   const Square from = move.from();
+   const Square to = move.to();
+   const bool isPassing = isEnPassant(move.piece(), to, *this);
+   const bool isIrreversible =
+      (*this)[to].has_value() || move.piece().figure() == Figure::Pawn;
+   if ((*this)[to].has_value())
+      removePiece(to);
+   // The pawn captured en passant stands next to the capturing pawn.
+   if (isPassing)
+      removePiece(Square{to.file(), from.rank()});
+
+   if ((*this)[from] == move.piece() && !move.promotion().has_value())
    {
-      return std::find_if(
-         std::begin(m_pieces), std::end(m_pieces),
-         [&coord](const Piece& piece) { return piece.coord() == coord; });
+      movePiece(from, to);
    }
-   return std::end(m_pieces);
+   else
+   {
+      if ((*this)[from].has_value())
+         removePiece(from);
+      addPiece(move.movedPiece());
+   }
+
+   // Castling also moves the rook to the square that the king passed.
+   if (isCastling(move.piece(), to))
+   {
+      const bool isKingside = to.fileIndex() > from.fileIndex();
+      const Square rookFrom{isKingside ? 'h' : 'a', from.rank()};
+      const Square rookTo{isKingside ? 'f' : 'd', from.rank()};
+      if ((*this)[rookFrom] == Piece{Figure::Rook, move.piece().color(), rookFrom} &&
+          !(*this)[rookTo].has_value())
+      {
+         movePiece(rookFrom, rookTo);
+      }
+   }
+
+   m_reversiblePlies =
+      isIrreversible ? 0 : static_cast<std::uint16_t>(m_reversiblePlies + 1);
+   m_score = calcScore();
 }
 
 
-Position::Citer Position::at(Square coord) const
+std::vector<HashKey> Position::reversibleHistory() const
 {
-   if (m_board[BoardIndex(coord)] == OccuppiedField)
-   {
-      return std::find_if(
-         std::begin(m_pieces), std::end(m_pieces),
-         [&coord](const Piece& piece) { return piece.coord() == coord; });
-   }
-   return std::end(m_pieces);
+   return m_record.recentKeys(m_reversiblePlies + 1u);
 }
 
 
-float Position::calcScore() const
+void Position::addPiece(const Piece& piece)
 {
-   return calcValue(pieces(Color::White)) - calcValue(pieces(Color::Black));
+   const Square coord = piece.coord();
+   if (!coord)
+      return;
+   if (m_board[coord.index()] != EmptyField)
+      removePiece(coord);
+
+   SquareList& list = squareList(piece.color(), piece.figure());
+   m_listIdx[coord.index()] = static_cast<std::uint8_t>(list.add(coord));
+   m_board[coord.index()] = pieceCode(piece.color(), piece.figure());
+   m_occupied[colorIdx(piece.color())] |= bit(coord);
+   m_hash ^= pieceKey(piece.color(), piece.figure(), coord);
 }
 
 
-float Position::calcValue(const std::vector<Piece>& pieces) const
+void Position::removePiece(Square coord)
 {
-   static std::map<Figure, float> PieceValues = {
-      {Figure::Pawn, 1.f}, {Figure::Knight, 3.f}, {Figure::Bishop, 3.f},
-      {Figure::Rook, 5.f}, {Figure::Queen, 9.f},  {Figure::King, 100.f}};
+   const auto piece = (*this)[coord];
+   assert(piece.has_value());
+
+   SquareList& list = squareList(piece->color(), piece->figure());
+   const std::uint8_t idx = m_listIdx[coord.index()];
+   // The piece that fills the gap gets the index of the removed piece.
+   if (const auto moved = list.remove(idx); moved.has_value())
+      m_listIdx[moved->index()] = idx;
+
+   m_board[coord.index()] = EmptyField;
+   m_occupied[colorIdx(piece->color())] &= ~bit(coord);
+   m_hash ^= pieceKey(piece->color(), piece->figure(), coord);
+}
+
 
-   return std::accumulate(begin(pieces), end(pieces), 0.f,
-                          [](const float& currValue, const Piece& piece) {
-                             return currValue + PieceValues[piece.figure()];
-                          });
+void Position::movePiece(Square from, Square to)
+{
+   const auto piece = (*this)[from];
+   assert(piece.has_value());
+   assert(m_board[to.index()] == EmptyField);
+
+   // Keep the index of the piece in its list stable.
+   const std::uint8_t idx = m_listIdx[from.index()];
+   squareList(piece->color(), piece->figure()).set(idx, to);
+   m_listIdx[to.index()] = idx;
+
+   m_board[to.index()] = m_board[from.index()];
+   m_board[from.index()] = EmptyField;
+   m_occupied[colorIdx(piece->color())] ^= bit(from) | bit(to);
+   m_hash ^= pieceKey(piece->color(), piece->figure(), from) ^
+             pieceKey(piece->color(), piece->figure(), to);
 }
 
 
-///////////////////
+float Position::calcScore() const
+{
+   return calcValue(Color::White) - calcValue(Color::Black);
+}
 
-bool operator==(const Position& a, const Position& b)
+
+float Position::calcValue(Color side) const
 {
-   if (a.m_pieces.size() != b.m_pieces.size())
-      return false;
+   // Indexed by figure.
+   static constexpr std::array<float, NumFigures> PieceValues = {100.f, 9.f, 5.f,
+                                                                 3.f,   3.f, 1.f};
+
+   float value = 0.f;
+   for (std::size_t f = 0; f < NumFigures; ++f)
+      value += PieceValues[f] * static_cast<float>(m_squares[colorIdx(side)][f].size());
+   return value;
+}
+
 
-   for (const Piece& piece : a.m_pieces)
-      if (std::find(b.m_pieces.begin(), b.m_pieces.end(), piece) == b.m_pieces.end())
-         return false;
+///////////////////
 
-   return true;
+bool operator==(const Position& a, const Position& b)
+{
+   return a.m_board == b.m_board;
 }
@@ -3,53 +3,151 @@
 // MIT license
 //
 #pragma once
+#include "bitboard.h"
 #include "piece.h"
 #include "record.h"
-#include "dscpp/SboVector.h"
+#include "zobrist.h"
 #include <array>
+#include <cstdint>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
+struct FenPosition;
+struct PackedPosition;
+
+
+///////////////////
+
+// Squares of the pieces with the same figure and color. Stored contiguously, so
+// that iterating over them needs no copying or filtering.
+class SquareList
+{
+ public:
+   // Enough for all pieces of one figure including promoted pawns.
+   static constexpr std::size_t Capacity = 10;
+   using const_iterator = const Square*;
+
+   std::size_t size() const { return m_size; }
+   bool empty() const { return m_size == 0; }
+   const_iterator begin() const { return m_squares.data(); }
+   const_iterator end() const { return m_squares.data() + m_size; }
+   Square operator[](std::size_t idx) const { return m_squares[idx]; }
+
+   // Returns the index of the added square.
+   std::size_t add(Square sq);
+   void set(std::size_t idx, Square sq) { m_squares[idx] = sq; }
+   // Fills the gap with the last square. Returns the square that was moved into the
+   // gap, if any.
+   std::optional<Square> remove(std::size_t idx);
+
+ private:
+   std::array<Square, Capacity> m_squares;
+   std::uint8_t m_size = 0;
+};
+
+
+inline std::size_t SquareList::add(Square sq)
+{
+   assert(m_size < Capacity);
+   m_squares[m_size] = sq;
+   return m_size++;
+}
+
+
+inline std::optional<Square> SquareList::remove(std::size_t idx)
+{
+   assert(idx < m_size);
+   --m_size;
+   if (idx == m_size)
+      return std::nullopt;
+   m_squares[idx] = m_squares[m_size];
+   return m_squares[idx];
+}
+
 
 ///////////////////
 
 class Position
 {
    friend bool operator==(const Position&, const Position&);
+   friend std::optional<FenPosition> readFen(std::string_view fen);
+   friend FenPosition unpack(const PackedPosition& packed);
 
  public:
    Position() = default;
    explicit Position(const std::vector<Piece>& pieces);
-   explicit Position(ds::SboVector<Piece, 32>&& pieces, Record&& record);
    explicit Position(std::string_view notation);
 
    float score() const { return m_score; }
+   // Zobrist key of the pieces. Does not include the side to move because positions
+   // do not know which side moves next.
+   HashKey hash() const { return m_hash; }
+   // Number of plies since the last capture or pawn move.
+   std::size_t reversiblePlies() const { return m_reversiblePlies; }
    bool isOccupiedBy(Square coord, Color side) const;
    bool isThreatenedBy(Square coord, Color side) const;
    std::optional<Piece> operator[](Square coord) const;
    std::vector<Piece> pieces(Color side) const;
+   // Squares of the pieces with a given figure and color.
+   const SquareList& squares(Color side, Figure figure) const;
+   Bitboard occupied() const { return m_occupied[0] | m_occupied[1]; }
+   Bitboard occupied(Color side) const { return m_occupied[colorIdx(side)]; }
    Position makeMove(const Move& move) const;
+   // Makes a move without recording it, so that searches and legality checks make
+   // moves without allocating memory. The position after the move does not know the
+   // moves before it and notates itself as its initial position.
+   Position makeUnrecordedMove(const Move& move) const;
    std::string notate() const;
-   std::string initialPosition() const { return m_record.initialPosition(); }
+   std::string initialPosition() const;
    std::string recordedMoves() const { return m_record.moves(); }
+   // Hash keys of the positions since the last irreversible move, oldest first.
+   // Includes the key of this position.
+   std::vector<HashKey> reversibleHistory() const;
+
  private:
-   using Iter = ds::SboVector<Piece, 32>::iterator;
-   using Citer = ds::SboVector<Piece, 32>::const_iterator;
+   static std::size_t colorIdx(Color side) { return static_cast<std::size_t>(side); }
+   static std::size_t figureIdx(Figure f) { return static_cast<std::size_t>(f); }
 
-   void populateBoard();
-   Iter at(Square coord);
-   Citer at(Square coord) const;
+   // Copy that does not share the record of this position.
+   Position unrecordedCopy() const;
+   // Updates the pieces, key and score. Does not record the move.
+   void applyMove(const Move& move);
+   void addPiece(const Piece& piece);
+   void removePiece(Square coord);
+   void movePiece(Square from, Square to);
+   SquareList& squareList(Color side, Figure figure);
    float calcScore() const;
-   float calcValue(const std::vector<Piece>& pieces) const;
+   float calcValue(Color side) const;
 
  private:
-   ds::SboVector<Piece, 32> m_pieces;
-   std::array<unsigned char, 64> m_board;
+   // Piece squares per color and figure.
+   std::array<std::array<SquareList, NumFigures>, NumColors> m_squares;
+   // Piece code for each square. Zero if empty.
+   std::array<std::uint8_t, Square::NumSquares> m_board{};
+   // Index of each piece in its square list.
+   std::array<std::uint8_t, Square::NumSquares> m_listIdx{};
+   std::array<Bitboard, NumColors> m_occupied{};
    Record m_record;
+   HashKey m_hash = 0;
+   std::uint16_t m_reversiblePlies = 0;
    float m_score = 0.f;
 };
 
 
+inline const SquareList& Position::squares(Color side, Figure figure) const
+{
+   return m_squares[colorIdx(side)][figureIdx(figure)];
+}
+
+
+inline SquareList& Position::squareList(Color side, Figure figure)
+{
+   return m_squares[colorIdx(side)][figureIdx(figure)];
+}
+
+
 ///////////////////
 
 bool operator==(const Position& a, const Position& b);
@@ -65,4 +163,17 @@ inline bool operator<(const Position& a, const Position& b)
 }
 
 
-extern const Position StartPos;
\ No newline at end of file
+// Calls a function for each piece of a given side. Visits the pieces ordered by
+// figure.
+template <typename Fn> void forEachPiece(const Position& pos, Color side, Fn fn)
+{
+   for (std::size_t f = 0; f < NumFigures; ++f)
+   {
+      const Figure figure = static_cast<Figure>(f);
+      for (const Square sq : pos.squares(side, figure))
+         fn(Piece{figure, side, sq});
+   }
+}
+
+
+extern const Position StartPos;
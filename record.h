@@ -3,36 +3,107 @@
 // MIT license
 //
 #pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
 
 ///////////////////
 
+// History of a game. Records share their common history, so copying a record and
+// adding a move takes constant time regardless of the length of the game.
 class Record
 {
  public:
    Record() = default;
-   explicit Record(std::string pos);
+   // Record without a notation for the initial position.
+   explicit Record(std::uint64_t key);
+   Record(std::string pos, std::uint64_t key);
 
-   const std::string& initialPosition() const { return m_initialPos; }
-   const std::string& moves() const { return m_moves; }
-   void add(const std::string& move);
+   bool hasInitialPosition() const { return m_initialPos != nullptr; }
+   std::string initialPosition() const;
+   // Space separated moves in the order they were made.
+   std::string moves() const;
+   std::size_t size() const { return m_size; }
+   // Hash keys of up to a given number of the most recent positions, oldest first.
+   // The last key is the key of the current position.
+   std::vector<std::uint64_t> recentKeys(std::size_t count) const;
+   // Adds a move and the key of the position that the move leads to.
+   void add(std::string move, std::uint64_t key);
 
  private:
-   std::string m_initialPos;
-   std::string m_moves;
+   // Node in a chain of moves that links back to the first move.
+   struct Entry
+   {
+      std::shared_ptr<const Entry> prev;
+      std::string move;
+      std::uint64_t key = 0;
+   };
+
+ private:
+   std::shared_ptr<const std::string> m_initialPos;
+   std::shared_ptr<const Entry> m_last;
+   std::size_t m_size = 0;
+   std::uint64_t m_initialKey = 0;
 };
 
 
-inline Record::Record(std::string pos) : m_initialPos{std::move(pos)}
+inline Record::Record(std::uint64_t key) : m_initialKey{key}
+{
+}
+
+
+inline Record::Record(std::string pos, std::uint64_t key)
+: m_initialPos{std::make_shared<const std::string>(std::move(pos))}, m_initialKey{key}
 {
 }
 
 
-inline void Record::add(const std::string& move)
+inline std::string Record::initialPosition() const
 {
-   if (!m_moves.empty())
-      m_moves += " ";
-   m_moves += move;
-}
\ No newline at end of file
+   return m_initialPos ? *m_initialPos : std::string{};
+}
+
+
+inline std::string Record::moves() const
+{
+   // Walk the chain backwards and join the moves in reverse.
+   std::vector<const std::string*> chain;
+   chain.reserve(m_size);
+   for (const Entry* entry = m_last.get(); entry; entry = entry->prev.get())
+      chain.push_back(&entry->move);
+
+   std::string joined;
+   for (auto it = chain.rbegin(); it != chain.rend(); ++it)
+   {
+      if (!joined.empty())
+         joined += " ";
+      joined += **it;
+   }
+   return joined;
+}
+
+
+inline std::vector<std::uint64_t> Record::recentKeys(std::size_t count) const
+{
+   std::vector<std::uint64_t> keys;
+   keys.reserve(std::min(count, m_size + 1));
+   const Entry* entry = m_last.get();
+   for (; entry && keys.size() < count; entry = entry->prev.get())
+      keys.push_back(entry->key);
+   if (!entry && keys.size() < count)
+      keys.push_back(m_initialKey);
+
+   std::reverse(keys.begin(), keys.end());
+   return keys;
+}
+
+
+inline void Record::add(std::string move, std::uint64_t key)
+{
+   m_last = std::make_shared<const Entry>(Entry{std::move(m_last), std::move(move), key});
+   ++m_size;
+}
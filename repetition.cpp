@@ -0,0 +1,43 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "repetition.h"
+#include <algorithm>
+
+
+///////////////////
+
+RepetitionHistory::RepetitionHistory(const std::vector<HashKey>& gameKeys)
+{
+   const std::size_t numKeys = std::min(gameKeys.size(), FiftyMovePlies + 1);
+   for (auto it = gameKeys.end() - numKeys; it != gameKeys.end(); ++it)
+      m_keys.push(*it);
+}
+
+
+bool RepetitionHistory::isRepetition(std::size_t reversiblePlies,
+                                     std::size_t searchPlies) const
+{
+   const std::size_t numKeys = m_keys.size();
+   if (numKeys == 0)
+      return false;
+
+   const std::size_t newest = numKeys - 1;
+   const HashKey key = m_keys[newest];
+   // Older positions can not repeat because an irreversible move was made since.
+   const std::size_t window = std::min(reversiblePlies, newest);
+
+   std::size_t gameRepetitions = 0;
+   // Only look at positions with the same side to move.
+   for (std::size_t distance = 2; distance <= window; distance += 2)
+   {
+      if (m_keys[newest - distance] != key)
+         continue;
+      if (distance <= searchPlies)
+         return true;
+      if (++gameRepetitions == 2)
+         return true;
+   }
+   return false;
+}
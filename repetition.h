@@ -0,0 +1,64 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#pragma once
+#include "zobrist.h"
+#include "dscpp/RingBuffer.h"
+#include <cstddef>
+#include <vector>
+
+
+///////////////////
+
+// Hash keys of the positions on the path to the current position of a search.
+// Detects positions that repeat earlier positions since the last irreversible
+// move.
+class RepetitionHistory
+{
+ public:
+   // Number of plies after which the fifty-move rule ends the game.
+   static constexpr std::size_t FiftyMovePlies = 100;
+   // Holds the game positions of the longest window of reversible moves and the
+   // positions of the deepest search line on top. Pushing more keys overwrites the
+   // oldest keys, which popping does not bring back.
+   static constexpr std::size_t Capacity = 256;
+
+   RepetitionHistory() = default;
+   // Starts with the positions of a game, oldest first. Keeps the newest positions
+   // that the fifty-move rule lets repeat.
+   explicit RepetitionHistory(const std::vector<HashKey>& gameKeys);
+
+   void push(HashKey key) { m_keys.push(key); }
+   void pop() { m_keys.pop(); }
+   std::size_t size() const { return m_keys.size(); }
+
+   // Checks if the newest position is a draw by repetition. Repeating a position
+   // within the search counts. Positions before the search start need to occur
+   // twice before, so that the game is an actual threefold repetition.
+   // Takes the number of reversible plies that led to the newest position and the
+   // number of plies since the search started.
+   bool isRepetition(std::size_t reversiblePlies, std::size_t searchPlies) const;
+
+ private:
+   ds::RingBuffer<HashKey, Capacity> m_keys;
+};
+
+
+///////////////////
+
+// Pushes a key when constructed and pops it when going out of scope.
+class RepetitionScope
+{
+ public:
+   RepetitionScope(RepetitionHistory& history, HashKey key) : m_history{history}
+   {
+      m_history.push(key);
+   }
+   ~RepetitionScope() { m_history.pop(); }
+   RepetitionScope(const RepetitionScope&) = delete;
+   RepetitionScope& operator=(const RepetitionScope&) = delete;
+
+ private:
+   RepetitionHistory& m_history;
+};
@@ -3,20 +3,24 @@
 // MIT license
 //
 #pragma once
+#include <array>
 #include <cassert>
+#include <cstddef>
+#include <cstdint>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <utility>
 
 
 ///////////////////
 
-inline bool isValidFile(char file)
+inline constexpr bool isValidFile(char file)
 {
    return file >= 'a' && file <= 'h';
 }
 
-inline bool isValidRank(char rank)
+inline constexpr bool isValidRank(char rank)
 {
    return rank >= '1' && rank <= '8';
 }
@@ -24,72 +28,91 @@ inline bool isValidRank(char rank)
 
 ///////////////////
 
+// Square on the board stored as an index from 0 (a1) to 63 (h8). Index
+// increases along the ranks first, i.e. b1 has index 1 and a2 has index 8.
 class Square
 {
  public:
-   Square() = default;
-   explicit Square(char file, char rank);
-   explicit Square(std::string_view notation);
-
-   char file() const { return m_file; }
-   char rank() const { return m_rank; }
+   static constexpr std::size_t NumSquares = 64;
+
+   constexpr Square() = default;
+   constexpr explicit Square(char file, char rank);
+   constexpr explicit Square(std::string_view notation);
+   static constexpr Square fromIndex(std::size_t idx);
+
+   constexpr char file() const;
+   constexpr char rank() const;
+   // Zero-based file and rank indices.
+   constexpr int fileIndex() const { return m_idx & 7; }
+   constexpr int rankIndex() const { return m_idx >> 3; }
+   constexpr std::size_t index() const { return m_idx; }
    std::string notate() const;
 
-   operator bool() const;
+   constexpr operator bool() const { return m_idx != Invalid; }
 
    friend void swap(Square& a, Square& b) noexcept
    {
       using std::swap;
-      swap(a.m_file, b.m_file);
-      swap(a.m_rank, b.m_rank);
+      swap(a.m_idx, b.m_idx);
    }
 
  private:
-   char m_file = 0;
-   char m_rank = 0;
+   static constexpr std::uint8_t Invalid = 64;
+   std::uint8_t m_idx = Invalid;
 };
 
 
-inline Square::Square(char file, char rank)
-   : m_file{file}, m_rank{rank}
+inline constexpr Square::Square(char file, char rank)
 {
+   if (isValidFile(file) && isValidRank(rank))
+      m_idx = static_cast<std::uint8_t>((rank - '1') * 8 + (file - 'a'));
 }
 
 
-inline Square::Square(std::string_view notation) : Square{}
+inline constexpr Square::Square(std::string_view notation)
 {
-   if (notation.size() >= 2 && isValidFile(notation[0]) && isValidRank(notation[1]))
-   {
-      m_file = notation[0];
-      m_rank = notation[1];
-   }
+   if (notation.size() >= 2)
+      *this = Square{notation[0], notation[1]};
 }
 
-inline std::string Square::notate() const
+inline constexpr Square Square::fromIndex(std::size_t idx)
 {
-   if (operator bool())
-      return std::string{m_file} + std::string{m_rank};
-   return "";
+   Square sq;
+   if (idx < NumSquares)
+      sq.m_idx = static_cast<std::uint8_t>(idx);
+   return sq;
 }
 
-inline Square::operator bool() const
+inline constexpr char Square::file() const
+{
+   return operator bool() ? static_cast<char>('a' + fileIndex()) : 0;
+}
+
+inline constexpr char Square::rank() const
+{
+   return operator bool() ? static_cast<char>('1' + rankIndex()) : 0;
+}
+
+inline std::string Square::notate() const
 {
-   return m_file != 0 && m_rank != 0;
+   if (operator bool())
+      return std::string{file()} + std::string{rank()};
+   return "";
 }
 
-inline bool operator==(Square a, Square b)
+inline constexpr bool operator==(Square a, Square b)
 {
-   return a.file() == b.file() && a.rank() == b.rank();
+   return a.index() == b.index();
 }
 
-inline bool operator!=(Square a, Square b)
+inline constexpr bool operator!=(Square a, Square b)
 {
    return !(a == b);
 }
 
-inline Square operator"" _sq(const char* str, std::size_t)
+inline constexpr Square operator"" _sq(const char* str, std::size_t len)
 {
-   return Square{str};
+   return Square{std::string_view{str, len}};
 }
 
 
@@ -98,11 +121,11 @@ inline Square operator"" _sq(const char* str, std::size_t)
 class Offset
 {
  public:
-   Offset() = default;
-   Offset(int df, int dr);
+   constexpr Offset() = default;
+   constexpr Offset(int df, int dr);
 
-   int df() const { return m_df; }
-   int dr() const { return m_dr; }
+   constexpr int df() const { return m_df; }
+   constexpr int dr() const { return m_dr; }
 
    friend void swap(Offset& a, Offset& b) noexcept
    {
@@ -117,26 +140,26 @@ class Offset
 };
 
 
-inline Offset::Offset(int df, int dr) : m_df{df}, m_dr{dr}
+inline constexpr Offset::Offset(int df, int dr) : m_df{df}, m_dr{dr}
 {
 }
 
-inline bool operator==(Offset a, Offset b)
+inline constexpr bool operator==(Offset a, Offset b)
 {
    return a.df() == b.df() && a.dr() == b.dr();
 }
 
-inline bool operator!=(Offset a, Offset b)
+inline constexpr bool operator!=(Offset a, Offset b)
 {
    return !(a == b);
 }
 
-inline Offset operator*(Offset off, int v)
+inline constexpr Offset operator*(Offset off, int v)
 {
    return Offset{off.df() * v, off.dr() * v};
 }
 
-inline Offset operator*(int v, Offset off)
+inline constexpr Offset operator*(int v, Offset off)
 {
    return off * v;
 }
@@ -144,27 +167,23 @@ inline Offset operator*(int v, Offset off)
 
 ///////////////////
 
-inline std::optional<Square> operator+(Square from, Offset off)
+inline constexpr std::optional<Square> operator+(Square from, Offset off)
 {
-   const char toFile = from.file() + static_cast<char>(off.df());
-   const char toRank = from.rank() + static_cast<char>(off.dr());
-   if (isValidFile(toFile) && isValidRank(toRank))
-   {
-      std::string to(1, toFile);
-      to += toRank;
-      return Square{to};
-   }
+   const int toFile = from.fileIndex() + off.df();
+   const int toRank = from.rankIndex() + off.dr();
+   if (from && toFile >= 0 && toFile < 8 && toRank >= 0 && toRank < 8)
+      return Square::fromIndex(toRank * 8 + toFile);
    return std::nullopt;
 }
 
 
-inline std::optional<Square> operator+(Offset off, Square from)
+inline constexpr std::optional<Square> operator+(Offset off, Square from)
 {
    return from + off;
 }
 
 
-inline std::optional<Square> operator+(std::optional<Square> from, Offset off)
+inline constexpr std::optional<Square> operator+(std::optional<Square> from, Offset off)
 {
    if (from.has_value())
       return *from + off;
@@ -172,7 +191,97 @@ inline std::optional<Square> operator+(std::optional<Square> from, Offset off)
 }
 
 
-inline std::optional<Square> operator+(Offset off, std::optional<Square> from)
+inline constexpr std::optional<Square> operator+(Offset off, std::optional<Square> from)
 {
    return from + off;
 }
+
+
+///////////////////
+
+// The eight directions that pieces can move along.
+enum class Direction
+{
+   North,
+   NorthEast,
+   East,
+   SouthEast,
+   South,
+   SouthWest,
+   West,
+   NorthWest
+};
+
+inline constexpr std::size_t NumDirections = 8;
+
+inline constexpr Offset offset(Direction dir)
+{
+   constexpr Offset Offsets[NumDirections] = {{0, 1},  {1, 1},   {1, 0},  {1, -1},
+                                              {0, -1}, {-1, -1}, {-1, 0}, {-1, 1}};
+   return Offsets[static_cast<std::size_t>(dir)];
+}
+
+
+// Squares from a given square to the edge of the board in one direction, not
+// including the starting square.
+class Ray
+{
+ public:
+   using const_iterator = const Square*;
+
+   constexpr std::size_t size() const { return m_size; }
+   constexpr bool empty() const { return m_size == 0; }
+   constexpr const_iterator begin() const { return m_squares; }
+   constexpr const_iterator end() const { return m_squares + m_size; }
+   constexpr Square operator[](std::size_t idx) const { return m_squares[idx]; }
+
+   constexpr void push_back(Square sq) { m_squares[m_size++] = sq; }
+
+ private:
+   Square m_squares[7] = {};
+   std::size_t m_size = 0;
+};
+
+
+namespace detail
+{
+using RayTable = std::array<std::array<Ray, NumDirections>, Square::NumSquares>;
+
+inline constexpr RayTable makeRayTable()
+{
+   RayTable table{};
+   for (std::size_t idx = 0; idx < Square::NumSquares; ++idx)
+   {
+      for (std::size_t dir = 0; dir < NumDirections; ++dir)
+      {
+         const Offset off = offset(static_cast<Direction>(dir));
+         for (std::optional<Square> sq = Square::fromIndex(idx) + off; sq.has_value();
+              sq = sq + off)
+         {
+            table[idx][dir].push_back(*sq);
+         }
+      }
+   }
+   return table;
+}
+
+inline constexpr RayTable Rays = makeRayTable();
+} // namespace detail
+
+
+// Returns the squares from a given square to the edge of the board in a given
+// direction.
+inline constexpr const Ray& ray(Square from, Direction dir)
+{
+   assert(from);
+   return detail::Rays[from.index()][static_cast<std::size_t>(dir)];
+}
+
+// Returns the adjacent square in a given direction.
+inline constexpr std::optional<Square> neighbor(Square from, Direction dir)
+{
+   const Ray& r = ray(from, dir);
+   if (r.empty())
+      return std::nullopt;
+   return r[0];
+}
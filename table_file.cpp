@@ -0,0 +1,418 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "table_file.h"
+#include "position.h"
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <system_error>
+#include <utility>
+
+
+namespace
+{
+///////////////////
+
+// Most pieces that a material can have.
+constexpr std::size_t MaxPieces = 8;
+// Squares that the white king is mirrored onto.
+constexpr std::size_t NumKingSquares = Square::NumSquares / 2;
+
+// File layout: magic bytes, notation of the material padded with zeros, one code
+// per position index.
+constexpr char Magic[] = {'M', 'T', 'B', '1'};
+constexpr std::size_t NotationSize = 12;
+constexpr std::size_t HeaderSize = sizeof(Magic) + NotationSize;
+constexpr char FileExtension[] = ".mtb";
+
+
+char notateTableFigure(Figure figure)
+{
+   return figure == Figure::Pawn ? 'P' : notateFigure(figure)[0];
+}
+
+
+std::optional<Figure> readTableFigure(char notation)
+{
+   switch (notation)
+   {
+   case 'K':
+   case 'Q':
+   case 'R':
+   case 'B':
+   case 'N':
+   case 'P':
+      return makeFigure(notation);
+   default:
+      return std::nullopt;
+   }
+}
+
+
+bool isValidPawnRank(Square sq)
+{
+   return sq.rank() != '1' && sq.rank() != '8';
+}
+
+} // namespace
+
+
+///////////////////
+
+Material::Material(std::vector<Figure> whiteFigures, std::vector<Figure> blackFigures)
+: m_figures{std::move(whiteFigures), std::move(blackFigures)}
+{
+   for (auto& figures : m_figures)
+      std::sort(std::begin(figures), std::end(figures));
+}
+
+
+std::optional<Material> Material::read(std::string_view notation)
+{
+   const std::size_t blackStart = notation.find('K', 1);
+   if (notation.empty() || notation[0] != 'K' || blackStart == std::string_view::npos ||
+       notation.size() > MaxPieces)
+      return std::nullopt;
+
+   std::array<std::vector<Figure>, NumColors> figures;
+   for (std::size_t i = 0; i < notation.size(); ++i)
+   {
+      const std::optional<Figure> figure = readTableFigure(notation[i]);
+      if (!figure.has_value() || (*figure == Figure::King && i != 0 && i != blackStart))
+         return std::nullopt;
+      const Color side = i < blackStart ? Color::White : Color::Black;
+      figures[static_cast<std::size_t>(side)].push_back(*figure);
+   }
+   return Material{std::move(figures[0]), std::move(figures[1])};
+}
+
+
+Material Material::of(const Position& pos)
+{
+   std::array<std::vector<Figure>, NumColors> figures;
+   for (const Color side : {Color::White, Color::Black})
+   {
+      std::vector<Figure>& sideFigures = figures[static_cast<std::size_t>(side)];
+      for (std::size_t f = 0; f < NumFigures; ++f)
+      {
+         const Figure figure = static_cast<Figure>(f);
+         sideFigures.insert(std::end(sideFigures), pos.squares(side, figure).size(),
+                            figure);
+      }
+   }
+   return Material{std::move(figures[0]), std::move(figures[1])};
+}
+
+
+std::string Material::notate() const
+{
+   std::string notation;
+   for (const auto& figures : m_figures)
+      for (const Figure figure : figures)
+         notation += notateTableFigure(figure);
+   return notation;
+}
+
+
+std::size_t Material::numPieces() const
+{
+   return m_figures[0].size() + m_figures[1].size();
+}
+
+
+const std::vector<Figure>& Material::figures(Color side) const
+{
+   return m_figures[static_cast<std::size_t>(side)];
+}
+
+
+Material Material::flipped() const
+{
+   return Material{m_figures[1], m_figures[0]};
+}
+
+
+std::size_t Material::numEntries() const
+{
+   std::size_t entries = 2 * NumKingSquares;
+   for (std::size_t i = 1; i < numPieces(); ++i)
+      entries *= Square::NumSquares;
+   return entries;
+}
+
+
+std::optional<std::size_t> Material::index(const Position& pos, Color side,
+                                           bool isFlipped) const
+{
+   if (static_cast<std::size_t>(popcount(pos.occupied())) != numPieces())
+      return std::nullopt;
+
+   // Flipping swaps the colors and mirrors the ranks. Mirroring the files moves the
+   // white king onto the files a to d.
+   const auto posColor = [isFlipped](Color c) { return isFlipped ? !c : c; };
+   const SquareList& whiteKing = pos.squares(posColor(Color::White), Figure::King);
+   if (whiteKing.size() != 1)
+      return std::nullopt;
+   std::size_t transform = isFlipped ? 56 : 0;
+   if ((whiteKing[0].index() ^ transform) % 8 >= 4)
+      transform ^= 7;
+
+   // Squares in the order of the figures. Identical pieces are ordered by square, so
+   // that each position has one index.
+   std::array<std::size_t, MaxPieces> squares{};
+   std::size_t numSquares = 0;
+   for (const Color materialSide : {Color::White, Color::Black})
+   {
+      const std::vector<Figure>& sideFigures = figures(materialSide);
+      for (std::size_t i = 0; i < sideFigures.size();)
+      {
+         const Figure figure = sideFigures[i];
+         const std::size_t count = static_cast<std::size_t>(
+            std::count(std::begin(sideFigures) + i, std::end(sideFigures), figure));
+         const SquareList& list = pos.squares(posColor(materialSide), figure);
+         if (list.size() != count)
+            return std::nullopt;
+
+         const std::size_t first = numSquares;
+         for (const Square sq : list)
+         {
+            if (figure == Figure::Pawn && !isValidPawnRank(sq))
+               return std::nullopt;
+            squares[numSquares++] = sq.index() ^ transform;
+         }
+         std::sort(squares.data() + first, squares.data() + numSquares);
+         i += count;
+      }
+   }
+
+   const std::size_t king = squares[0];
+   std::size_t idx = king / 8 * 4 + king % 8;
+   for (std::size_t i = 1; i < numSquares; ++i)
+      idx = idx * Square::NumSquares + squares[i];
+   return idx * 2 + static_cast<std::size_t>(posColor(side));
+}
+
+
+std::optional<std::vector<Piece>> Material::pieces(std::size_t idx) const
+{
+   const std::size_t n = numPieces();
+   if (idx >= numEntries())
+      return std::nullopt;
+
+   std::array<std::size_t, MaxPieces> squares{};
+   idx /= 2;
+   for (std::size_t i = n - 1; i > 0; --i)
+   {
+      squares[i] = idx % Square::NumSquares;
+      idx /= Square::NumSquares;
+   }
+   squares[0] = idx / 4 * 8 + idx % 4;
+
+   std::vector<Piece> pieces;
+   Bitboard occupied = EmptyBB;
+   for (const Color side : {Color::White, Color::Black})
+   {
+      const std::vector<Figure>& sideFigures = figures(side);
+      for (std::size_t i = 0; i < sideFigures.size(); ++i)
+      {
+         const Square sq = Square::fromIndex(squares[pieces.size()]);
+         if (isSet(occupied, sq) ||
+             (sideFigures[i] == Figure::Pawn && !isValidPawnRank(sq)))
+            return std::nullopt;
+         // Identical pieces are stored in the order of their squares.
+         if (i > 0 && sideFigures[i] == sideFigures[i - 1] &&
+             pieces.back().coord().index() > sq.index())
+            return std::nullopt;
+
+         occupied |= bit(sq);
+         pieces.push_back(Piece{sideFigures[i], side, sq});
+      }
+   }
+   return pieces;
+}
+
+
+Color Material::sideToMove(std::size_t idx)
+{
+   return idx % 2 == 0 ? Color::White : Color::Black;
+}
+
+
+bool operator==(const Material& a, const Material& b)
+{
+   return a.figures(Color::White) == b.figures(Color::White) &&
+          a.figures(Color::Black) == b.figures(Color::Black);
+}
+
+
+///////////////////
+
+std::uint8_t TableValue::encode() const
+{
+   switch (wdl)
+   {
+   case Wdl::Win:
+      return static_cast<std::uint8_t>(std::min(distance, MaxWinDistance));
+   case Wdl::Loss:
+      return static_cast<std::uint8_t>(0x80 + std::min(distance, MaxLossDistance));
+   default:
+      return 0;
+   }
+}
+
+
+std::optional<TableValue> TableValue::decode(std::uint8_t code)
+{
+   if (code == InvalidCode)
+      return std::nullopt;
+   if (code == 0)
+      return TableValue{};
+   if (code < 0x80)
+      return TableValue{Wdl::Win, code};
+   return TableValue{Wdl::Loss, code - 0x80u};
+}
+
+
+bool operator==(const TableValue& a, const TableValue& b)
+{
+   return a.wdl == b.wdl && a.distance == b.distance;
+}
+
+
+///////////////////
+
+std::optional<TableFile> TableFile::open(const std::filesystem::path& path)
+{
+   std::optional<MappedFile> file = MappedFile::open(path);
+   if (!file.has_value() || file->size() < HeaderSize ||
+       std::memcmp(file->data(), Magic, sizeof(Magic)) != 0)
+      return std::nullopt;
+
+   const char* notation = reinterpret_cast<const char*>(file->data() + sizeof(Magic));
+   const std::size_t notationLength = static_cast<std::size_t>(
+      std::find(notation, notation + NotationSize, '\0') - notation);
+   const std::optional<Material> material =
+      Material::read(std::string_view{notation, notationLength});
+   if (!material.has_value() || file->size() != HeaderSize + material->numEntries())
+      return std::nullopt;
+
+   return TableFile{std::move(*file), *material};
+}
+
+
+bool TableFile::write(const std::filesystem::path& path, const Material& material,
+                      const std::vector<std::uint8_t>& codes)
+{
+   const std::string notation = material.notate();
+   if (codes.size() != material.numEntries() || notation.size() > NotationSize)
+      return false;
+
+   std::optional<MappedFile> file = MappedFile::create(path, HeaderSize + codes.size());
+   if (!file.has_value())
+      return false;
+
+   std::byte* data = file->writableData();
+   if (data == nullptr)
+      return false;
+   std::memset(data, 0, HeaderSize);
+   std::memcpy(data, Magic, sizeof(Magic));
+   std::memcpy(data + sizeof(Magic), notation.data(), notation.size());
+   std::memcpy(data + HeaderSize, codes.data(), codes.size());
+   return true;
+}
+
+
+std::string TableFile::fileName(const Material& material)
+{
+   return material.notate() + FileExtension;
+}
+
+
+TableFile::TableFile(MappedFile file, Material material)
+: m_file{std::move(file)}, m_material{std::move(material)}
+{
+}
+
+
+std::optional<TableValue> TableFile::probe(const Position& pos, Color side,
+                                           bool isFlipped) const
+{
+   const std::optional<std::size_t> idx = m_material.index(pos, side, isFlipped);
+   if (!idx.has_value())
+      return std::nullopt;
+   const std::byte code = m_file.data()[HeaderSize + *idx];
+   return TableValue::decode(std::to_integer<std::uint8_t>(code));
+}
+
+
+///////////////////
+
+bool TableFiles::add(std::optional<TableFile> file)
+{
+   if (!file.has_value())
+      return false;
+
+   m_maxPieces = std::max(m_maxPieces, file->material().numPieces());
+   const std::string notation = file->material().notate();
+   m_files.insert_or_assign(notation, std::move(*file));
+   return true;
+}
+
+
+std::size_t TableFiles::openDirectory(const std::filesystem::path& dir)
+{
+   std::size_t numOpened = 0;
+   std::error_code ec;
+   for (const auto& entry : std::filesystem::directory_iterator{dir, ec})
+   {
+      if (entry.path().extension() == FileExtension &&
+          add(TableFile::open(entry.path())))
+         ++numOpened;
+   }
+   return numOpened;
+}
+
+
+bool TableFiles::contains(const Material& material) const
+{
+   return m_files.count(material.notate()) > 0 ||
+          m_files.count(material.flipped().notate()) > 0;
+}
+
+
+std::optional<TableValue> TableFiles::probe(const Position& pos, Color side) const
+{
+   if (static_cast<std::size_t>(popcount(pos.occupied())) > m_maxPieces)
+      return std::nullopt;
+
+   const Material material = Material::of(pos);
+   if (const auto it = m_files.find(material.notate()); it != std::end(m_files))
+      return it->second.probe(pos, side);
+   if (const auto it = m_files.find(material.flipped().notate()); it != std::end(m_files))
+      return it->second.probe(pos, side, true);
+   return std::nullopt;
+}
+
+
+///////////////////
+
+EndgameTable makeEndgameTable(std::shared_ptr<const TableFiles> files)
+{
+   EndgameTable table;
+   table.maxPieces = files->maxPieces();
+   table.probeWdl = [files](const Position& pos, Color side) -> std::optional<Wdl> {
+      const std::optional<TableValue> value = files->probe(pos, side);
+      if (!value.has_value())
+         return std::nullopt;
+      return value->wdl;
+   };
+   table.probeDtz = [files](const Position& pos, Color side) -> std::optional<int> {
+      const std::optional<TableValue> value = files->probe(pos, side);
+      if (!value.has_value())
+         return std::nullopt;
+      return static_cast<int>(value->distance);
+   };
+   return table;
+}
@@ -0,0 +1,144 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#pragma once
+#include "mapped_file.h"
+#include "piece.h"
+#include "tablebase.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class Position;
+
+
+///////////////////
+
+// Pieces of an endgame, e.g. "KQK" for king and queen versus king. Each side starts
+// with its king. The pieces of White come first.
+class Material
+{
+ public:
+   Material() = default;
+   // Takes the figures of each side including the kings.
+   Material(std::vector<Figure> whiteFigures, std::vector<Figure> blackFigures);
+
+   static std::optional<Material> read(std::string_view notation);
+   static Material of(const Position& pos);
+
+   std::string notate() const;
+   std::size_t numPieces() const;
+   // Figures of one side ordered like the Figure enumeration, king first.
+   const std::vector<Figure>& figures(Color side) const;
+   // Material with the sides swapped.
+   Material flipped() const;
+
+   // Positions are indexed by the squares of the pieces and the side to move. The
+   // white king is mirrored onto the files a to d.
+   std::size_t numEntries() const;
+   // Index of a position with this material. Swaps the colors and ranks of the
+   // pieces if the position is flipped. Returns nothing if the position does not
+   // have this material or has pawns on the first or last rank.
+   std::optional<std::size_t> index(const Position& pos, Color side,
+                                    bool isFlipped = false) const;
+   // Pieces of the position with a given index and the side to move. Returns nothing
+   // for indices that no position maps to, e.g. if pieces share a square.
+   std::optional<std::vector<Piece>> pieces(std::size_t idx) const;
+   static Color sideToMove(std::size_t idx);
+
+ private:
+   std::array<std::vector<Figure>, NumColors> m_figures;
+};
+
+
+bool operator==(const Material& a, const Material& b);
+
+inline bool operator!=(const Material& a, const Material& b)
+{
+   return !(a == b);
+}
+
+
+///////////////////
+
+// Result of a position in a table file from the point of view of the side to move.
+struct TableValue
+{
+   static constexpr std::size_t MaxWinDistance = 127;
+   static constexpr std::size_t MaxLossDistance = 126;
+
+   Wdl wdl = Wdl::Draw;
+   // Plies until the game is decided by a mate or converted into another endgame by
+   // a capture or a promotion. Zero for draws.
+   std::size_t distance = 0;
+
+   // Stored in one byte per position. Invalid positions are stored as a separate
+   // code.
+   std::uint8_t encode() const;
+   static std::optional<TableValue> decode(std::uint8_t code);
+   static constexpr std::uint8_t InvalidCode = 0xFF;
+};
+
+
+bool operator==(const TableValue& a, const TableValue& b);
+
+
+///////////////////
+
+// Solved endgame in a memory mapped file. Holds a short header followed by one byte
+// per position index.
+class TableFile
+{
+ public:
+   // Returns nothing if the file cannot be mapped or is not a table.
+   static std::optional<TableFile> open(const std::filesystem::path& path);
+   // Returns false if the file cannot be written.
+   static bool write(const std::filesystem::path& path, const Material& material,
+                     const std::vector<std::uint8_t>& codes);
+   // File name of the table of a material.
+   static std::string fileName(const Material& material);
+
+   const Material& material() const { return m_material; }
+   std::optional<TableValue> probe(const Position& pos, Color side,
+                                   bool isFlipped = false) const;
+
+ private:
+   TableFile(MappedFile file, Material material);
+
+ private:
+   MappedFile m_file;
+   Material m_material;
+};
+
+
+// Table files that are looked up by the material of positions.
+class TableFiles
+{
+ public:
+   bool add(std::optional<TableFile> file);
+   // Opens the table files in a directory. Returns the number of opened tables.
+   std::size_t openDirectory(const std::filesystem::path& dir);
+
+   std::size_t size() const { return m_files.size(); }
+   std::size_t maxPieces() const { return m_maxPieces; }
+   // Whether there is a table for a material or for the material with the sides
+   // swapped.
+   bool contains(const Material& material) const;
+   std::optional<TableValue> probe(const Position& pos, Color side) const;
+
+ private:
+   std::map<std::string, TableFile> m_files;
+   std::size_t m_maxPieces = 0;
+};
+
+
+// Table for the search that looks up positions in shared table files.
+EndgameTable makeEndgameTable(std::shared_ptr<const TableFiles> files);
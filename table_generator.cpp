@@ -0,0 +1,369 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "table_generator.h"
+#include "attack_tables.h"
+#include "move.h"
+#include "position.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <iterator>
+#include <memory>
+#include <thread>
+
+
+namespace
+{
+///////////////////
+
+// Codes of undecided positions. Positions that stay undecided are draws.
+constexpr std::uint8_t UndecidedCode = 0;
+
+constexpr std::array<Figure, 4> PromotionFigures = {Figure::Queen, Figure::Rook,
+                                                    Figure::Bishop, Figure::Knight};
+
+
+// Calls a function with a range of indices and the index of the thread for each of
+// a given number of threads.
+template <typename Fn> void parallelFor(std::size_t count, std::size_t numThreads, Fn fn)
+{
+   numThreads = std::max<std::size_t>(std::min(numThreads, count), 1);
+   const std::size_t chunkSize = (count + numThreads - 1) / numThreads;
+
+   std::vector<std::thread> threads;
+   for (std::size_t t = 0; t < numThreads; ++t)
+   {
+      const std::size_t first = std::min(t * chunkSize, count);
+      const std::size_t last = std::min(first + chunkSize, count);
+      threads.emplace_back([&fn, first, last, t]() { fn(first, last, t); });
+   }
+   for (std::thread& thread : threads)
+      thread.join();
+}
+
+
+bool isInCheck(const Position& pos, Color side)
+{
+   const SquareList& kings = pos.squares(side, Figure::King);
+   return !kings.empty() && pos.isThreatenedBy(kings[0], !side);
+}
+
+
+bool isLastRank(Square sq)
+{
+   return sq.rank() == '1' || sq.rank() == '8';
+}
+
+
+struct Successor
+{
+   Position pos;
+   // Captures and promotions change the material.
+   bool isConversion = false;
+};
+
+
+// Positions after the legal moves of a side. Includes promotions, which the move
+// generation of the search does not make.
+std::vector<Successor> successors(const Position& pos, Color side)
+{
+   std::vector<Successor> next;
+   const auto addIfLegal = [&](const Move& move) {
+      Position after = pos.makeUnrecordedMove(move);
+      if (isInCheck(after, side))
+         return;
+      const bool isConversion =
+         pos[move.to()].has_value() || move.promotion().has_value();
+      next.push_back(Successor{std::move(after), isConversion});
+   };
+
+   forEachPiece(pos, side, [&](const Piece& piece) {
+      for (const Move& move : piece.nextMoves(pos))
+      {
+         if (piece.figure() == Figure::Pawn && isLastRank(move.to()))
+         {
+            for (const Figure figure : PromotionFigures)
+               addIfLegal(Move{piece, move.to(), figure, pos});
+         }
+         else
+         {
+            addIfLegal(move);
+         }
+      }
+   });
+   return next;
+}
+
+
+// Squares that a piece can have come from by a move that is not a capture or a
+// promotion.
+Bitboard retractionSquares(const Piece& piece, Bitboard occupied)
+{
+   const Square at = piece.coord();
+   Bitboard from = EmptyBB;
+
+   switch (piece.figure())
+   {
+   case Figure::King:
+      return kingAttacks(at) & ~occupied;
+   case Figure::Knight:
+      return knightAttacks(at) & ~occupied;
+   case Figure::Queen:
+      return (rookAttacks(at, occupied) | bishopAttacks(at, occupied)) & ~occupied;
+   case Figure::Rook:
+      return rookAttacks(at, occupied) & ~occupied;
+   case Figure::Bishop:
+      return bishopAttacks(at, occupied) & ~occupied;
+   case Figure::Pawn:
+   {
+      const bool isWhite = piece.color() == Color::White;
+      const std::optional<Square> back = neighbor(at, isWhite ? Direction::South
+                                                               : Direction::North);
+      if (!back.has_value() || isLastRank(*back) || isSet(occupied, *back))
+         return EmptyBB;
+      from |= bit(*back);
+      // Two squares from the initial rank.
+      if (at.rank() == (isWhite ? '4' : '5'))
+      {
+         const Square initial = Square::fromIndex(isWhite ? at.index() - 16
+                                                           : at.index() + 16);
+         if (!isSet(occupied, initial))
+            from |= bit(initial);
+      }
+      return from;
+   }
+   default:
+      return EmptyBB;
+   }
+}
+
+
+// Calls a function with the index of each position that leads to a given position
+// by a move that keeps the material.
+template <typename Fn>
+void forEachPredecessor(const Material& material, const std::vector<Piece>& pieces,
+                        Color side, Fn fn)
+{
+   const Color moved = !side;
+   Bitboard occupied = EmptyBB;
+   for (const Piece& piece : pieces)
+      occupied |= bit(piece.coord());
+
+   std::vector<Piece> before = pieces;
+   for (std::size_t i = 0; i < pieces.size(); ++i)
+   {
+      if (pieces[i].color() != moved)
+         continue;
+
+      forEachSquare(retractionSquares(pieces[i], occupied), [&](Square from) {
+         before[i] = Piece{pieces[i].figure(), moved, from};
+         const Position pos{before};
+         // The side that did not move cannot be in check.
+         if (isInCheck(pos, side))
+            return;
+         if (const auto idx = material.index(pos, moved); idx.has_value())
+            fn(*idx);
+      });
+      before[i] = pieces[i];
+   }
+}
+
+
+std::vector<Material> uniqueMaterials(std::vector<Material> materials)
+{
+   std::vector<Material> unique;
+   for (Material& material : materials)
+      if (std::find(std::begin(unique), std::end(unique), material) == std::end(unique))
+         unique.push_back(std::move(material));
+   return unique;
+}
+
+
+std::vector<Figure> removeOne(std::vector<Figure> figures, Figure figure)
+{
+   figures.erase(std::find(std::begin(figures), std::end(figures), figure));
+   return figures;
+}
+
+
+std::vector<Figure> replaceOne(std::vector<Figure> figures, Figure figure,
+                               Figure replacement)
+{
+   *std::find(std::begin(figures), std::end(figures), figure) = replacement;
+   return figures;
+}
+
+
+// Materials that a side's capture or promotion turns a material into. Returns the
+// figures of the side and of its opponent.
+std::vector<std::array<std::vector<Figure>, NumColors>>
+conversions(const std::vector<Figure>& own, const std::vector<Figure>& opponent)
+{
+   std::vector<std::array<std::vector<Figure>, NumColors>> result;
+   std::vector<std::vector<Figure>> afterCaptures;
+   for (const Figure captured : opponent)
+      if (captured != Figure::King)
+         afterCaptures.push_back(removeOne(opponent, captured));
+
+   for (const std::vector<Figure>& opponentAfter : afterCaptures)
+      result.push_back({own, opponentAfter});
+
+   if (std::find(std::begin(own), std::end(own), Figure::Pawn) != std::end(own))
+   {
+      for (const Figure figure : PromotionFigures)
+      {
+         const std::vector<Figure> promoted = replaceOne(own, Figure::Pawn, figure);
+         result.push_back({promoted, opponent});
+         for (const std::vector<Figure>& opponentAfter : afterCaptures)
+            result.push_back({promoted, opponentAfter});
+      }
+   }
+   return result;
+}
+
+} // namespace
+
+
+///////////////////
+
+std::vector<Material> successorMaterials(const Material& material)
+{
+   std::vector<Material> materials;
+   const auto& white = material.figures(Color::White);
+   const auto& black = material.figures(Color::Black);
+   for (const auto& [own, opponent] : conversions(white, black))
+      materials.push_back(Material{own, opponent});
+   for (const auto& [own, opponent] : conversions(black, white))
+      materials.push_back(Material{opponent, own});
+   return uniqueMaterials(std::move(materials));
+}
+
+
+std::optional<std::vector<std::uint8_t>>
+generateTable(const Material& material, const TableFiles& successorTables,
+              std::size_t numThreads)
+{
+   const std::size_t numEntries = material.numEntries();
+   auto codes = std::make_unique<std::atomic<std::uint8_t>[]>(numEntries);
+   // Moves of undecided positions that do not lead to a loss for the moving side yet.
+   auto remaining = std::make_unique<std::atomic<std::uint16_t>[]>(numEntries);
+   std::atomic<bool> isMissingTable{false};
+
+   // Positions decided in a number of plies. Starts with mates and with positions
+   // that get decided by converting the material.
+   std::vector<std::vector<std::size_t>> decided(2);
+   std::vector<std::vector<std::size_t>> mates(numThreads);
+   std::vector<std::vector<std::size_t>> converted(numThreads);
+   parallelFor(numEntries, numThreads, [&](std::size_t first, std::size_t last,
+                                           std::size_t thread) {
+      for (std::size_t idx = first; idx < last; ++idx)
+      {
+         const std::optional<std::vector<Piece>> pieces = material.pieces(idx);
+         const Color side = Material::sideToMove(idx);
+         const std::optional<Position> pos =
+            pieces.has_value() ? std::make_optional<Position>(*pieces) : std::nullopt;
+         if (!pos.has_value() || isInCheck(*pos, !side))
+         {
+            codes[idx] = TableValue::InvalidCode;
+            continue;
+         }
+
+         const std::vector<Successor> next = successors(*pos, side);
+         if (next.empty())
+         {
+            // Mate or stalemate.
+            if (isInCheck(*pos, side))
+            {
+               codes[idx] = TableValue{Wdl::Loss, 0}.encode();
+               mates[thread].push_back(idx);
+            }
+            continue;
+         }
+
+         std::uint16_t count = 0;
+         bool isWin = false;
+         for (const Successor& successor : next)
+         {
+            if (!successor.isConversion)
+            {
+               ++count;
+               continue;
+            }
+
+            const std::optional<TableValue> value =
+               successorTables.probe(successor.pos, !side);
+            if (!value.has_value())
+               isMissingTable = true;
+            else if (value->wdl == Wdl::Loss)
+               isWin = true;
+            else if (value->wdl == Wdl::Draw)
+               ++count;
+         }
+
+         remaining[idx] = count;
+         if (isWin || count == 0)
+         {
+            codes[idx] = TableValue{isWin ? Wdl::Win : Wdl::Loss, 1}.encode();
+            converted[thread].push_back(idx);
+         }
+      }
+   });
+   if (isMissingTable)
+      return std::nullopt;
+
+   for (std::size_t t = 0; t < numThreads; ++t)
+   {
+      decided[0].insert(std::end(decided[0]), std::begin(mates[t]), std::end(mates[t]));
+      decided[1].insert(std::end(decided[1]), std::begin(converted[t]),
+                        std::end(converted[t]));
+   }
+
+   // A position is won once one move leads to a lost position and lost once all
+   // moves lead to won positions. Deciding the positions in the order of their
+   // distances makes wins as short and losses as long as possible.
+   for (std::size_t distance = 0; distance < decided.size(); ++distance)
+   {
+      const std::vector<std::size_t> current = std::move(decided[distance]);
+      std::vector<std::vector<std::size_t>> found(numThreads);
+      const std::uint8_t winCode = TableValue{Wdl::Win, distance + 1}.encode();
+      const std::uint8_t lossCode = TableValue{Wdl::Loss, distance + 1}.encode();
+
+      parallelFor(current.size(), numThreads, [&](std::size_t first, std::size_t last,
+                                                  std::size_t thread) {
+         for (std::size_t i = first; i < last; ++i)
+         {
+            const std::size_t idx = current[i];
+            const bool isLoss = TableValue::decode(codes[idx])->wdl == Wdl::Loss;
+            forEachPredecessor(material, *material.pieces(idx),
+                               Material::sideToMove(idx), [&](std::size_t pred) {
+                                  std::uint8_t expected = UndecidedCode;
+                                  if (isLoss || remaining[pred].fetch_sub(1) == 1)
+                                  {
+                                     if (codes[pred].compare_exchange_strong(
+                                            expected, isLoss ? winCode : lossCode))
+                                        found[thread].push_back(pred);
+                                  }
+                               });
+         }
+      });
+
+      std::vector<std::size_t> next;
+      for (const std::vector<std::size_t>& positions : found)
+         next.insert(std::end(next), std::begin(positions), std::end(positions));
+      if (next.empty())
+         continue;
+      if (distance + 1 > TableValue::MaxLossDistance)
+         return std::nullopt;
+      if (decided.size() == distance + 1)
+         decided.emplace_back();
+      decided[distance + 1].insert(std::end(decided[distance + 1]), std::begin(next),
+                                   std::end(next));
+   }
+
+   std::vector<std::uint8_t> result(numEntries);
+   for (std::size_t idx = 0; idx < numEntries; ++idx)
+      result[idx] = codes[idx];
+   return result;
+}
@@ -0,0 +1,28 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#pragma once
+#include "table_file.h"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+
+///////////////////
+
+// Materials that positions of a given material turn into by one capture or
+// promotion. Their tables need to exist before the table of the material can be
+// generated.
+std::vector<Material> successorMaterials(const Material& material);
+
+// Solves all positions of a material by retrograde analysis on a given number of
+// threads. Starts from mates and from captures and promotions, whose results are
+// looked up in given tables, and works backwards through the moves that lead to
+// decided positions. Positions that stay undecided are draws.
+// Returns the codes of the table file or nothing if the table of a successor
+// material is missing or a distance is too long to store.
+std::optional<std::vector<std::uint8_t>>
+generateTable(const Material& material, const TableFiles& successorTables,
+              std::size_t numThreads);
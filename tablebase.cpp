@@ -0,0 +1,65 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "tablebase.h"
+#include "kpk.h"
+#include "position.h"
+#include <algorithm>
+#include <utility>
+
+
+///////////////////
+
+Tablebases::Tablebases()
+{
+   add(kpkTable());
+}
+
+
+const Tablebases& Tablebases::builtIn()
+{
+   static const Tablebases tables;
+   return tables;
+}
+
+
+void Tablebases::add(EndgameTable table)
+{
+   m_maxPieces = std::max(m_maxPieces, table.maxPieces);
+   m_tables.push_back(std::move(table));
+}
+
+
+std::optional<Wdl> Tablebases::probeWdl(const Position& pos, Color side) const
+{
+   const std::size_t numPieces = popcount(pos.occupied());
+   if (numPieces > m_maxPieces)
+      return std::nullopt;
+
+   for (const EndgameTable& table : m_tables)
+   {
+      if (numPieces > table.maxPieces || !table.probeWdl)
+         continue;
+      if (const std::optional<Wdl> wdl = table.probeWdl(pos, side); wdl.has_value())
+         return wdl;
+   }
+   return std::nullopt;
+}
+
+
+std::optional<int> Tablebases::probeDtz(const Position& pos, Color side) const
+{
+   const std::size_t numPieces = popcount(pos.occupied());
+   if (numPieces > m_maxPieces)
+      return std::nullopt;
+
+   for (const EndgameTable& table : m_tables)
+   {
+      if (numPieces > table.maxPieces || !table.probeDtz)
+         continue;
+      if (const std::optional<int> dtz = table.probeDtz(pos, side); dtz.has_value())
+         return dtz;
+   }
+   return std::nullopt;
+}
@@ -0,0 +1,83 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#pragma once
+#include "piece.h"
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <vector>
+
+class Position;
+
+
+///////////////////
+
+// Game-theoretical result of a position from the point of view of the side to move.
+enum class Wdl
+{
+   Loss,
+   Draw,
+   Win
+};
+
+
+inline Wdl operator-(Wdl wdl)
+{
+   switch (wdl)
+   {
+   case Wdl::Loss:
+      return Wdl::Win;
+   case Wdl::Win:
+      return Wdl::Loss;
+   default:
+      return Wdl::Draw;
+   }
+}
+
+
+// Looks up the result of a position for a given side to move. Returns nothing if the
+// table does not cover the position.
+using WdlProbe = std::function<std::optional<Wdl>(const Position&, Color)>;
+// Looks up the number of plies until the result of a position comes closer, e.g. by
+// a capture, a promotion or a mate. Returns nothing if the table does not cover the
+// position.
+using DtzProbe = std::function<std::optional<int>(const Position&, Color)>;
+
+
+// Solved endgames, e.g. a generated bitbase or a reader of table files.
+struct EndgameTable
+{
+   // Most pieces of the positions that the table covers, including the kings.
+   std::size_t maxPieces = 0;
+   WdlProbe probeWdl;
+   // Optional.
+   DtzProbe probeDtz;
+};
+
+
+///////////////////
+
+// Tables that the search looks up positions in. Asks the tables in the order they
+// were added. Tables must not be added while searching.
+class Tablebases
+{
+ public:
+   // Starts with the built-in tables. Generates them if needed, so that searches do
+   // not wait for them.
+   Tablebases();
+
+   // Tables that are generated in-process and need no files.
+   static const Tablebases& builtIn();
+
+   void add(EndgameTable table);
+   // Most pieces of a position that any table covers.
+   std::size_t maxPieces() const { return m_maxPieces; }
+   std::optional<Wdl> probeWdl(const Position& pos, Color side) const;
+   std::optional<int> probeDtz(const Position& pos, Color side) const;
+
+ private:
+   std::vector<EndgameTable> m_tables;
+   std::size_t m_maxPieces = 0;
+};
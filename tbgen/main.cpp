@@ -0,0 +1,115 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "table_file.h"
+#include "table_generator.h"
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Generates endgame tables, e.g.
+//    matt_tbgen --dir tables --threads 8 KQK KRK KPK KBNK
+// Also generates the tables that the requested tables depend on. Keeps tables that
+// already exist in the directory.
+
+
+namespace
+{
+///////////////////
+
+struct Options
+{
+   std::filesystem::path dir = ".";
+   std::size_t numThreads = std::max(std::thread::hardware_concurrency(), 1u);
+   std::vector<Material> materials;
+};
+
+
+std::optional<Options> readOptions(int argc, char* argv[])
+{
+   Options options;
+   for (int i = 1; i < argc; ++i)
+   {
+      const std::string arg = argv[i];
+      if (arg == "--dir" && i + 1 < argc)
+      {
+         options.dir = argv[++i];
+      }
+      else if (arg == "--threads" && i + 1 < argc)
+      {
+         options.numThreads = std::max(std::strtoul(argv[++i], nullptr, 10), 1ul);
+      }
+      else if (const auto material = Material::read(arg); material.has_value())
+      {
+         options.materials.push_back(*material);
+      }
+      else
+      {
+         std::cerr << "Unknown argument: " << arg << "\n";
+         return std::nullopt;
+      }
+   }
+
+   if (options.materials.empty())
+      return std::nullopt;
+   return options;
+}
+
+
+// Generates the table of a material after the tables it depends on.
+bool generate(const Material& material, const Options& options, TableFiles& tables)
+{
+   if (tables.contains(material))
+      return true;
+   for (const Material& successor : successorMaterials(material))
+      if (!generate(successor, options, tables))
+         return false;
+
+   using Clock = std::chrono::steady_clock;
+   const Clock::time_point start = Clock::now();
+   std::cout << material.notate() << ": generating " << material.numEntries()
+             << " positions" << std::endl;
+
+   const auto codes = generateTable(material, tables, options.numThreads);
+   const std::filesystem::path path = options.dir / TableFile::fileName(material);
+   if (!codes.has_value() || !TableFile::write(path, material, *codes) ||
+       !tables.add(TableFile::open(path)))
+   {
+      std::cerr << material.notate() << ": failed\n";
+      return false;
+   }
+
+   const auto elapsed =
+      std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start);
+   std::cout << material.notate() << ": written to " << path.string() << " in "
+             << elapsed.count() << " ms" << std::endl;
+   return true;
+}
+
+} // namespace
+
+
+int main(int argc, char* argv[])
+{
+   const std::optional<Options> options = readOptions(argc, argv);
+   if (!options.has_value())
+   {
+      std::cerr << "usage: matt_tbgen [--dir <dir>] [--threads <n>] <material>...\n";
+      return EXIT_FAILURE;
+   }
+
+   std::error_code ec;
+   std::filesystem::create_directories(options->dir, ec);
+   TableFiles tables;
+   tables.openDirectory(options->dir);
+
+   for (const Material& material : options->materials)
+      if (!generate(material, *options, tables))
+         return EXIT_FAILURE;
+   return EXIT_SUCCESS;
+}
@@ -2,22 +2,70 @@
 // Mar-2021, Michael Lindner
 // MIT license
 //
+#include "arena_tests.h"
+#include "attack_tables_tests.h"
+#include "batch_tests.h"
+#include "bitboard_tests.h"
+#include "book_tests.h"
+#include "engine_tests.h"
+#include "eval_cache_tests.h"
+#include "eval_kernels_tests.h"
+#include "evaluation_tests.h"
+#include "fen_tests.h"
+#include "kpk_tests.h"
+#include "mapped_file_tests.h"
 #include "matt_tests.h"
+#include "move_picker_tests.h"
 #include "move_tests.h"
+#include "nnue_tests.h"
+#include "packed_position_tests.h"
+#include "pgn_tests.h"
 #include "piece_tests.h"
 #include "position_tests.h"
+#include "repetition_tests.h"
 #include "square_tests.h"
+#include "table_file_tests.h"
+#include "table_generator_tests.h"
+#include "tablebase_tests.h"
+#include "time_manager_tests.h"
+#include "tt_tests.h"
+#include "uci_tests.h"
+#include "zobrist_tests.h"
 #include <cstdlib>
 #include <iostream>
 
 
 int main()
 {
+   testArena();
+   testAttackTables();
+   testBatch();
+   testBitboard();
+   testBook();
+   testEngine();
+   testEvalCache();
+   testEvalKernels();
+   testEvaluation();
+   testFen();
+   testKpk();
+   testMappedFile();
    testMatt();
    testMove();
+   testMovePicker();
+   testNnue();
+   testPackedPosition();
+   testPgn();
    testPiece();
    testPosition();
+   testRepetition();
    testSquare();
+   testTableFile();
+   testTableGenerator();
+   testTablebase();
+   testTimeManager();
+   testTt();
+   testUci();
+   testZobrist();
 
    std::cout << "matt tests finished.\n";
    return EXIT_SUCCESS;
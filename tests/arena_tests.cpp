@@ -0,0 +1,166 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "arena_tests.h"
+#include "arena.h"
+#include "test_util.h"
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace
+{
+///////////////////
+
+// Allocates memory that a test does not use.
+void skip(Arena& arena, std::size_t bytes, std::size_t alignment)
+{
+   static_cast<void>(arena.allocate(bytes, alignment));
+}
+
+
+bool isAligned(const void* p, std::size_t alignment)
+{
+   return reinterpret_cast<std::uintptr_t>(p) % alignment == 0;
+}
+
+
+void testArenaAllocate()
+{
+   {
+      const std::string caseLabel = "Arena::allocate";
+
+      Arena arena{1024};
+      void* a = arena.allocate(16, 8);
+      void* b = arena.allocate(16, 8);
+      VERIFY(a != nullptr && b != nullptr, caseLabel);
+      // Consecutive allocations are adjacent.
+      VERIFY(static_cast<std::byte*>(b) - static_cast<std::byte*>(a) == 16, caseLabel);
+      VERIFY(arena.capacity() == 1024, caseLabel);
+   }
+   {
+      const std::string caseLabel = "Arena::allocate with alignment";
+
+      Arena arena{1024};
+      skip(arena, 1, 1);
+      for (const std::size_t alignment : {2, 4, 8, 16, 64})
+      {
+         VERIFY(isAligned(arena.allocate(3, alignment), alignment), caseLabel);
+         skip(arena, 1, 1);
+      }
+   }
+   {
+      const std::string caseLabel = "Arena::allocate when block is full";
+
+      Arena arena{64};
+      void* a = arena.allocate(48, 8);
+      void* b = arena.allocate(48, 8);
+      VERIFY(a != b, caseLabel);
+      VERIFY(arena.capacity() == 128, caseLabel);
+   }
+   {
+      const std::string caseLabel = "Arena::allocate larger than block size";
+
+      Arena arena{64};
+      void* p = arena.allocate(1000, 16);
+      VERIFY(p != nullptr && isAligned(p, 16), caseLabel);
+      VERIFY(arena.capacity() >= 1000, caseLabel);
+   }
+}
+
+
+void testArenaRewind()
+{
+   {
+      const std::string caseLabel = "Arena::rewind";
+
+      Arena arena{1024};
+      skip(arena, 16, 8);
+      const Arena::Mark mark = arena.mark();
+      void* a = arena.allocate(32, 8);
+      arena.rewind(mark);
+      void* b = arena.allocate(32, 8);
+      // Memory after the mark is reused.
+      VERIFY(a == b, caseLabel);
+   }
+   {
+      const std::string caseLabel = "Arena::rewind keeps blocks";
+
+      Arena arena{64};
+      void* first = arena.allocate(48, 8);
+      skip(arena, 48, 8);
+      skip(arena, 48, 8);
+      const std::size_t cap = arena.capacity();
+
+      arena.reset();
+      VERIFY(arena.allocate(48, 8) == first, caseLabel);
+      skip(arena, 48, 8);
+      skip(arena, 48, 8);
+      VERIFY(arena.capacity() == cap, caseLabel);
+   }
+   {
+      const std::string caseLabel = "ArenaScope";
+
+      Arena arena{1024};
+      void* outer = nullptr;
+      {
+         ArenaScope scope{arena};
+         outer = arena.allocate(16, 8);
+         {
+            ArenaScope nested{arena};
+            skip(arena, 16, 8);
+         }
+         // Nested scope only releases its own allocations.
+         VERIFY(static_cast<std::byte*>(arena.allocate(16, 8)) -
+                      static_cast<std::byte*>(outer) ==
+                   16,
+                caseLabel);
+      }
+      VERIFY(arena.allocate(16, 8) == outer, caseLabel);
+   }
+}
+
+
+void testArenaPmr()
+{
+   {
+      const std::string caseLabel = "Arena as memory resource for pmr containers";
+
+      Arena arena;
+      ArenaScope scope{arena};
+      std::pmr::vector<int> values{&arena};
+      for (int i = 0; i < 1000; ++i)
+         values.push_back(i);
+
+      VERIFY(values.size() == 1000, caseLabel);
+      VERIFY(values.front() == 0 && values.back() == 999, caseLabel);
+      VERIFY(values.get_allocator().resource() == &arena, caseLabel);
+   }
+   {
+      const std::string caseLabel = "threadArena";
+
+      Arena* mainArena = &threadArena();
+      Arena* otherArena = nullptr;
+      std::thread t{[&otherArena]() { otherArena = &threadArena(); }};
+      t.join();
+
+      VERIFY(&threadArena() == mainArena, caseLabel);
+      VERIFY(otherArena != mainArena, caseLabel);
+   }
+}
+
+} // namespace
+
+
+///////////////////
+
+void testArena()
+{
+   testArenaAllocate();
+   testArenaRewind();
+   testArenaPmr();
+}
@@ -0,0 +1,176 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "attack_tables_tests.h"
+#include "attack_tables.h"
+#include "test_util.h"
+#include <initializer_list>
+
+
+namespace
+{
+///////////////////
+
+Bitboard makeBitboard(std::initializer_list<Square> squares)
+{
+   Bitboard bb = EmptyBB;
+   for (const Square sq : squares)
+      bb |= bit(sq);
+   return bb;
+}
+
+
+///////////////////
+
+void testKingAttacks()
+{
+   {
+      const std::string caseLabel = "kingAttacks";
+
+      VERIFY(kingAttacks("e4"_sq) == makeBitboard({"d3"_sq, "e3"_sq, "f3"_sq, "d4"_sq,
+                                                   "f4"_sq, "d5"_sq, "e5"_sq, "f5"_sq}),
+             caseLabel);
+      VERIFY(kingAttacks("a1"_sq) == makeBitboard({"a2"_sq, "b1"_sq, "b2"_sq}),
+             caseLabel);
+      VERIFY(popcount(kingAttacks("h5"_sq)) == 5, caseLabel);
+   }
+}
+
+
+void testKnightAttacks()
+{
+   {
+      const std::string caseLabel = "knightAttacks";
+
+      VERIFY(knightAttacks("d4"_sq) == makeBitboard({"c2"_sq, "e2"_sq, "b3"_sq, "f3"_sq,
+                                                     "b5"_sq, "f5"_sq, "c6"_sq, "e6"_sq}),
+             caseLabel);
+      VERIFY(knightAttacks("h8"_sq) == makeBitboard({"g6"_sq, "f7"_sq}), caseLabel);
+   }
+}
+
+
+void testPawnAttacks()
+{
+   {
+      const std::string caseLabel = "pawnAttacks";
+
+      VERIFY(pawnAttacks(Color::White, "e4"_sq) == makeBitboard({"d5"_sq, "f5"_sq}),
+             caseLabel);
+      VERIFY(pawnAttacks(Color::Black, "e4"_sq) == makeBitboard({"d3"_sq, "f3"_sq}),
+             caseLabel);
+      VERIFY(pawnAttacks(Color::White, "a2"_sq) == makeBitboard({"b3"_sq}), caseLabel);
+      VERIFY(pawnAttacks(Color::Black, "h7"_sq) == makeBitboard({"g6"_sq}), caseLabel);
+      VERIFY(pawnAttacks(Color::White, "c8"_sq) == EmptyBB, caseLabel);
+   }
+}
+
+
+void testSlidingAttacks()
+{
+   {
+      const std::string caseLabel = "rookAttacks";
+
+      const Bitboard occupied = makeBitboard({"e4"_sq, "e6"_sq, "c4"_sq, "e2"_sq});
+      VERIFY(rookAttacks("e4"_sq, occupied) ==
+                makeBitboard({"e5"_sq, "e6"_sq, "e3"_sq, "e2"_sq, "d4"_sq, "c4"_sq,
+                              "f4"_sq, "g4"_sq, "h4"_sq}),
+             caseLabel);
+      VERIFY(popcount(rookAttacks("a1"_sq, EmptyBB)) == 14, caseLabel);
+   }
+   {
+      const std::string caseLabel = "bishopAttacks";
+
+      const Bitboard occupied = makeBitboard({"c1"_sq, "e3"_sq, "a3"_sq});
+      VERIFY(bishopAttacks("c1"_sq, occupied) ==
+                makeBitboard({"b2"_sq, "a3"_sq, "d2"_sq, "e3"_sq}),
+             caseLabel);
+      VERIFY(popcount(bishopAttacks("d4"_sq, EmptyBB)) == 13, caseLabel);
+   }
+   {
+      const std::string caseLabel = "Sliding attacks are usable at compile time";
+
+      static_assert(rookAttacks("a1"_sq, bit("a2"_sq) | bit("b1"_sq)) ==
+                    (bit("a2"_sq) | bit("b1"_sq)));
+   }
+}
+
+
+void testBetween()
+{
+   {
+      const std::string caseLabel = "between for squares on common line";
+
+      VERIFY(between("a1"_sq, "a4"_sq) == makeBitboard({"a2"_sq, "a3"_sq}), caseLabel);
+      VERIFY(between("a4"_sq, "a1"_sq) == makeBitboard({"a2"_sq, "a3"_sq}), caseLabel);
+      VERIFY(between("b2"_sq, "e5"_sq) == makeBitboard({"c3"_sq, "d4"_sq}), caseLabel);
+      VERIFY(between("h1"_sq, "a8"_sq) ==
+                makeBitboard({"g2"_sq, "f3"_sq, "e4"_sq, "d5"_sq, "c6"_sq, "b7"_sq}),
+             caseLabel);
+      VERIFY(between("c3"_sq, "d3"_sq) == EmptyBB, caseLabel);
+   }
+   {
+      const std::string caseLabel = "between for squares not on common line";
+
+      VERIFY(between("a1"_sq, "b3"_sq) == EmptyBB, caseLabel);
+      VERIFY(between("e4"_sq, "e4"_sq) == EmptyBB, caseLabel);
+   }
+}
+
+
+void testLine()
+{
+   {
+      const std::string caseLabel = "line";
+
+      VERIFY(line("c3"_sq, "e5"_sq) == line("a1"_sq, "h8"_sq), caseLabel);
+      VERIFY(popcount(line("a1"_sq, "h8"_sq)) == 8, caseLabel);
+      VERIFY(line("b4"_sq, "g4"_sq) ==
+                makeBitboard({"a4"_sq, "b4"_sq, "c4"_sq, "d4"_sq, "e4"_sq, "f4"_sq,
+                              "g4"_sq, "h4"_sq}),
+             caseLabel);
+      VERIFY(line("a1"_sq, "b3"_sq) == EmptyBB, caseLabel);
+   }
+}
+
+
+void testDistances()
+{
+   {
+      const std::string caseLabel = "chebyshevDistance";
+
+      VERIFY(chebyshevDistance("a1"_sq, "h8"_sq) == 7, caseLabel);
+      VERIFY(chebyshevDistance("e4"_sq, "f6"_sq) == 2, caseLabel);
+      VERIFY(chebyshevDistance("e4"_sq, "e4"_sq) == 0, caseLabel);
+   }
+   {
+      const std::string caseLabel = "manhattanDistance";
+
+      VERIFY(manhattanDistance("a1"_sq, "h8"_sq) == 14, caseLabel);
+      VERIFY(manhattanDistance("e4"_sq, "f6"_sq) == 3, caseLabel);
+      VERIFY(manhattanDistance("e4"_sq, "e4"_sq) == 0, caseLabel);
+   }
+   {
+      const std::string caseLabel = "Tables are usable at compile time";
+
+      static_assert(chebyshevDistance("b2"_sq, "g4"_sq) == 5);
+      static_assert(knightAttacks("a1"_sq) == (bit("b3"_sq) | bit("c2"_sq)));
+   }
+}
+
+} // namespace
+
+
+///////////////////
+
+void testAttackTables()
+{
+   testKingAttacks();
+   testKnightAttacks();
+   testPawnAttacks();
+   testSlidingAttacks();
+   testBetween();
+   testLine();
+   testDistances();
+}
@@ -0,0 +1,169 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "batch_tests.h"
+#include "batch.h"
+#include "evaluation.h"
+#include "nnue.h"
+#include "test_util.h"
+#include "tt.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+
+namespace
+{
+///////////////////
+
+BatchJob makeJob(std::string_view pos, Color side, std::size_t plies)
+{
+   BatchJob job{Position{pos}, side, {}};
+   job.limits.plies = plies;
+   return job;
+}
+
+
+std::vector<BatchJob> makeJobs()
+{
+   return {makeJob("Kwa1 Rwh1 Qbb2 Kba8", Color::White, 3),
+           makeJob("Kwd3 wf4 Kbb2 bh7", Color::White, 3),
+           makeJob("Kwg1 Rwa1 wf2 wg2 wh2 Kbg8 Rbe8 bf7 bg7 bh7", Color::Black, 2),
+           makeJob("Kwd3", Color::Black, 2),
+           makeJob("Kwe6 we5 Kbe8", Color::White, 4)};
+}
+
+
+std::shared_ptr<const Network> makeNetwork()
+{
+   NetworkWeights weights;
+   weights.hiddenSize = 16;
+   weights.layerSize = 4;
+   for (std::size_t i = 0; i < Network::NumFeatures * weights.hiddenSize; ++i)
+      weights.featureWeights.push_back(static_cast<std::int16_t>(i * 7 % 17) - 8);
+   weights.featureBiases.assign(weights.hiddenSize, 40);
+   for (std::size_t i = 0; i < weights.layerSize * weights.hiddenSize; ++i)
+      weights.layerWeights.push_back(static_cast<std::int8_t>(i * 5 % 11) - 5);
+   weights.layerBiases.assign(weights.layerSize, 100);
+   weights.outputWeights = {3, -2, 5, -1};
+   weights.outputScale = 0.01f;
+   return std::make_shared<const Network>(*Network::make(weights));
+}
+
+
+void verifySingleSearches(const std::vector<BatchJob>& jobs,
+                          const std::vector<SearchResult>& results,
+                          const std::string& caseLabel)
+{
+   VERIFY(results.size() == jobs.size(), caseLabel);
+
+   for (std::size_t i = 0; i < std::min(jobs.size(), results.size()); ++i)
+   {
+      TranspositionTable tt{1};
+      const std::atomic<bool> stop{false};
+      SearchLimits limits = jobs[i].limits;
+      limits.isParallel = false;
+      const SearchResult expected = search(jobs[i].pos, jobs[i].side, limits, tt, stop);
+
+      VERIFY(results[i].depth == expected.depth, caseLabel);
+      VERIFY(results[i].score == expected.score, caseLabel);
+      VERIFY(results[i].pv == expected.pv, caseLabel);
+   }
+}
+
+
+void testSearchBatch()
+{
+   {
+      const std::string caseLabel = "searchBatch matches single searches";
+
+      const std::vector<BatchJob> jobs = makeJobs();
+      verifySingleSearches(jobs, searchBatch(jobs, BatchOptions{3}), caseLabel);
+   }
+   {
+      const std::string caseLabel = "searchBatch with material and positional jobs";
+
+      // One worker runs the jobs one after another on the same position, so that
+      // scores cached for one evaluation would be found by the other.
+      BatchJob material = makeJob("Kwa1 Rwh1 Qbb2 Kba8", Color::White, 3);
+      BatchJob positional = material;
+      positional.limits.evaluation = [](const Position& p) {
+         return evaluatePosition(p);
+      };
+
+      const std::vector<BatchJob> jobs = {material, positional, material};
+      const std::vector<SearchResult> results = searchBatch(jobs, BatchOptions{1});
+      verifySingleSearches(jobs, results, caseLabel);
+      VERIFY(results.size() == 3 && results[0].score != results[1].score, caseLabel);
+   }
+   {
+      const std::string caseLabel = "searchBatch with and without network";
+
+      BatchJob material = makeJob("Kwe1 Rwh1 Nwb1 we4 Kbe8 Qbd8 bd5", Color::White, 3);
+      BatchJob network = material;
+      network.limits.network = makeNetwork();
+
+      const std::vector<BatchJob> jobs = {material, network, material};
+      const std::vector<SearchResult> results = searchBatch(jobs, BatchOptions{1});
+      verifySingleSearches(jobs, results, caseLabel);
+      VERIFY(results.size() == 3 && results[0].score != results[1].score, caseLabel);
+   }
+   {
+      const std::string caseLabel = "searchBatch reports each result";
+
+      const std::vector<BatchJob> jobs = makeJobs();
+      std::vector<int> reported(jobs.size(), 0);
+      std::vector<std::vector<Move>> reportedPvs(jobs.size());
+      const auto onResult = [&](std::size_t idx, const SearchResult& result) {
+         ++reported[idx];
+         reportedPvs[idx] = result.pv;
+      };
+      const std::vector<SearchResult> results =
+         searchBatch(jobs, BatchOptions{2}, onResult);
+
+      VERIFY(std::all_of(std::begin(reported), std::end(reported),
+                         [](int count) { return count == 1; }),
+             caseLabel);
+      for (std::size_t i = 0; i < std::min(jobs.size(), results.size()); ++i)
+         VERIFY(reportedPvs[i] == results[i].pv, caseLabel);
+   }
+   {
+      const std::string caseLabel = "searchBatch with more workers than jobs";
+
+      const std::vector<SearchResult> results =
+         searchBatch({makeJob("Kwa1 Rwh1 Qbb2 Kba8", Color::White, 2)}, BatchOptions{8});
+      VERIFY(results.size() == 1 && results[0].bestMove().has_value(), caseLabel);
+   }
+   {
+      const std::string caseLabel = "searchBatch when cancelled";
+
+      const std::atomic<bool> cancel{true};
+      BatchOptions options;
+      options.numWorkers = 2;
+      options.cancel = &cancel;
+      const std::vector<SearchResult> results = searchBatch(makeJobs(), options);
+
+      VERIFY(results.size() == makeJobs().size(), caseLabel);
+      VERIFY(std::none_of(std::begin(results), std::end(results),
+                          [](const SearchResult& result) { return result.depth > 0; }),
+             caseLabel);
+   }
+   {
+      const std::string caseLabel = "searchBatch without jobs";
+
+      VERIFY(searchBatch({}, BatchOptions{}).empty(), caseLabel);
+   }
+}
+
+} // namespace
+
+
+///////////////////
+
+void testBatch()
+{
+   testSearchBatch();
+}
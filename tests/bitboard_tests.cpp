@@ -0,0 +1,113 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "bitboard_tests.h"
+#include "bitboard.h"
+#include "test_util.h"
+#include <vector>
+
+
+namespace
+{
+///////////////////
+
+void testBit()
+{
+   {
+      const std::string caseLabel = "bit";
+
+      VERIFY(bit("a1"_sq) == 1, caseLabel);
+      VERIFY(bit("b1"_sq) == 2, caseLabel);
+      VERIFY(bit("h8"_sq) == Bitboard{1} << 63, caseLabel);
+      VERIFY(bit(Square()) == EmptyBB, caseLabel);
+   }
+}
+
+
+void testIsSet()
+{
+   {
+      const std::string caseLabel = "isSet";
+
+      const Bitboard bb = bit("c3"_sq) | bit("h7"_sq);
+      VERIFY(isSet(bb, "c3"_sq), caseLabel);
+      VERIFY(isSet(bb, "h7"_sq), caseLabel);
+      VERIFY(!isSet(bb, "c4"_sq), caseLabel);
+      VERIFY(!isSet(EmptyBB, "a1"_sq), caseLabel);
+   }
+}
+
+
+void testPopcount()
+{
+   {
+      const std::string caseLabel = "popcount";
+
+      VERIFY(popcount(EmptyBB) == 0, caseLabel);
+      VERIFY(popcount(bit("e4"_sq)) == 1, caseLabel);
+      VERIFY(popcount(bit("a1"_sq) | bit("h8"_sq) | bit("d5"_sq)) == 3, caseLabel);
+      VERIFY(popcount(~EmptyBB) == 64, caseLabel);
+   }
+}
+
+
+void testLsb()
+{
+   {
+      const std::string caseLabel = "lsb";
+
+      VERIFY(lsb(bit("a1"_sq)) == "a1"_sq, caseLabel);
+      VERIFY(lsb(bit("h8"_sq)) == "h8"_sq, caseLabel);
+      VERIFY(lsb(bit("d5"_sq) | bit("f7"_sq)) == "d5"_sq, caseLabel);
+   }
+}
+
+
+void testPopLsb()
+{
+   {
+      const std::string caseLabel = "popLsb";
+
+      Bitboard bb = bit("d5"_sq) | bit("f7"_sq);
+      VERIFY(popLsb(bb) == "d5"_sq, caseLabel);
+      VERIFY(bb == bit("f7"_sq), caseLabel);
+      VERIFY(popLsb(bb) == "f7"_sq, caseLabel);
+      VERIFY(bb == EmptyBB, caseLabel);
+   }
+}
+
+
+void testForEachSquare()
+{
+   {
+      const std::string caseLabel = "forEachSquare";
+
+      std::vector<Square> squares;
+      forEachSquare(bit("h2"_sq) | bit("b1"_sq) | bit("c8"_sq),
+                    [&squares](Square sq) { squares.push_back(sq); });
+      VERIFY(squares == std::vector<Square>({"b1"_sq, "h2"_sq, "c8"_sq}), caseLabel);
+   }
+   {
+      const std::string caseLabel = "forEachSquare for empty bitboard";
+
+      int count = 0;
+      forEachSquare(EmptyBB, [&count](Square) { ++count; });
+      VERIFY(count == 0, caseLabel);
+   }
+}
+
+} // namespace
+
+
+///////////////////
+
+void testBitboard()
+{
+   testBit();
+   testIsSet();
+   testPopcount();
+   testLsb();
+   testPopLsb();
+   testForEachSquare();
+}
@@ -0,0 +1,253 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "book_tests.h"
+#include "book.h"
+#include "fen.h"
+#include "pgn.h"
+#include "position.h"
+#include "test_util.h"
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace
+{
+///////////////////
+
+FenPosition startPosition()
+{
+   return *readFen(StartFen);
+}
+
+
+Move startMove(std::string_view from, std::string_view to)
+{
+   const Position pos = startPosition().pos;
+   return Move{*pos[Square{from}], Square{to}, pos};
+}
+
+
+// Plays moves in coordinate notation from the initial position.
+FenPosition playMoves(const std::vector<std::string_view>& moves)
+{
+   FenPosition fen = startPosition();
+   for (const std::string_view move : moves)
+   {
+      const Square from{move.substr(0, 2)};
+      fen = makeMove(fen, Move{*fen.pos[from], Square{move.substr(2, 2)}, fen.pos});
+   }
+   return fen;
+}
+
+
+///////////////////
+
+void testBookKey()
+{
+   {
+      const std::string caseLabel = "bookKey for reference positions of Polyglot";
+
+      VERIFY(bookKey(startPosition()) == 0x463b96181691fc9c, caseLabel);
+      VERIFY(bookKey(playMoves({"e2e4"})) == 0x823c9b50fd114196, caseLabel);
+      VERIFY(bookKey(playMoves({"e2e4", "d7d5"})) == 0x0756b94461c50fb0, caseLabel);
+      VERIFY(bookKey(playMoves({"e2e4", "d7d5", "e4e5"})) == 0x662fafb965db29d4,
+             caseLabel);
+      // En passant is possible.
+      VERIFY(bookKey(playMoves({"e2e4", "d7d5", "e4e5", "f7f5"})) == 0x22a48b5a8e47ff78,
+             caseLabel);
+      // Castling rights are lost.
+      VERIFY(bookKey(playMoves({"e2e4", "d7d5", "e4e5", "f7f5", "e1e2"})) ==
+                0x652a607ca3f242c1,
+             caseLabel);
+      VERIFY(bookKey(playMoves({"e2e4", "d7d5", "e4e5", "f7f5", "e1e2", "e8f7"})) ==
+                0x00fdd303c946bdd9,
+             caseLabel);
+      VERIFY(bookKey(playMoves({"a2a4", "b7b5", "h2h4", "b5b4", "c2c4"})) ==
+                0x3c8123ea7b067637,
+             caseLabel);
+      VERIFY(bookKey(playMoves({"a2a4", "b7b5", "h2h4", "b5b4", "c2c4", "b4c3",
+                                "a1a3"})) == 0x5c3f9b829b279560,
+             caseLabel);
+   }
+   {
+      const std::string caseLabel = "bookKey for FEN positions";
+
+      VERIFY(bookKey(*readFen("rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq "
+                              "f6 0 3")) == 0x22a48b5a8e47ff78,
+             caseLabel);
+      // No pawn can capture en passant, so the square does not change the key.
+      VERIFY(bookKey(*readFen("rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq e3 "
+                              "0 1")) == 0x823c9b50fd114196,
+             caseLabel);
+   }
+}
+
+
+///////////////////
+
+void testBookMoveEncoding()
+{
+   {
+      const std::string caseLabel = "encodeBookMove for regular move";
+
+      const Position pos = startPosition().pos;
+      // Target e4 (28) in the low bits and start e2 (12) above it.
+      VERIFY(encodeBookMove(startMove("e2", "e4"), pos) == (12 << 6 | 28), caseLabel);
+   }
+   {
+      const std::string caseLabel = "encodeBookMove and decodeBookMove for promotion";
+
+      const Position pos{"Kwe1 wb7 Kbe8"};
+      const Move move{Piece{"wb7"}, Square{"b8"}, Figure::Rook, pos};
+      const std::uint16_t code = encodeBookMove(move, pos);
+      VERIFY(code >> 12 == 3, caseLabel);
+
+      const auto decoded = decodeBookMove(code, pos, Color::White);
+      VERIFY(decoded.has_value() && *decoded == move, caseLabel);
+   }
+   {
+      const std::string caseLabel = "encodeBookMove and decodeBookMove for castling";
+
+      const Position pos{"Kwe1 Rwh1 Rwa1 Kbe8"};
+      const Move kingside{Piece{"Kwe1"}, Square{"g1"}, pos};
+      const std::uint16_t code = encodeBookMove(kingside, pos);
+      // Encoded as the king moving onto the rook.
+      VERIFY((code & 0x3F) == Square{"h1"}.index(), caseLabel);
+
+      const auto decoded = decodeBookMove(code, pos, Color::White);
+      VERIFY(decoded.has_value() && decoded->to() == Square{"g1"}, caseLabel);
+      VERIFY(decoded.has_value() && decoded->notate() == "O-O", caseLabel);
+
+      const Move queenside{Piece{"Kwe1"}, Square{"c1"}, pos};
+      const auto decodedQueenside =
+         decodeBookMove(encodeBookMove(queenside, pos), pos, Color::White);
+      VERIFY(decodedQueenside.has_value() && decodedQueenside->to() == Square{"c1"},
+             caseLabel);
+   }
+   {
+      const std::string caseLabel = "decodeBookMove for move that does not fit position";
+
+      const Position pos = startPosition().pos;
+      const std::uint16_t code = encodeBookMove(startMove("e2", "e4"), pos);
+      VERIFY(!decodeBookMove(code, pos, Color::Black).has_value(), caseLabel);
+      VERIFY(!decodeBookMove(code, Position{"Kwe1 Kbe8"}, Color::White).has_value(),
+             caseLabel);
+      // Pawn cannot move three squares.
+      VERIFY(!decodeBookMove(12 << 6 | 36, pos, Color::White).has_value(), caseLabel);
+   }
+}
+
+
+void testBookBuilderAndOpeningBook()
+{
+   {
+      const std::string caseLabel = "OpeningBook::moves ordered by weight";
+
+      const auto path = tempPath("matt_book_moves.bin");
+      const FenPosition start = startPosition();
+      BookBuilder builder;
+      builder.add(start, startMove("d2", "d4"));
+      for (int i = 0; i < 3; ++i)
+         builder.add(start, startMove("e2", "e4"));
+      VERIFY(builder.size() == 2, caseLabel);
+      VERIFY(builder.write(path), caseLabel);
+
+      const std::optional<OpeningBook> book = OpeningBook::open(path);
+      VERIFY(book.has_value(), caseLabel);
+      if (book.has_value())
+      {
+         VERIFY(book->size() == 2, caseLabel);
+         const std::vector<BookMove> moves = book->moves(start);
+         VERIFY(moves.size() == 2, caseLabel);
+         if (moves.size() == 2)
+         {
+            VERIFY(moves[0].move == startMove("e2", "e4"), caseLabel);
+            VERIFY(moves[0].weight == 3, caseLabel);
+            VERIFY(moves[1].move == startMove("d2", "d4"), caseLabel);
+            VERIFY(moves[1].weight == 1, caseLabel);
+         }
+         // Same pieces with other side to move or without castling rights.
+         FenPosition other = start;
+         other.side = Color::Black;
+         VERIFY(book->moves(other).empty(), caseLabel);
+         other = start;
+         other.castling = Castling::None;
+         VERIFY(book->moves(other).empty(), caseLabel);
+      }
+      std::filesystem::remove(path);
+   }
+   {
+      const std::string caseLabel = "OpeningBook::pickMove by weight";
+
+      const auto path = tempPath("matt_book_pick.bin");
+      const FenPosition start = startPosition();
+      BookBuilder builder;
+      builder.add(start, startMove("d2", "d4"));
+      for (int i = 0; i < 3; ++i)
+         builder.add(start, startMove("e2", "e4"));
+      builder.write(path);
+
+      const std::optional<OpeningBook> book = OpeningBook::open(path);
+      if (book.has_value())
+      {
+         VERIFY(book->pickMove(start, 0) == startMove("e2", "e4"), caseLabel);
+         VERIFY(book->pickMove(start, 2) == startMove("e2", "e4"), caseLabel);
+         VERIFY(book->pickMove(start, 3) == startMove("d2", "d4"), caseLabel);
+         VERIFY(book->pickMove(start, 7) == startMove("d2", "d4"), caseLabel);
+         FenPosition kings;
+         kings.pos = Position{"Kwe1 Kbe8"};
+         VERIFY(!book->pickMove(kings, 0).has_value(), caseLabel);
+      }
+      std::filesystem::remove(path);
+   }
+   {
+      const std::string caseLabel = "BookBuilder::add for games";
+
+      const auto path = tempPath("matt_book_games.bin");
+      PgnReader reader{std::string_view{"1. e4 e5 2. Nf3 Nc6 *\n\n1. e4 c5 *\n"}};
+      PgnGame game;
+      BookBuilder builder{3};
+      while (reader.next(game))
+         builder.add(game);
+      // e4 twice, e5, Nf3 and c5.
+      VERIFY(builder.size() == 4, caseLabel);
+      builder.write(path);
+
+      const std::optional<OpeningBook> book = OpeningBook::open(path);
+      if (book.has_value())
+      {
+         const std::vector<BookMove> white = book->moves(startPosition());
+         VERIFY(white.size() == 1 && white[0].weight == 2, caseLabel);
+         VERIFY(book->moves(playMoves({"e2e4"})).size() == 2, caseLabel);
+      }
+      std::filesystem::remove(path);
+   }
+   {
+      const std::string caseLabel = "OpeningBook::open for file with partial entry";
+
+      const auto path = tempPath("matt_book_partial.bin");
+      {
+         std::ofstream out{path, std::ios::binary};
+         out << "not a book";
+      }
+      VERIFY(!OpeningBook::open(path).has_value(), caseLabel);
+      std::filesystem::remove(path);
+   }
+}
+
+} // namespace
+
+
+///////////////////
+
+void testBook()
+{
+   testBookKey();
+   testBookMoveEncoding();
+   testBookBuilderAndOpeningBook();
+}
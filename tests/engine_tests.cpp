@@ -0,0 +1,351 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "engine_tests.h"
+#include "engine.h"
+#include "fen.h"
+#include "test_util.h"
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+
+namespace
+{
+///////////////////
+
+// Counts the callbacks of a search.
+struct Reports
+{
+   std::atomic<int> iterations{0};
+   std::atomic<int> results{0};
+   std::atomic<std::size_t> depth{0};
+   // Set before the result count changes.
+
+   SearchCallback onIteration()
+   {
+      return [this](const SearchResult&) { ++iterations; };
+   }
+   SearchCallback onResult()
+   {
+      return [this](const SearchResult& result) {
+         depth = result.depth;
+         if (result.bestMove().has_value())
+            bestTo = result.bestMove()->to();
+         ++results;
+      };
+   }
+
+   Square bestTo;
+};
+
+
+///////////////////
+
+void testEngineGo()
+{
+   {
+      const std::string caseLabel = "Engine::go with depth limit";
+
+      Engine engine{1};
+      Reports reports;
+      SearchRequest request;
+      request.limits.plies = 3;
+      engine.go(Position{"Kwd3 wf4 Kbb2"}, Color::White, request, reports.onIteration(),
+                reports.onResult());
+      engine.wait();
+
+      VERIFY(!engine.isSearching(), caseLabel);
+      VERIFY(reports.iterations == 3, caseLabel);
+      VERIFY(reports.results == 1, caseLabel);
+      VERIFY(reports.depth == 3, caseLabel);
+   }
+   {
+      const std::string caseLabel = "Engine::go with move time";
+
+      Engine engine{1};
+      Reports reports;
+      SearchRequest request;
+      request.time = TimeLimits{20ms, 20ms};
+      engine.go(Position{"Kwd3 wf4 Kbb2"}, Color::White, request, reports.onIteration(),
+                reports.onResult());
+      engine.wait();
+
+      VERIFY(reports.results == 1, caseLabel);
+      VERIFY(reports.depth >= 1, caseLabel);
+   }
+   {
+      const std::string caseLabel = "Engine::go with time limits for only move";
+
+      Engine engine{1};
+      Reports reports;
+      SearchRequest request;
+      request.time = TimeLimits{10s, 20s};
+      engine.go(Position{"Kwa1 Kbc2"}, Color::White, request, reports.onIteration(),
+                reports.onResult());
+      engine.wait();
+
+      VERIFY(reports.results == 1, caseLabel);
+      VERIFY(reports.iterations == 1, caseLabel);
+   }
+   {
+      const std::string caseLabel = "Engine::go stops running search";
+
+      Engine engine{1};
+      Reports first;
+      SearchRequest infinite;
+      infinite.infinite = true;
+      engine.go(Position{"Kwd3 wf4 Kbb2"}, Color::White, infinite, {}, first.onResult());
+
+      Reports second;
+      SearchRequest request;
+      request.limits.plies = 2;
+      engine.go(Position{"Kwd3 wf4 Kbb2"}, Color::Black, request, {}, second.onResult());
+      engine.wait();
+
+      VERIFY(first.results == 1, caseLabel);
+      VERIFY(second.results == 1, caseLabel);
+      VERIFY(second.depth == 2, caseLabel);
+   }
+}
+
+
+void testEngineStop()
+{
+   {
+      const std::string caseLabel = "Engine::stop for infinite search";
+
+      Engine engine{1};
+      Reports reports;
+      SearchRequest request;
+      request.infinite = true;
+      engine.go(Position{"Kwd3 wf4 Kbb2"}, Color::White, request, {}, reports.onResult());
+      std::this_thread::sleep_for(10ms);
+      VERIFY(engine.isSearching(), caseLabel);
+
+      engine.stop();
+      engine.wait();
+      VERIFY(!engine.isSearching(), caseLabel);
+      VERIFY(reports.results == 1, caseLabel);
+      VERIFY(reports.depth >= 1, caseLabel);
+   }
+   {
+      const std::string caseLabel =
+         "Engine holds back result of infinite search until stopped";
+
+      Engine engine{1};
+      Reports reports;
+      SearchRequest request;
+      request.limits.plies = 1;
+      request.infinite = true;
+      engine.go(Position{"Kwd3 wf4 Kbb2"}, Color::White, request, reports.onIteration(),
+                reports.onResult());
+      std::this_thread::sleep_for(20ms);
+      VERIFY(reports.iterations == 1, caseLabel);
+      VERIFY(reports.results == 0, caseLabel);
+
+      engine.stop();
+      engine.wait();
+      VERIFY(reports.results == 1, caseLabel);
+   }
+}
+
+
+void testEnginePonderhit()
+{
+   {
+      const std::string caseLabel = "Engine::ponderhit converts ponder search";
+
+      Engine engine{1};
+      Reports reports;
+      SearchRequest request;
+      request.limits.plies = 1;
+      request.ponder = true;
+      engine.go(Position{"Kwd3 wf4 Kbb2"}, Color::White, request, {}, reports.onResult());
+      std::this_thread::sleep_for(20ms);
+      VERIFY(reports.results == 0, caseLabel);
+
+      engine.ponderhit();
+      engine.wait();
+      VERIFY(reports.results == 1, caseLabel);
+   }
+   {
+      const std::string caseLabel = "Engine::ponderhit starts move time";
+
+      Engine engine{1};
+      Reports reports;
+      SearchRequest request;
+      request.time = TimeLimits{10ms, 10ms};
+      request.ponder = true;
+      engine.go(Position{"Kwd3 wf4 Kbb2"}, Color::White, request, {}, reports.onResult());
+      std::this_thread::sleep_for(30ms);
+      VERIFY(engine.isSearching(), caseLabel);
+
+      engine.ponderhit();
+      engine.wait();
+      VERIFY(reports.results == 1, caseLabel);
+   }
+}
+
+
+void testEnginePonder()
+{
+   const Position pos{"Kwd3 wf4 Kbb2"};
+   const Move predicted{Piece{"Kbb2"}, Square{"b3"}, pos};
+
+   {
+      const std::string caseLabel = "Engine::ponder for predicted reply";
+
+      Engine engine{1};
+      SearchRequest ponderRequest;
+      ponderRequest.limits.plies = 1;
+      engine.ponder(pos, Color::White, predicted, ponderRequest);
+      std::this_thread::sleep_for(10ms);
+      VERIFY(engine.isSearching(), caseLabel);
+
+      // The converted ponder search reported its iteration before the call.
+      Reports reports;
+      engine.go(pos.makeMove(predicted), Color::White, ponderRequest,
+                reports.onIteration(), reports.onResult());
+      engine.wait();
+
+      VERIFY(reports.results == 1, caseLabel);
+      VERIFY(reports.iterations == 0, caseLabel);
+      VERIFY(reports.depth == 1, caseLabel);
+   }
+   {
+      const std::string caseLabel = "Engine::ponder with other limits";
+
+      Engine engine{1};
+      SearchRequest ponderRequest;
+      ponderRequest.limits.plies = 1;
+      engine.ponder(pos, Color::White, predicted, ponderRequest);
+      std::this_thread::sleep_for(10ms);
+
+      // Restarts with the new limits.
+      Reports reports;
+      SearchRequest request;
+      request.limits.plies = 4;
+      engine.go(pos.makeMove(predicted), Color::White, request, reports.onIteration(),
+                reports.onResult());
+      engine.wait();
+
+      VERIFY(reports.results == 1, caseLabel);
+      VERIFY(reports.iterations == 4, caseLabel);
+      VERIFY(reports.depth == 4, caseLabel);
+   }
+   {
+      const std::string caseLabel = "Engine::ponder for other reply";
+
+      Engine engine{1};
+      SearchRequest ponderRequest;
+      ponderRequest.limits.plies = 1;
+      engine.ponder(pos, Color::White, predicted, ponderRequest);
+
+      Reports reports;
+      SearchRequest request;
+      request.limits.plies = 2;
+      const Move played{Piece{"Kbb2"}, Square{"c2"}, pos};
+      engine.go(pos.makeMove(played), Color::White, request, reports.onIteration(),
+                reports.onResult());
+      engine.wait();
+
+      VERIFY(reports.results == 1, caseLabel);
+      VERIFY(reports.iterations == 2, caseLabel);
+      VERIFY(reports.depth == 2, caseLabel);
+   }
+   {
+      const std::string caseLabel = "Engine::ponder with move time";
+
+      Engine engine{1};
+      SearchRequest request;
+      request.time = TimeLimits{10ms, 10ms};
+      engine.ponder(pos, Color::White, predicted, request);
+      std::this_thread::sleep_for(30ms);
+      VERIFY(engine.isSearching(), caseLabel);
+
+      Reports reports;
+      engine.go(pos.makeMove(predicted), Color::White, request, reports.onIteration(),
+                reports.onResult());
+      engine.wait();
+      VERIFY(reports.results == 1, caseLabel);
+   }
+}
+
+
+void testEngineSetBook()
+{
+   const auto path = tempPath("matt_engine_book.bin");
+   const FenPosition startFen = *readFen(StartFen);
+   const Position& start = startFen.pos;
+   BookBuilder builder;
+   builder.add(startFen, Move{Piece{"wc2"}, Square{"c4"}, start});
+   builder.write(path);
+
+   {
+      const std::string caseLabel = "Engine::setBook plays book move";
+
+      Engine engine{1};
+      engine.setBook(OpeningBook::open(path));
+      Reports reports;
+      SearchRequest request;
+      request.limits.plies = 3;
+      request.castling = Castling::All;
+      engine.go(start, Color::White, request, reports.onIteration(), reports.onResult());
+      engine.wait();
+
+      VERIFY(reports.results == 1, caseLabel);
+      VERIFY(reports.iterations == 0, caseLabel);
+      VERIFY(reports.depth == 0, caseLabel);
+      VERIFY(reports.bestTo == Square{"c4"}, caseLabel);
+   }
+   {
+      const std::string caseLabel = "Engine::setBook for position that is not in book";
+
+      Engine engine{1};
+      engine.setBook(OpeningBook::open(path));
+      Reports reports;
+      SearchRequest request;
+      request.limits.plies = 2;
+      engine.go(start, Color::Black, request, reports.onIteration(), reports.onResult());
+      engine.wait();
+
+      VERIFY(reports.depth == 2, caseLabel);
+   }
+   {
+      const std::string caseLabel = "Engine::setBook not used by infinite search";
+
+      Engine engine{1};
+      engine.setBook(OpeningBook::open(path));
+      Reports reports;
+      SearchRequest request;
+      request.limits.plies = 1;
+      request.castling = Castling::All;
+      request.infinite = true;
+      engine.go(start, Color::White, request, reports.onIteration(), reports.onResult());
+      engine.stop();
+      engine.wait();
+
+      VERIFY(reports.depth == 1, caseLabel);
+   }
+
+   std::filesystem::remove(path);
+}
+
+} // namespace
+
+
+///////////////////
+
+void testEngine()
+{
+   testEngineGo();
+   testEngineStop();
+   testEnginePonderhit();
+   testEnginePonder();
+   testEngineSetBook();
+}
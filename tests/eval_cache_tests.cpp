@@ -0,0 +1,86 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "eval_cache_tests.h"
+#include "eval_cache.h"
+#include "test_util.h"
+
+
+namespace
+{
+///////////////////
+
+void testEvalCacheSize()
+{
+   {
+      const std::string caseLabel = "EvalCache size is a power of two";
+
+      const EvalCache cache{3};
+      VERIFY(cache.size() > 0, caseLabel);
+      VERIFY((cache.size() & (cache.size() - 1)) == 0, caseLabel);
+   }
+   {
+      const std::string caseLabel = "EvalCache::resize";
+
+      EvalCache cache{1};
+      const std::size_t smallSize = cache.size();
+      cache.store(12345, 2.f);
+      cache.resize(2);
+      VERIFY(cache.size() == 2 * smallSize, caseLabel);
+      VERIFY(!cache.probe(12345).has_value(), caseLabel);
+   }
+}
+
+
+void testEvalCacheProbe()
+{
+   {
+      const std::string caseLabel = "EvalCache::probe for empty cache";
+
+      const EvalCache cache{1};
+      VERIFY(!cache.probe(12345).has_value(), caseLabel);
+      VERIFY(!cache.probe(0).has_value(), caseLabel);
+   }
+   {
+      const std::string caseLabel = "EvalCache::probe for stored score";
+
+      EvalCache cache{1};
+      cache.store(12345, -3.5f);
+      cache.store(0, 1.f);
+      VERIFY(cache.probe(12345) == -3.5f, caseLabel);
+      VERIFY(cache.probe(0) == 1.f, caseLabel);
+   }
+   {
+      const std::string caseLabel = "EvalCache::probe for other key in same slot";
+
+      EvalCache cache{1};
+      const HashKey key = 12345;
+      const HashKey otherKey = key + cache.size();
+      cache.store(key, 4.f);
+      VERIFY(!cache.probe(otherKey).has_value(), caseLabel);
+
+      cache.store(otherKey, 5.f);
+      VERIFY(cache.probe(otherKey) == 5.f, caseLabel);
+      VERIFY(!cache.probe(key).has_value(), caseLabel);
+   }
+   {
+      const std::string caseLabel = "EvalCache::clear";
+
+      EvalCache cache{1};
+      cache.store(12345, 4.f);
+      cache.clear();
+      VERIFY(!cache.probe(12345).has_value(), caseLabel);
+   }
+}
+
+} // namespace
+
+
+///////////////////
+
+void testEvalCache()
+{
+   testEvalCacheSize();
+   testEvalCacheProbe();
+}
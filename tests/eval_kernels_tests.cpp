@@ -0,0 +1,137 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "eval_kernels_tests.h"
+#include "eval_kernels.h"
+#include "test_util.h"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+///////////////////
+
+constexpr SimdLevel AllLevels[] = {SimdLevel::Scalar, SimdLevel::Sse41,
+                                   SimdLevel::Avx2};
+
+
+void testSimdLevel()
+{
+   {
+      const std::string caseLabel = "notateSimdLevel";
+
+      VERIFY(notateSimdLevel(SimdLevel::Scalar) == "scalar", caseLabel);
+      VERIFY(notateSimdLevel(SimdLevel::Sse41) == "sse4.1", caseLabel);
+      VERIFY(notateSimdLevel(SimdLevel::Avx2) == "avx2", caseLabel);
+   }
+   {
+      const std::string caseLabel = "evalKernels falls back to supported level";
+
+      for (const SimdLevel level : AllLevels)
+         VERIFY(evalKernels(level).level == std::min(level, detectSimdLevel()),
+                caseLabel);
+      VERIFY(evalKernels().level == detectSimdLevel(), caseLabel);
+   }
+}
+
+
+void testPieceSquareSum()
+{
+   PieceSquareTables tables{};
+   for (std::size_t i = Square::NumSquares; i < tables.size(); ++i)
+      tables[i] = static_cast<std::int32_t>(i % 23) - 11;
+   BoardCodes codes{};
+   for (std::size_t sq = 0; sq < codes.size(); sq += 3)
+      codes[sq] = static_cast<std::uint8_t>(sq % NumPieceCodes);
+
+   std::int32_t expected = 0;
+   for (std::size_t sq = 0; sq < codes.size(); ++sq)
+      expected += tables[codes[sq] * Square::NumSquares + sq];
+
+   for (const SimdLevel level : AllLevels)
+   {
+      const std::string caseLabel =
+         "pieceSquareSum for " + std::string{notateSimdLevel(level)};
+
+      VERIFY(evalKernels(level).pieceSquareSum(codes, tables) == expected, caseLabel);
+      VERIFY(evalKernels(level).pieceSquareSum(BoardCodes{}, tables) == 0, caseLabel);
+   }
+}
+
+
+void testWeightedPopcount()
+{
+   const std::vector<Bitboard> boards = {0xFF, 0x1, ~Bitboard{0}, 0x8000000000000001,
+                                         0,    0xF0F0, 0x1234567890ABCDEF};
+   const std::vector<std::int32_t> weights = {2, -3, 1, 5, 7, -1, 4};
+
+   for (const SimdLevel level : AllLevels)
+   {
+      const std::string caseLabel =
+         "weightedPopcount for " + std::string{notateSimdLevel(level)};
+      const EvalKernels& kernels = evalKernels(level);
+
+      VERIFY(kernels.weightedPopcount(boards.data(), weights.data(), 0) == 0, caseLabel);
+      VERIFY(kernels.weightedPopcount(boards.data(), weights.data(), 3) == 77, caseLabel);
+      // Every count to cover the remainders of the vectorized loops.
+      for (std::size_t count = 1; count <= boards.size(); ++count)
+      {
+         std::int32_t expected = 0;
+         for (std::size_t i = 0; i < count; ++i)
+            expected += popcount(boards[i]) * weights[i];
+         VERIFY(kernels.weightedPopcount(boards.data(), weights.data(), count) ==
+                   expected,
+                caseLabel);
+      }
+   }
+}
+
+
+
+void testDotProduct()
+{
+   std::vector<std::uint8_t> inputs;
+   std::vector<std::int8_t> weights;
+   for (int i = 0; i < 75; ++i)
+   {
+      inputs.push_back(static_cast<std::uint8_t>(i * 37 % 128));
+      weights.push_back(static_cast<std::int8_t>(i * 53 % 256 - 128));
+   }
+   // Largest products.
+   inputs[0] = 127;
+   weights[0] = -128;
+   inputs[1] = 127;
+   weights[1] = -128;
+
+   for (const SimdLevel level : AllLevels)
+   {
+      const std::string caseLabel =
+         "dotProduct for " + std::string{notateSimdLevel(level)};
+      const EvalKernels& kernels = evalKernels(level);
+
+      for (const std::size_t count : {0, 1, 16, 31, 32, 33, 64, 75})
+      {
+         std::int32_t expected = 0;
+         for (std::size_t i = 0; i < count; ++i)
+            expected += std::int32_t{inputs[i]} * std::int32_t{weights[i]};
+         VERIFY(kernels.dotProduct(inputs.data(), weights.data(), count) == expected,
+                caseLabel);
+      }
+   }
+}
+
+} // namespace
+
+
+///////////////////
+
+void testEvalKernels()
+{
+   testSimdLevel();
+   testPieceSquareSum();
+   testWeightedPopcount();
+   testDotProduct();
+}
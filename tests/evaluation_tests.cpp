@@ -0,0 +1,77 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "evaluation_tests.h"
+#include "evaluation.h"
+#include "fen.h"
+#include "position.h"
+#include "test_util.h"
+#include <string>
+
+
+namespace
+{
+///////////////////
+
+void testEvaluatePosition()
+{
+   {
+      const std::string caseLabel = "evaluatePosition for initial position";
+
+      VERIFY(evaluatePosition(readFen(StartFen)->pos) == 0.f, caseLabel);
+   }
+   {
+      const std::string caseLabel = "evaluatePosition for mirrored position";
+
+      const Position pos{"Kwg1 Rwe1 Nwf3 we4 wf2 wg2 Kbe8 Bbc5 bd6"};
+      const Position mirrored{"Kbg8 Rbe8 Nbf6 be5 bf7 bg7 Kwe1 Bwc4 wd3"};
+      VERIFY(evaluatePosition(mirrored) == -evaluatePosition(pos), caseLabel);
+   }
+   {
+      const std::string caseLabel = "evaluatePosition prefers central pieces";
+
+      VERIFY(evaluatePosition(Position{"Kwe1 Nwd4 Kbe8"}) >
+                evaluatePosition(Position{"Kwe1 Nwa1 Kbe8"}),
+             caseLabel);
+      VERIFY(evaluatePosition(Position{"Kwe1 Bwd4 Kbe8"}) >
+                evaluatePosition(Position{"Kwe1 Bwh1 Kbe8 bg2"}) + 1.f,
+             caseLabel);
+   }
+   {
+      const std::string caseLabel = "evaluatePosition prefers attacks on the king";
+
+      VERIFY(evaluatePosition(Position{"Kwa1 Rwd2 Kbe8"}) >
+                evaluatePosition(Position{"Kwa1 Rwb2 Kbh8"}),
+             caseLabel);
+   }
+   {
+      const std::string caseLabel = "evaluatePosition keeps the material ahead";
+
+      VERIFY(evaluatePosition(Position{"Kwa1 Nwa8 Kbe8 bh2"}) > 1.5f, caseLabel);
+      VERIFY(evaluatePosition(Position{"Kwa1 Qwh1 Kbe8 Rbd4"}) > 3.f, caseLabel);
+   }
+   {
+      const std::string caseLabel = "evaluatePosition for all instruction sets";
+
+      const Position pos =
+         readFen("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1")
+            ->pos;
+      const float expected = evaluatePosition(pos, evalKernels(SimdLevel::Scalar));
+      VERIFY(evaluatePosition(pos, evalKernels(SimdLevel::Sse41)) == expected,
+             caseLabel);
+      VERIFY(evaluatePosition(pos, evalKernels(SimdLevel::Avx2)) == expected,
+             caseLabel);
+      VERIFY(evaluatePosition(pos) == expected, caseLabel);
+   }
+}
+
+} // namespace
+
+
+///////////////////
+
+void testEvaluation()
+{
+   testEvaluatePosition();
+}
@@ -0,0 +1,192 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "fen_tests.h"
+#include "fen.h"
+#include "position.h"
+#include "test_util.h"
+#include <string>
+#include <vector>
+
+
+namespace
+{
+///////////////////
+
+void testReadFen()
+{
+   {
+      const std::string caseLabel = "readFen for initial position";
+
+      const auto fen = readFen(StartFen);
+      VERIFY(fen.has_value(), caseLabel);
+      if (fen.has_value())
+      {
+         VERIFY(fen->pos == StartPos, caseLabel);
+         VERIFY(fen->pos.hash() == StartPos.hash(), caseLabel);
+         VERIFY(fen->pos.score() == StartPos.score(), caseLabel);
+         VERIFY(fen->side == Color::White, caseLabel);
+         VERIFY(fen->castling == Castling::All, caseLabel);
+         VERIFY(!fen->enPassant, caseLabel);
+         VERIFY(fen->halfmoveClock == 0, caseLabel);
+         VERIFY(fen->fullmoveNumber == 1, caseLabel);
+      }
+   }
+   {
+      const std::string caseLabel = "readFen for game state";
+
+      const auto fen = readFen("4k3/8/8/3pP3/8/8/8/4K2R w Kq d6 12 40");
+      VERIFY(fen.has_value(), caseLabel);
+      if (fen.has_value())
+      {
+         VERIFY(fen->pos == Position("Kwe1 Rwh1 we5 Kbe8 bd5"), caseLabel);
+         VERIFY(fen->side == Color::White, caseLabel);
+         VERIFY(fen->castling == (Castling::WhiteKingside | Castling::BlackQueenside),
+                caseLabel);
+         VERIFY(fen->enPassant == "d6"_sq, caseLabel);
+         VERIFY(fen->halfmoveClock == 12, caseLabel);
+         VERIFY(fen->fullmoveNumber == 40, caseLabel);
+         VERIFY(fen->pos.reversiblePlies() == 12, caseLabel);
+      }
+   }
+   {
+      const std::string caseLabel = "readFen without move counters";
+
+      const auto fen = readFen("8/8/8/8/8/8/8/K6k b - -");
+      VERIFY(fen.has_value(), caseLabel);
+      if (fen.has_value())
+      {
+         VERIFY(fen->pos == Position("Kwa1 Kbh1"), caseLabel);
+         VERIFY(fen->side == Color::Black, caseLabel);
+         VERIFY(fen->castling == Castling::None, caseLabel);
+         VERIFY(fen->halfmoveClock == 0, caseLabel);
+         VERIFY(fen->fullmoveNumber == 1, caseLabel);
+      }
+   }
+   {
+      const std::string caseLabel = "readFen for malformed input";
+
+      const std::vector<std::string> malformed = {
+         "",
+         "8/8/8/8/8/8/8 w - - 0 1",
+         "8/8/8/8/8/8/8/8/8 w - - 0 1",
+         "9/8/8/8/8/8/8/8 w - - 0 1",
+         "7/8/8/8/8/8/8/8 w - - 0 1",
+         "ppppppppp/8/8/8/8/8/8/8 w - - 0 1",
+         "8/8/8/8/8/8/8/7x w - - 0 1",
+         "8/8/8/8/8/8/8/8 x - - 0 1",
+         "8/8/8/8/8/8/8/8 w KX - 0 1",
+         "8/8/8/8/8/8/8/8 w - e4 0 1",
+         "8/8/8/8/8/8/8/8 w - - a 1",
+         "8/8/8/8/8/8/8/8 w - - 0 1 extra",
+         "QQQQQQQQ/QQQQQQQQ/8/8/8/8/8/8 w - - 0 1",
+      };
+      for (const std::string& fen : malformed)
+         VERIFY(!readFen(fen).has_value(), caseLabel);
+   }
+}
+
+
+void testWriteFen()
+{
+   {
+      const std::string caseLabel = "writeFen for initial position";
+
+      FenPosition fen;
+      fen.pos = StartPos;
+      fen.castling = Castling::All;
+      VERIFY(writeFen(fen) == StartFen, caseLabel);
+   }
+   {
+      const std::string caseLabel = "writeFen for game state";
+
+      FenPosition fen;
+      fen.pos = Position{"Kwe1 Rwh1 we5 Kbe8 bd5"};
+      fen.side = Color::Black;
+      fen.castling = Castling::BlackQueenside;
+      fen.enPassant = "d6"_sq;
+      fen.halfmoveClock = 3;
+      fen.fullmoveNumber = 123;
+      VERIFY(writeFen(fen) == "4k3/8/8/3pP3/8/8/8/4K2R b q d6 3 123", caseLabel);
+   }
+   {
+      const std::string caseLabel = "writeFen into buffer";
+
+      FenPosition fen;
+      fen.pos = Position{"Kwa1 Kbh8"};
+      FenBuffer buffer;
+      const std::string_view written = writeFen(fen, buffer);
+      VERIFY(written == "7k/8/8/8/8/8/8/K7 w - - 0 1", caseLabel);
+      VERIFY(written.data() == buffer.data(), caseLabel);
+   }
+   {
+      const std::string caseLabel = "writeFen reverses readFen";
+
+      const std::vector<std::string> fens = {
+         "r1bqkb1r/pppp1ppp/2n2n2/4p2Q/2B1P3/8/PPPP1PPP/RNB1K1NR w KQkq - 4 4",
+         "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+         "rnbqkbnr/ppp1pppp/8/3pP3/8/8/PPPP1PPP/RNBQKBNR w KQkq d6 0 3",
+      };
+      for (const std::string& str : fens)
+      {
+         const auto fen = readFen(str);
+         VERIFY(fen.has_value() && writeFen(*fen) == str, caseLabel);
+      }
+   }
+}
+
+
+void testMakeFenMove()
+{
+   // Plays a move in coordinate notation and returns the FEN string afterwards.
+   const auto play = [](std::string_view fenStr, std::string_view move) {
+      const FenPosition fen = *readFen(fenStr);
+      const Square from{move.substr(0, 2)};
+      const Move made{*fen.pos[from], Square{move.substr(2)}, fen.pos};
+      return writeFen(makeMove(fen, made));
+   };
+
+   {
+      const std::string caseLabel = "makeMove for FEN position counts moves";
+
+      VERIFY(play(StartFen, "g1f3") ==
+                "rnbqkbnr/pppppppp/8/8/8/5N2/PPPPPPPP/RNBQKB1R b KQkq - 1 1",
+             caseLabel);
+      VERIFY(play("rnbqkbnr/pppppppp/8/8/8/5N2/PPPPPPPP/RNBQKB1R b KQkq - 1 1", "g8f6") ==
+                "rnbqkb1r/pppppppp/5n2/8/8/5N2/PPPPPPPP/RNBQKB1R w KQkq - 2 2",
+             caseLabel);
+   }
+   {
+      const std::string caseLabel = "makeMove for FEN position sets en passant square";
+
+      // No black pawn can capture.
+      VERIFY(play(StartFen, "e2e4") ==
+                "rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq - 0 1",
+             caseLabel);
+      VERIFY(play("4k3/3p4/8/4P3/8/8/8/4K3 b - - 0 1", "d7d5") ==
+                "4k3/8/8/3pP3/8/8/8/4K3 w - d6 0 2",
+             caseLabel);
+   }
+   {
+      const std::string caseLabel = "makeMove for FEN position loses castling rights";
+
+      const std::string_view rooks = "r3k2r/8/8/8/8/8/8/R3K2R w KQkq - 0 1";
+      VERIFY(play(rooks, "e1e2") == "r3k2r/8/8/8/8/8/4K3/R6R b kq - 1 1", caseLabel);
+      VERIFY(play(rooks, "e1g1") == "r3k2r/8/8/8/8/8/8/R4RK1 b kq - 1 1", caseLabel);
+      VERIFY(play(rooks, "h1h8") == "r3k2R/8/8/8/8/8/8/R3K3 b Qq - 0 1", caseLabel);
+      VERIFY(play(rooks, "a1a2") == "r3k2r/8/8/8/8/8/R7/4K2R b Kkq - 1 1", caseLabel);
+   }
+}
+
+} // namespace
+
+
+///////////////////
+
+void testFen()
+{
+   testReadFen();
+   testWriteFen();
+   testMakeFenMove();
+}
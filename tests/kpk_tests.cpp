@@ -0,0 +1,193 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "kpk_tests.h"
+#include "kpk.h"
+#include "matt.h"
+#include "position.h"
+#include "test_util.h"
+#include "tt.h"
+#include <algorithm>
+#include <atomic>
+#include <limits>
+
+
+namespace
+{
+///////////////////
+
+void testProbeKpk()
+{
+   {
+      const std::string caseLabel = "probeKpk for king in front of pawn on sixth rank";
+
+      const Position pos{"Kwe6 we5 Kbe8"};
+      VERIFY(probeKpk(pos, Color::White) == Wdl::Win, caseLabel);
+      VERIFY(probeKpk(pos, Color::Black) == Wdl::Loss, caseLabel);
+   }
+   {
+      const std::string caseLabel = "probeKpk for opposition";
+
+      const Position pos{"Kwe5 we4 Kbe7"};
+      VERIFY(probeKpk(pos, Color::White) == Wdl::Draw, caseLabel);
+      VERIFY(probeKpk(pos, Color::Black) == Wdl::Loss, caseLabel);
+   }
+   {
+      const std::string caseLabel = "probeKpk for pawn outside of king's reach";
+
+      const Position pos{"Kwd3 wf4 Kbb2"};
+      VERIFY(probeKpk(pos, Color::White) == Wdl::Win, caseLabel);
+      VERIFY(probeKpk(pos, Color::Black) == Wdl::Loss, caseLabel);
+   }
+   {
+      const std::string caseLabel = "probeKpk for rook pawn";
+
+      const Position pos{"Kwh1 wh2 Kbh8"};
+      VERIFY(probeKpk(pos, Color::White) == Wdl::Draw, caseLabel);
+      VERIFY(probeKpk(pos, Color::Black) == Wdl::Draw, caseLabel);
+   }
+   {
+      const std::string caseLabel = "probeKpk for undefended pawn";
+
+      const Position pos{"Kwa1 wd5 Kbe6"};
+      VERIFY(probeKpk(pos, Color::Black) == Wdl::Draw, caseLabel);
+   }
+   {
+      const std::string caseLabel = "probeKpk for promotion";
+
+      const Position pos{"Kwa1 wg7 Kbe7"};
+      VERIFY(probeKpk(pos, Color::White) == Wdl::Win, caseLabel);
+   }
+   {
+      const std::string caseLabel = "probeKpk for black pawn";
+
+      const Position pos{"Kbe4 be5 Kwe2"};
+      VERIFY(probeKpk(pos, Color::Black) == Wdl::Draw, caseLabel);
+      VERIFY(probeKpk(pos, Color::White) == Wdl::Loss, caseLabel);
+   }
+   {
+      const std::string caseLabel = "probeKpk for side in check that does not move";
+
+      const Position pos{"Kwe4 we5 Kbd6"};
+      VERIFY(!probeKpk(pos, Color::White).has_value(), caseLabel);
+   }
+   {
+      const std::string caseLabel = "probeKpk for other material";
+
+      VERIFY(!probeKpk(Position{"Kwe1 Kbe8"}, Color::White).has_value(), caseLabel);
+      VERIFY(!probeKpk(Position{"Kwe1 Nwe2 Kbe8"}, Color::White).has_value(),
+             caseLabel);
+      VERIFY(!probeKpk(Position{"Kwe1 we2 be7 Kbe8"}, Color::White).has_value(),
+             caseLabel);
+   }
+   {
+      const std::string caseLabel = "probeKpk for pawn on last rank";
+
+      VERIFY(probeKpk(Position{"Kwa1 we8 Kbh1"}, Color::White) == Wdl::Win, caseLabel);
+      VERIFY(probeKpk(Position{"Kwa1 we8 Kbh1"}, Color::Black) == Wdl::Loss, caseLabel);
+      VERIFY(probeKpk(Position{"Kwa1 we8 Kbd8"}, Color::Black) == Wdl::Draw, caseLabel);
+      VERIFY(probeKpk(Position{"Kwf7 we8 Kbd8"}, Color::Black) == Wdl::Loss, caseLabel);
+      VERIFY(probeKpk(Position{"Kba1 be1 Kwd1"}, Color::White) == Wdl::Draw, caseLabel);
+   }
+   {
+      const std::string caseLabel = "probeKpk for pawn on first rank";
+
+      VERIFY(!probeKpk(Position{"Kwa1 we1 Kbh8"}, Color::White).has_value(), caseLabel);
+   }
+}
+
+
+void testProbeKpkDistance()
+{
+   {
+      const std::string caseLabel = "probeKpkDistance for promotion";
+
+      VERIFY(probeKpkDistance(Position{"Kwa1 wg7 Kbe7"}, Color::White) == 1, caseLabel);
+      VERIFY(probeKpkDistance(Position{"Kwa1 wg7 Kba8"}, Color::Black) == 2, caseLabel);
+      VERIFY(probeKpkDistance(Position{"Kwa1 wg6 Kba8"}, Color::White) == 3, caseLabel);
+   }
+   {
+      const std::string caseLabel = "probeKpkDistance for black pawn";
+
+      VERIFY(probeKpkDistance(Position{"Kbh8 bb2 Kwh1"}, Color::Black) == 1, caseLabel);
+   }
+   {
+      const std::string caseLabel = "probeKpkDistance for draw";
+
+      VERIFY(probeKpkDistance(Position{"Kwe4 we5 Kbe6"}, Color::White) == 0, caseLabel);
+   }
+   {
+      const std::string caseLabel = "probeKpkDistance for pawn on last rank";
+
+      VERIFY(probeKpkDistance(Position{"Kwa1 we8 Kbh1"}, Color::White) == 0, caseLabel);
+   }
+   {
+      const std::string caseLabel = "probeKpkDistance for other material";
+
+      VERIFY(!probeKpkDistance(Position{"Kwe1 Kbe8"}, Color::White).has_value(),
+             caseLabel);
+   }
+   {
+      const std::string caseLabel = "probeKpkDistance decreases along best play";
+
+      const Position pos{"Kwe6 we5 Kbe8"};
+      const std::optional<int> distance = probeKpkDistance(pos, Color::White);
+      VERIFY(distance.has_value() && *distance > 1, caseLabel);
+
+      // The best move of the winning side brings the promotion one ply closer.
+      int best = std::numeric_limits<int>::max();
+      forEachPiece(pos, Color::White, [&](const Piece& piece) {
+         for (const Move& move : piece.nextMoves(pos))
+         {
+            const Position next = pos.makeMove(move);
+            if (probeKpk(next, Color::Black) == Wdl::Loss)
+               best = std::min(best, *probeKpkDistance(next, Color::Black));
+         }
+      });
+      VERIFY(distance.has_value() && best == *distance - 1, caseLabel);
+   }
+}
+
+
+void testPlayKpk()
+{
+   {
+      const std::string caseLabel = "search plays won KPK position out to promotion";
+
+      Position pos{"Kwe6 we5 Kbe8"};
+      Color side = Color::White;
+      TranspositionTable tt{1};
+      const std::atomic<bool> stop{false};
+      SearchLimits limits;
+      limits.plies = 3;
+      limits.isParallel = false;
+
+      bool isPromoted = false;
+      for (std::size_t ply = 0; ply < 40 && !isPromoted; ++ply)
+      {
+         const std::optional<Move> move = search(pos, side, limits, tt, stop).bestMove();
+         if (!move.has_value())
+            break;
+         pos = pos.makeMove(*move);
+         side = !side;
+
+         const auto& pawns = pos.squares(Color::White, Figure::Pawn);
+         VERIFY(pawns.size() == 1, caseLabel);
+         isPromoted = pawns.size() == 1 && pawns[0].rank() == '8';
+      }
+      VERIFY(isPromoted, caseLabel);
+   }
+}
+
+} // namespace
+
+
+///////////////////
+
+void testKpk()
+{
+   testProbeKpk();
+   testProbeKpkDistance();
+   testPlayKpk();
+}
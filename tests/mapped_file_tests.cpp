@@ -0,0 +1,100 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "mapped_file_tests.h"
+#include "mapped_file.h"
+#include "test_util.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+
+namespace
+{
+///////////////////
+
+void testMappedFileOpen()
+{
+   {
+      const std::string caseLabel = "MappedFile::open";
+
+      const auto path = tempPath("matt_mapped_file_open.txt");
+      {
+         std::ofstream out{path, std::ios::binary};
+         out << "mapped content";
+      }
+
+      const std::optional<MappedFile> file = MappedFile::open(path);
+      VERIFY(file.has_value(), caseLabel);
+      if (file.has_value())
+      {
+         VERIFY(file->size() == 14, caseLabel);
+         VERIFY(std::memcmp(file->data(), "mapped content", 14) == 0, caseLabel);
+      }
+      std::filesystem::remove(path);
+   }
+   {
+      const std::string caseLabel = "MappedFile::open for empty file";
+
+      const auto path = tempPath("matt_mapped_file_empty.txt");
+      std::ofstream{path};
+
+      const std::optional<MappedFile> file = MappedFile::open(path);
+      VERIFY(file.has_value() && file->empty(), caseLabel);
+      std::filesystem::remove(path);
+   }
+   {
+      const std::string caseLabel = "MappedFile::open for missing file";
+
+      VERIFY(!MappedFile::open(tempPath("matt_mapped_file_missing.txt")).has_value(),
+             caseLabel);
+   }
+}
+
+
+void testMappedFileCreate()
+{
+   {
+      const std::string caseLabel = "MappedFile::create";
+
+      const auto path = tempPath("matt_mapped_file_create.bin");
+      {
+         std::optional<MappedFile> file = MappedFile::create(path, 4);
+         VERIFY(file.has_value() && file->writableData(), caseLabel);
+         if (file.has_value())
+            std::memcpy(file->writableData(), "abcd", 4);
+      }
+
+      const std::optional<MappedFile> file = MappedFile::open(path);
+      VERIFY(file.has_value() && file->size() == 4, caseLabel);
+      if (file.has_value())
+      {
+         VERIFY(std::memcmp(file->data(), "abcd", 4) == 0, caseLabel);
+         VERIFY(MappedFile{}.writableData() == nullptr, caseLabel);
+      }
+   }
+   {
+      const std::string caseLabel = "MappedFile move";
+
+      const auto path = tempPath("matt_mapped_file_create.bin");
+      std::optional<MappedFile> file = MappedFile::open(path);
+      MappedFile moved = std::move(*file);
+      VERIFY(moved.size() == 4 && file->data() == nullptr, caseLabel);
+      moved = MappedFile{};
+      VERIFY(moved.data() == nullptr, caseLabel);
+      std::filesystem::remove(path);
+   }
+}
+
+} // namespace
+
+
+///////////////////
+
+void testMappedFile()
+{
+   testMappedFileOpen();
+   testMappedFileCreate();
+}
@@ -4,11 +4,17 @@
 //
 #include "matt_tests.h"
 #include "matt.h"
+#include "eval_cache.h"
+#include "evaluation.h"
+#include "nnue.h"
 #include "position.h"
 #include "test_util.h"
+#include "tt.h"
 #include "deps/essentutils/time_util.h"
 #include <iostream>
 #include <chrono>
+#include <memory>
+#include <numeric>
 
 
 namespace
@@ -72,6 +78,487 @@ void testMakeMoveForPositionB()
    }
 }
 
+
+void testBestLines()
+{
+   {
+      const std::string caseLabel = "bestLines";
+
+      const std::vector<SearchLine> lines =
+         bestLines(Position{"Kwa1 Rwh1 Qbb2 Kba8"}, Color::White, 1, 2);
+      VERIFY(lines.size() == 2, caseLabel);
+      if (lines.size() == 2)
+      {
+         VERIFY(lines[0].pv.front().to() == Square{"b2"}, caseLabel);
+         VERIFY(lines[0].score > lines[1].score, caseLabel);
+      }
+   }
+   {
+      const std::string caseLabel = "bestLines for position without moves";
+
+      VERIFY(bestLines(Position{"Kwd3"}, Color::Black, 1, 2).empty(), caseLabel);
+   }
+}
+
+
+void testMakeMoveWithLimits()
+{
+   {
+      const std::string caseLabel = "makeMove with limits";
+
+      const Position pos{"Kwa1 Rwh1 Qbb2 Kba8"};
+      const std::atomic<bool> cancel{false};
+      SearchLimits limits;
+      limits.plies = 3;
+      const std::optional<Position> result = makeMove(pos, Color::White, limits, cancel);
+
+      VERIFY(result.has_value() && !(*result)[Square{"a1"}].has_value(), caseLabel);
+   }
+   {
+      const std::string caseLabel = "makeMove when cancelled";
+
+      const std::atomic<bool> cancel{true};
+      const std::optional<Position> result =
+         makeMove(Position{"Kwd3 wf4 Kbb2 bh7"}, Color::White, SearchLimits{}, cancel);
+
+      VERIFY(result.has_value(), caseLabel);
+   }
+}
+
+
+void testSearchStats()
+{
+   {
+      const std::string caseLabel = "SearchStats::operator+=";
+
+      SearchStats a;
+      a.nodes = 10;
+      a.betaCutoffs = 4;
+      a.firstMoveCutoffs = 3;
+      a.iterationNodes = {2, 8};
+      SearchStats b;
+      b.nodes = 5;
+      b.betaCutoffs = 4;
+      b.firstMoveCutoffs = 1;
+      b.evalProbes = 8;
+      b.evalHits = 2;
+      a += b;
+
+      VERIFY(a.nodes == 15, caseLabel);
+      VERIFY(a.firstMoveCutoffRate() == 0.5, caseLabel);
+      VERIFY(a.branchingFactor() == 4., caseLabel);
+      VERIFY(a.evalHitRate() == 0.25, caseLabel);
+   }
+   {
+      const std::string caseLabel = "SearchStats for empty search";
+
+      const SearchStats stats;
+      VERIFY(stats.branchingFactor() == 0., caseLabel);
+      VERIFY(stats.firstMoveCutoffRate() == 0., caseLabel);
+      VERIFY(stats.evalHitRate() == 0., caseLabel);
+   }
+}
+
+
+void testSearch()
+{
+   {
+      const std::string caseLabel = "search with depth limit";
+
+      // Not a solved endgame, so that the search has to look ahead.
+      const Position pos{"Kwd3 wf4 Kbb2 bh7"};
+      TranspositionTable tt{1};
+      const std::atomic<bool> stop{false};
+      SearchLimits limits;
+      limits.plies = 4;
+      std::vector<std::size_t> depths;
+      const SearchResult result =
+         search(pos, Color::White, limits, tt, stop,
+                [&depths](const SearchResult& iteration) {
+                   depths.push_back(iteration.depth);
+                });
+
+      VERIFY(result.depth == 4, caseLabel);
+      VERIFY(result.nodes > 0, caseLabel);
+      VERIFY((depths == std::vector<std::size_t>{1, 2, 3, 4}), caseLabel);
+      VERIFY(!result.pv.empty() && result.pv.size() <= 4, caseLabel);
+      VERIFY(result.bestMove().has_value() &&
+                result.bestMove()->piece().color() == Color::White,
+             caseLabel);
+      VERIFY(result.ponderMove().has_value() &&
+                result.ponderMove()->piece().color() == Color::Black,
+             caseLabel);
+      VERIFY(tt.hashfull() > 0, caseLabel);
+   }
+   {
+      const std::string caseLabel = "search finds winning capture";
+
+      const Position pos{"Kwa1 Rwh1 Qbb2 Kba8"};
+      TranspositionTable tt{1};
+      const std::atomic<bool> stop{false};
+      SearchLimits limits;
+      limits.plies = 3;
+      const SearchResult result = search(pos, Color::White, limits, tt, stop);
+
+      VERIFY(result.bestMove().has_value() && result.bestMove()->to() == Square{"b2"},
+             caseLabel);
+      VERIFY(result.score == 5.f, caseLabel);
+   }
+   {
+      const std::string caseLabel = "search statistics";
+
+      const Position pos{"Kwd3 wf4 Kbb2 bh7"};
+      TranspositionTable tt{1};
+      const std::atomic<bool> stop{false};
+      SearchLimits limits;
+      limits.plies = 4;
+      const SearchResult result = search(pos, Color::White, limits, tt, stop);
+      const SearchStats& stats = result.stats;
+
+      VERIFY(stats.nodes == result.nodes, caseLabel);
+      VERIFY(stats.leafNodes > 0 && stats.leafNodes < stats.nodes, caseLabel);
+      VERIFY(stats.hashProbes >= stats.hashHits && stats.hashHits >= stats.hashCutoffs,
+             caseLabel);
+      VERIFY(stats.hashCutoffs > 0, caseLabel);
+      VERIFY(stats.betaCutoffs >= stats.firstMoveCutoffs && stats.betaCutoffs > 0,
+             caseLabel);
+      VERIFY(stats.firstMoveCutoffRate() > 0. && stats.firstMoveCutoffRate() <= 1.,
+             caseLabel);
+      VERIFY(stats.iterationNodes.size() == 4 && stats.iterationTimes.size() == 4,
+             caseLabel);
+      VERIFY(std::accumulate(std::begin(stats.iterationNodes),
+                             std::end(stats.iterationNodes), std::uint64_t{0}) ==
+                stats.nodes,
+             caseLabel);
+      VERIFY(stats.branchingFactor() > 1., caseLabel);
+      VERIFY(!stats.threadNodes.empty() &&
+                std::accumulate(std::begin(stats.threadNodes),
+                                std::end(stats.threadNodes),
+                                std::uint64_t{0}) == stats.nodes,
+             caseLabel);
+   }
+   {
+      const std::string caseLabel = "search statistics for tablebase hits";
+
+      TranspositionTable tt{1};
+      const std::atomic<bool> stop{false};
+      SearchLimits limits;
+      limits.plies = 2;
+      const SearchResult result =
+         search(Position{"Kwe5 we4 Kbe7"}, Color::White, limits, tt, stop);
+
+      VERIFY(result.stats.tablebaseHits > 0, caseLabel);
+      VERIFY(result.stats.leafNodes == 0, caseLabel);
+   }
+   {
+      const std::string caseLabel = "search on one thread";
+
+      const Position pos{"Kwa1 Rwh1 Qbb2 Kba8"};
+      TranspositionTable tt{1};
+      const std::atomic<bool> stop{false};
+      SearchLimits limits;
+      limits.plies = 3;
+      limits.isParallel = false;
+      const SearchResult result = search(pos, Color::White, limits, tt, stop);
+
+      VERIFY(result.bestMove().has_value() && result.bestMove()->to() == Square{"b2"},
+             caseLabel);
+      VERIFY(result.score == 5.f, caseLabel);
+   }
+   {
+      const std::string caseLabel = "search with several lines";
+
+      const Position pos{"Kwa1 Rwh1 Qbb2 Kba8"};
+      TranspositionTable tt{1};
+      const std::atomic<bool> stop{false};
+      SearchLimits limits;
+      limits.plies = 3;
+      limits.multiPv = 3;
+      const SearchResult result = search(pos, Color::White, limits, tt, stop);
+
+      VERIFY(result.lines.size() == 3, caseLabel);
+      if (result.lines.size() == 3)
+      {
+         VERIFY(result.lines[0].score == result.score, caseLabel);
+         VERIFY(result.lines[0].pv == result.pv, caseLabel);
+         VERIFY(result.lines[0].score >= result.lines[1].score &&
+                   result.lines[1].score >= result.lines[2].score,
+                caseLabel);
+         VERIFY(result.lines[1].pv.front() != result.lines[0].pv.front() &&
+                   result.lines[2].pv.front() != result.lines[0].pv.front() &&
+                   result.lines[2].pv.front() != result.lines[1].pv.front(),
+                caseLabel);
+      }
+   }
+   {
+      const std::string caseLabel = "search with more lines than moves";
+
+      TranspositionTable tt{1};
+      const std::atomic<bool> stop{false};
+      SearchLimits limits;
+      limits.plies = 2;
+      limits.multiPv = 10;
+      const SearchResult result =
+         search(Position{"Kwa1 Kbc3"}, Color::White, limits, tt, stop);
+
+      // The king cannot move to b2.
+      VERIFY(result.lines.size() == 2, caseLabel);
+   }
+   {
+      const std::string caseLabel = "search with fewer lines bounds the other moves";
+
+      const Position pos{"Kwg1 Rwa1 wf2 wg2 wh2 Kbg8 Rbe8 bf7 bg7 bh7"};
+      const std::atomic<bool> stop{false};
+      SearchLimits limits;
+      limits.plies = 4;
+      limits.isParallel = false;
+      const auto searchLines = [&](std::size_t numLines) {
+         TranspositionTable tt{1};
+         limits.multiPv = numLines;
+         return search(pos, Color::White, limits, tt, stop);
+      };
+      const SearchResult all = searchLines(100);
+      const SearchResult three = searchLines(3);
+      const SearchResult one = searchLines(1);
+
+      VERIFY(one.score == all.score, caseLabel);
+      VERIFY(three.lines.size() == 3 && all.lines.size() > 3, caseLabel);
+      for (std::size_t i = 0; i < std::min<std::size_t>(three.lines.size(), 3); ++i)
+         VERIFY(three.lines[i].score == all.lines[i].score, caseLabel);
+      VERIFY(one.nodes < three.nodes && three.nodes < all.nodes, caseLabel);
+      VERIFY(one.bestMoveMargin <= all.bestMoveMargin, caseLabel);
+   }
+   {
+      const std::string caseLabel = "search looks up solved endgames";
+
+      TranspositionTable tt{1};
+      const std::atomic<bool> stop{false};
+      SearchLimits limits;
+      limits.plies = 3;
+      const SearchResult draw =
+         search(Position{"Kwe5 we4 Kbe7"}, Color::White, limits, tt, stop);
+      const SearchResult win =
+         search(Position{"Kwe6 we5 Kbe8"}, Color::White, limits, tt, stop);
+
+      VERIFY(draw.score == 0.f, caseLabel);
+      // Closer to promotion is better.
+      VERIFY(win.score > TablebaseWinScore - 1.f && win.score < TablebaseWinScore,
+             caseLabel);
+   }
+   {
+      const std::string caseLabel = "search with added tablebase";
+
+      Tablebases tablebases;
+      EndgameTable table;
+      table.maxPieces = 4;
+      table.probeWdl = [](const Position&, Color) { return Wdl::Win; };
+      tablebases.add(table);
+      TranspositionTable tt{1};
+      const std::atomic<bool> stop{false};
+      SearchLimits limits;
+      limits.plies = 3;
+      const SearchResult result = search(Position{"Kwa1 Rwh1 Qbb2 Kba8"}, Color::White,
+                                         limits, tt, stop, {}, tablebases);
+
+      VERIFY(result.score == -TablebaseWinScore, caseLabel);
+   }
+   {
+      const std::string caseLabel = "search completes first iteration when stopped";
+
+      const Position pos{"Kwd3 wf4 Kbb2"};
+      TranspositionTable tt{1};
+      const std::atomic<bool> stop{true};
+      const SearchResult result = search(pos, Color::White, SearchLimits{}, tt, stop);
+
+      VERIFY(result.depth == 1, caseLabel);
+      VERIFY(result.bestMove().has_value(), caseLabel);
+   }
+   {
+      const std::string caseLabel = "search with evaluation cache";
+
+      const Position pos{"Kwd3 wf4 Kbb2 bh7"};
+      const std::atomic<bool> stop{false};
+      SearchLimits limits;
+      limits.plies = 4;
+      limits.evaluation = static_cast<float (*)(const Position&)>(evaluatePosition);
+      TranspositionTable tt{1};
+      const SearchResult expected = search(pos, Color::White, limits, tt, stop);
+      TranspositionTable cachedTt{1};
+      EvalCache cache{1};
+      const SearchResult result = search(pos, Color::White, limits, cachedTt, stop, {},
+                                         Tablebases::builtIn(), &cache);
+
+      VERIFY(result.score == expected.score, caseLabel);
+      VERIFY(result.pv == expected.pv, caseLabel);
+      VERIFY(expected.stats.evalProbes == 0, caseLabel);
+      VERIFY(result.stats.evalProbes >= result.stats.leafNodes, caseLabel);
+      VERIFY(result.stats.evalHits > 0 &&
+                result.stats.evalHits < result.stats.evalProbes,
+             caseLabel);
+   }
+   {
+      const std::string caseLabel = "search with evaluation cache for material";
+
+      // Positions know their material, so there is nothing to look up.
+      const std::atomic<bool> stop{false};
+      SearchLimits limits;
+      limits.plies = 3;
+      TranspositionTable tt{1};
+      EvalCache cache{1};
+      const SearchResult result = search(Position{"Kwd3 wf4 Kbb2 bh7"}, Color::White,
+                                         limits, tt, stop, {}, Tablebases::builtIn(),
+                                         &cache);
+
+      VERIFY(result.stats.leafNodes > 0, caseLabel);
+      VERIFY(result.stats.evalProbes == 0, caseLabel);
+   }
+   {
+      const std::string caseLabel = "search with positional evaluation";
+
+      const Position pos{"Kwa1 Rwh1 Qbb2 Kba8"};
+      TranspositionTable tt{1};
+      const std::atomic<bool> stop{false};
+      SearchLimits limits;
+      limits.plies = 3;
+      limits.evaluation = [](const Position& p) { return evaluatePosition(p); };
+      const SearchResult result = search(pos, Color::White, limits, tt, stop);
+
+      VERIFY(result.bestMove().has_value() && result.bestMove()->to() == Square{"b2"},
+             caseLabel);
+      VERIFY(result.score > 4.f && result.score != 5.f, caseLabel);
+   }
+   {
+      const std::string caseLabel = "search with network";
+
+      // Weights that differ per feature, so that stale accumulators change scores.
+      NetworkWeights weights;
+      weights.hiddenSize = 16;
+      weights.layerSize = 4;
+      for (std::size_t i = 0; i < Network::NumFeatures * weights.hiddenSize; ++i)
+         weights.featureWeights.push_back(static_cast<std::int16_t>(i * 7 % 17) - 8);
+      weights.featureBiases.assign(weights.hiddenSize, 40);
+      for (std::size_t i = 0; i < weights.layerSize * weights.hiddenSize; ++i)
+         weights.layerWeights.push_back(static_cast<std::int8_t>(i * 5 % 11) - 5);
+      weights.layerBiases.assign(weights.layerSize, 100);
+      weights.outputWeights = {3, -2, 5, -1};
+      weights.outputScale = 0.01f;
+      const auto net = std::make_shared<const Network>(*Network::make(weights));
+
+      const Position pos{"Kwe1 Rwh1 Nwb1 we4 Kbe8 Qbd8 bd5"};
+      const std::atomic<bool> stop{false};
+      SearchLimits limits;
+      limits.plies = 3;
+      limits.isParallel = false;
+      limits.network = net;
+      TranspositionTable tt{1};
+      const SearchResult result = search(pos, Color::White, limits, tt, stop);
+
+      // Sums all features of every scored position.
+      limits.network.reset();
+      limits.evaluation = [net](const Position& p) { return net->evaluate(p); };
+      TranspositionTable fullTt{1};
+      const SearchResult full = search(pos, Color::White, limits, fullTt, stop);
+
+      VERIFY(result.score == full.score, caseLabel);
+      VERIFY(result.pv == full.pv, caseLabel);
+      VERIFY(result.stats.leafNodes == full.stats.leafNodes, caseLabel);
+   }
+   {
+      const std::string caseLabel = "search with node limit";
+
+      const Position pos{"Kwd3 wf4 Kbb2 bh7"};
+      TranspositionTable tt{1};
+      const std::atomic<bool> stop{false};
+      SearchLimits limits;
+      limits.nodes = 20000;
+      const SearchResult result = search(pos, Color::White, limits, tt, stop);
+
+      VERIFY(result.depth >= 1 && result.depth < MaxSearchPlies, caseLabel);
+      VERIFY(result.bestMove().has_value(), caseLabel);
+      VERIFY(result.nodes < 1000000, caseLabel);
+   }
+   {
+      const std::string caseLabel = "search with time limit";
+
+      const Position pos{"Kwd3 wf4 Kbb2 bh7"};
+      TranspositionTable tt{1};
+      const std::atomic<bool> stop{false};
+      SearchLimits limits;
+      limits.time = std::chrono::milliseconds{20};
+      const SearchResult result = search(pos, Color::White, limits, tt, stop);
+
+      VERIFY(result.depth >= 1 && result.depth < MaxSearchPlies, caseLabel);
+      VERIFY(result.bestMove().has_value(), caseLabel);
+   }
+   {
+      const std::string caseLabel = "search for position without moves";
+
+      const Position pos{"Kwd3"};
+      TranspositionTable tt{1};
+      const std::atomic<bool> stop{false};
+      const SearchResult result = search(pos, Color::Black, SearchLimits{}, tt, stop);
+
+      VERIFY(result.depth == 0, caseLabel);
+      VERIFY(!result.bestMove().has_value(), caseLabel);
+   }
+}
+
+
+void testHaveSameEvaluation()
+{
+   using EvalFn = float (*)(const Position&);
+   const EvalFn positional = evaluatePosition;
+   const auto makeLimits = [](Evaluation evaluation) {
+      SearchLimits limits;
+      limits.evaluation = std::move(evaluation);
+      return limits;
+   };
+
+   {
+      const std::string caseLabel = "haveSameEvaluation for material";
+      VERIFY(haveSameEvaluation(SearchLimits{}, SearchLimits{}), caseLabel);
+   }
+   {
+      const std::string caseLabel = "haveSameEvaluation for the same function";
+      VERIFY(haveSameEvaluation(makeLimits(positional), makeLimits(positional)),
+             caseLabel);
+   }
+   {
+      const std::string caseLabel = "haveSameEvaluation for material and a function";
+      VERIFY(!haveSameEvaluation(SearchLimits{}, makeLimits(positional)), caseLabel);
+      VERIFY(!haveSameEvaluation(makeLimits(positional), SearchLimits{}), caseLabel);
+   }
+   {
+      const std::string caseLabel = "haveSameEvaluation for other callables";
+      const Evaluation lambda = [](const Position& p) { return evaluatePosition(p); };
+      VERIFY(!haveSameEvaluation(makeLimits(lambda), makeLimits(lambda)), caseLabel);
+   }
+   {
+      const std::string caseLabel = "haveSameEvaluation for networks";
+
+      NetworkWeights weights;
+      weights.hiddenSize = 1;
+      weights.layerSize = 1;
+      weights.featureWeights.assign(Network::NumFeatures, 1);
+      weights.featureBiases = {0};
+      weights.layerWeights = {1};
+      weights.layerBiases = {0};
+      weights.outputWeights = {1};
+      const auto net = std::make_shared<const Network>(*Network::make(weights));
+      const auto other = std::make_shared<const Network>(*net);
+
+      SearchLimits limits;
+      limits.network = net;
+      SearchLimits same = limits;
+      SearchLimits different = limits;
+      different.network = other;
+
+      VERIFY(haveSameEvaluation(limits, same), caseLabel);
+      VERIFY(!haveSameEvaluation(limits, different), caseLabel);
+      VERIFY(!haveSameEvaluation(limits, SearchLimits{}), caseLabel);
+   }
+}
+
 } // namespace
 
 
@@ -81,4 +568,9 @@ void testMatt()
 {
    testMakeMoveForPositionA();
    testMakeMoveForPositionB();
+   testBestLines();
+   testMakeMoveWithLimits();
+   testSearch();
+   testSearchStats();
+   testHaveSameEvaluation();
 }
@@ -0,0 +1,168 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "move_picker_tests.h"
+#include "move_picker.h"
+#include "position.h"
+#include "test_util.h"
+#include <algorithm>
+#include <vector>
+
+
+namespace
+{
+///////////////////
+
+std::vector<Move> pickAll(MovePicker& picker)
+{
+   std::vector<Move> moves;
+   for (auto move = picker.next(); move.has_value(); move = picker.next())
+      moves.push_back(*move);
+   return moves;
+}
+
+
+std::vector<Move> generateAll(const Position& pos, Color side)
+{
+   std::vector<Move> moves;
+   for (const Piece& piece : pos.pieces(side))
+   {
+      const std::vector<Move> pieceMoves = piece.nextMoves(pos);
+      moves.insert(end(moves), begin(pieceMoves), end(pieceMoves));
+   }
+   return moves;
+}
+
+
+bool isPermutation(const std::vector<Move>& a, const std::vector<Move>& b)
+{
+   return a.size() == b.size() && std::is_permutation(begin(a), end(a), begin(b));
+}
+
+
+///////////////////
+
+void testMovePickerWithoutHints()
+{
+   {
+      const std::string caseLabel = "MovePicker yields all moves";
+
+      const Position pos{"Kwe1 Qwd1 Nwf3 we4 wd2 Kbe8 Bbb4 Nbc6 bd5 bf7"};
+      for (const Color side : {Color::White, Color::Black})
+      {
+         MovePicker picker{pos, side};
+         VERIFY(isPermutation(pickAll(picker), generateAll(pos, side)), caseLabel);
+      }
+   }
+   {
+      const std::string caseLabel = "MovePicker for side without pieces";
+
+      const Position pos{"Kwe1"};
+      MovePicker picker{pos, Color::Black};
+      VERIFY(!picker.next().has_value(), caseLabel);
+   }
+}
+
+
+void testMovePickerCaptureOrder()
+{
+   {
+      const std::string caseLabel = "MovePicker yields captures first";
+
+      const Position pos{"Kwe1 Qwd1 Nwf3 we4 wd2 Kbe8 Bbb4 Nbc6 bd5 bf7"};
+      MovePicker picker{pos, Color::White};
+      const std::vector<Move> moves = pickAll(picker);
+
+      const auto firstQuiet = std::find_if(
+         begin(moves), end(moves), [&pos](const Move& m) { return !isCapture(m, pos); });
+      VERIFY(std::none_of(firstQuiet, end(moves),
+                          [&pos](const Move& m) { return isCapture(m, pos); }),
+             caseLabel);
+   }
+   {
+      const std::string caseLabel = "MovePicker orders captures by victim and attacker";
+
+      // Queen and pawn can capture the rook, pawn can capture the knight.
+      const Position pos{"Kwa1 Qwd1 wc4 Rbd5 Nbb5 Kbh8"};
+      MovePicker picker{pos, Color::White};
+      const std::vector<Move> moves = pickAll(picker);
+
+      VERIFY(moves.size() > 3, caseLabel);
+      VERIFY(moves[0].notate() == "cxd5", caseLabel);
+      VERIFY(moves[1].notate() == "Qxd5", caseLabel);
+      VERIFY(moves[2].notate() == "cxb5", caseLabel);
+   }
+}
+
+
+void testMovePickerHashMove()
+{
+   {
+      const std::string caseLabel = "MovePicker yields hash move first";
+
+      const Position pos{"Kwe1 Qwd1 Nwf3 we4 wd2 Kbe8 Bbb4 Nbc6 bd5 bf7"};
+      const Move hashMove{"Nwf3"_pc, "g5"_sq, pos};
+      MovePicker picker{pos, Color::White, hashMove};
+      const std::vector<Move> moves = pickAll(picker);
+
+      VERIFY(!moves.empty() && moves[0] == hashMove, caseLabel);
+      VERIFY(isPermutation(moves, generateAll(pos, Color::White)), caseLabel);
+   }
+   {
+      const std::string caseLabel = "MovePicker ignores invalid hash move";
+
+      const Position pos{"Kwe1 Qwd1 Nwf3 we4 wd2 Kbe8 Bbb4 Nbc6 bd5 bf7"};
+      // Blocked by own pawn.
+      const Move hashMove{"Qwd1"_pc, "d3"_sq, "Qd3"};
+      MovePicker picker{pos, Color::White, hashMove};
+      const std::vector<Move> moves = pickAll(picker);
+
+      VERIFY(std::find(begin(moves), end(moves), hashMove) == end(moves), caseLabel);
+      VERIFY(isPermutation(moves, generateAll(pos, Color::White)), caseLabel);
+   }
+}
+
+
+void testMovePickerKillers()
+{
+   {
+      const std::string caseLabel = "MovePicker yields killers after captures";
+
+      const Position pos{"Kwe1 Qwd1 Nwf3 we4 wd2 Kbe8 Bbb4 Nbc6 bd5 bf7"};
+      const MovePicker::Killers killers{Move{"wd2"_pc, "d3"_sq, "d3"},
+                                        Move{"Qwd1"_pc, "a4"_sq, "Qa4"}};
+      MovePicker picker{pos, Color::White, std::nullopt, killers};
+      const std::vector<Move> moves = pickAll(picker);
+
+      const auto firstQuiet = std::find_if(
+         begin(moves), end(moves), [&pos](const Move& m) { return !isCapture(m, pos); });
+      VERIFY(firstQuiet != end(moves) && *firstQuiet == *killers[0], caseLabel);
+      VERIFY(firstQuiet + 1 != end(moves) && *(firstQuiet + 1) == *killers[1],
+             caseLabel);
+      VERIFY(isPermutation(moves, generateAll(pos, Color::White)), caseLabel);
+   }
+   {
+      const std::string caseLabel = "MovePicker ignores invalid killers";
+
+      const Position pos{"Kwe1 Qwd1 Nwf3 we4 wd2 Kbe8 Bbb4 Nbc6 bd5 bf7"};
+      // Piece is not on the board and move is not possible.
+      const MovePicker::Killers killers{Move{"Rwa1"_pc, "a4"_sq, "Ra4"},
+                                        Move{"Nwf3"_pc, "f5"_sq, "Nf5"}};
+      MovePicker picker{pos, Color::White, std::nullopt, killers};
+      VERIFY(isPermutation(pickAll(picker), generateAll(pos, Color::White)), caseLabel);
+   }
+}
+
+} // namespace
+
+
+///////////////////
+
+void testMovePicker()
+{
+   testMovePickerWithoutHints();
+   testMovePickerCaptureOrder();
+   testMovePickerHashMove();
+   testMovePickerKillers();
+}
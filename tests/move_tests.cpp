@@ -57,6 +57,16 @@ void testMoveCtorWithPosition()
       VERIFY(m.to() == to, caseLabel);
       VERIFY(m.notate() == "Bc3", caseLabel);
    }
+   {
+      const std::string caseLabel = "Move ctor for promotion";
+
+      const Piece pawn("bg2");
+      const Position pos{std::vector<Piece>{pawn}};
+      const Move m{pawn, "g1"_sq, Figure::Rook, pos};
+      VERIFY(m.promotion() == Figure::Rook, caseLabel);
+      VERIFY(m.movedPiece() == "Rbg1"_pc, caseLabel);
+      VERIFY(m.notate() == "g1=R", caseLabel);
+   }
 }
 
 
@@ -176,6 +186,41 @@ void testNotateMove()
       VERIFY(notateMove("Kwe1"_pc, "d2"_sq, Position("Kwe1 bd2")) == "Kxd2", caseLabel);
       VERIFY(notateMove("bf5"_pc, "e4"_sq, Position("bf5 Nwe4")) == "fxe4", caseLabel);
    }
+   {
+      const std::string caseLabel = "notateMove for special moves";
+
+      VERIFY(notateMove("Kwe1"_pc, "g1"_sq, Position("Kwe1 Rwh1")) == "O-O", caseLabel);
+      VERIFY(notateMove("Kbe8"_pc, "c8"_sq, Position("Kbe8 Rba8")) == "O-O-O", caseLabel);
+      VERIFY(notateMove("we5"_pc, "d6"_sq, Position("we5 bd5")) == "exd6", caseLabel);
+      VERIFY(notateMove("wa7"_pc, "a8"_sq, Position("wa7"), Figure::Queen) == "a8=Q",
+             caseLabel);
+   }
+}
+
+
+void testIsCastling()
+{
+   {
+      const std::string caseLabel = "isCastling";
+
+      VERIFY(isCastling("Kwe1"_pc, "g1"_sq), caseLabel);
+      VERIFY(isCastling("Kbe8"_pc, "c8"_sq), caseLabel);
+      VERIFY(!isCastling("Kwe1"_pc, "f1"_sq), caseLabel);
+      VERIFY(!isCastling("Rwe1"_pc, "g1"_sq), caseLabel);
+   }
+}
+
+
+void testIsEnPassant()
+{
+   {
+      const std::string caseLabel = "isEnPassant";
+
+      const Position pos("we5 bd5 bf6");
+      VERIFY(isEnPassant("we5"_pc, "d6"_sq, pos), caseLabel);
+      VERIFY(!isEnPassant("we5"_pc, "f6"_sq, pos), caseLabel);
+      VERIFY(!isEnPassant("we5"_pc, "e6"_sq, pos), caseLabel);
+   }
 }
 
 } // namespace
@@ -197,4 +242,6 @@ void testMove()
    testMoveEquality();
    testMoveInequality();
    testNotateMove();
+   testIsCastling();
+   testIsEnPassant();
 }
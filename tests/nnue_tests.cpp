@@ -0,0 +1,259 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "nnue_tests.h"
+#include "move.h"
+#include "nnue.h"
+#include "position.h"
+#include "test_util.h"
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+
+namespace
+{
+///////////////////
+
+// Weights of a network that scores every position the same.
+NetworkWeights constantWeights(std::size_t hiddenSize, std::size_t layerSize)
+{
+   NetworkWeights weights;
+   weights.hiddenSize = hiddenSize;
+   weights.layerSize = layerSize;
+   weights.featureWeights.resize(Network::NumFeatures * hiddenSize);
+   weights.featureBiases.resize(hiddenSize);
+   weights.layerWeights.resize(layerSize * hiddenSize);
+   weights.layerBiases.resize(layerSize);
+   weights.outputWeights.resize(layerSize);
+   weights.outputBias = 6;
+   weights.outputScale = 0.5f;
+   return weights;
+}
+
+
+// Weights that differ for each feature, so that any mistake in an accumulator
+// changes the score.
+NetworkWeights varyingWeights(std::size_t hiddenSize, std::size_t layerSize)
+{
+   NetworkWeights weights = constantWeights(hiddenSize, layerSize);
+   std::uint32_t state = 12345;
+   const auto next = [&state](int range) {
+      state = state * 1664525 + 1013904223;
+      return static_cast<int>((state >> 16) % (2 * range + 1)) - range;
+   };
+
+   for (auto& w : weights.featureWeights)
+      w = static_cast<std::int16_t>(next(8));
+   for (auto& b : weights.featureBiases)
+      b = static_cast<std::int16_t>(next(32) + 32);
+   for (auto& w : weights.layerWeights)
+      w = static_cast<std::int8_t>(next(64));
+   for (auto& b : weights.layerBiases)
+      b = next(1000);
+   for (auto& w : weights.outputWeights)
+      w = static_cast<std::int8_t>(next(64));
+   weights.outputScale = 0.01f;
+   return weights;
+}
+
+
+bool isSameWeights(const NetworkWeights& a, const NetworkWeights& b)
+{
+   return a.hiddenSize == b.hiddenSize && a.layerSize == b.layerSize &&
+          a.featureWeights == b.featureWeights && a.featureBiases == b.featureBiases &&
+          a.layerWeights == b.layerWeights && a.layerBiases == b.layerBiases &&
+          a.outputWeights == b.outputWeights && a.outputBias == b.outputBias &&
+          a.outputScale == b.outputScale;
+}
+
+
+// Checks that updating the accumulator of a position for a move gives the
+// accumulator of the position after the move.
+bool isUpdateSameAsRefresh(const Network& net, const Position& pos, const Move& move)
+{
+   const Position next = pos.makeMove(move);
+   Accumulator before;
+   net.refresh(before, pos);
+   Accumulator updated;
+   net.update(before, updated, pos, next, move);
+   Accumulator refreshed;
+   net.refresh(refreshed, next);
+   return updated == refreshed && net.evaluate(updated) == net.evaluate(next);
+}
+
+
+void testNetworkMake()
+{
+   {
+      const std::string caseLabel = "Network::make";
+
+      const std::optional<Network> net = Network::make(constantWeights(32, 8));
+      VERIFY(net.has_value(), caseLabel);
+      if (net.has_value())
+      {
+         VERIFY(net->weights().hiddenSize == 32, caseLabel);
+         VERIFY(net->weights().layerSize == 8, caseLabel);
+      }
+   }
+   {
+      const std::string caseLabel = "Network::make for invalid sizes";
+
+      VERIFY(!Network::make(constantWeights(0, 8)).has_value(), caseLabel);
+      VERIFY(!Network::make(constantWeights(32, 0)).has_value(), caseLabel);
+      VERIFY(!Network::make(constantWeights(Network::MaxHiddenSize + 1, 8)).has_value(),
+             caseLabel);
+      VERIFY(!Network::make(constantWeights(32, Network::MaxLayerSize + 1)).has_value(),
+             caseLabel);
+
+      NetworkWeights weights = constantWeights(32, 8);
+      weights.layerBiases.pop_back();
+      VERIFY(!Network::make(weights).has_value(), caseLabel);
+      weights = constantWeights(32, 8);
+      weights.featureWeights.resize(weights.featureWeights.size() + 1);
+      VERIFY(!Network::make(weights).has_value(), caseLabel);
+   }
+}
+
+
+void testNetworkEvaluate()
+{
+   {
+      const std::string caseLabel = "Network::evaluate for constant network";
+
+      const Network net = *Network::make(constantWeights(32, 8));
+      VERIFY(net.evaluate(Position{"Kwe1 Kbe8"}) == 3.f, caseLabel);
+      VERIFY(net.evaluate(Position{"Kwe1 Qwd1 Kbe8 bd7"}) == 3.f, caseLabel);
+   }
+   {
+      const std::string caseLabel = "Network::evaluate for one feature";
+
+      // The white queen on d1 sums to one unit after scaling the hidden layer.
+      NetworkWeights weights = constantWeights(1, 1);
+      const std::size_t feature =
+         (pieceCode(Color::White, Figure::Queen) - 1u) * Square::NumSquares +
+         "d1"_sq.index();
+      weights.featureWeights[feature] = 64;
+      weights.layerWeights[0] = 1;
+      weights.outputWeights[0] = 2;
+      weights.outputBias = 0;
+      weights.outputScale = 1.f;
+      const Network net = *Network::make(weights);
+
+      VERIFY(net.evaluate(Position{"Kwe1 Qwd1 Kbe8"}) == 2.f, caseLabel);
+      VERIFY(net.evaluate(Position{"Kwe1 Qwd2 Kbe8"}) == 0.f, caseLabel);
+      VERIFY(net.evaluate(Position{"Kwe1 Kbe8 Qbd1"}) == 0.f, caseLabel);
+   }
+   {
+      const std::string caseLabel = "Network::evaluate for accumulator";
+
+      const Network net = *Network::make(varyingWeights(64, 16));
+      const Position pos{"Kwe1 Qwd1 Rwa1 wc2 Kbe8 Nbb8 bd7"};
+      Accumulator acc;
+      net.refresh(acc, pos);
+      VERIFY(acc.size() == 64, caseLabel);
+      VERIFY(net.evaluate(acc) == net.evaluate(pos), caseLabel);
+   }
+}
+
+
+void testNetworkUpdate()
+{
+   const Network net = *Network::make(varyingWeights(64, 16));
+   {
+      const std::string caseLabel = "Network::update for quiet move";
+
+      const Position pos{"Kwe1 Nwb1 Kbe8 bd7"};
+      VERIFY(isUpdateSameAsRefresh(net, pos, Move{"Nwb1"_pc, "c3"_sq, pos}), caseLabel);
+      VERIFY(isUpdateSameAsRefresh(net, pos, Move{"bd7"_pc, "d5"_sq, pos}), caseLabel);
+   }
+   {
+      const std::string caseLabel = "Network::update for capture";
+
+      const Position pos{"Kwe1 Qwd1 Kbe8 Rbd7"};
+      VERIFY(isUpdateSameAsRefresh(net, pos, Move{"Qwd1"_pc, "d7"_sq, pos}), caseLabel);
+      VERIFY(isUpdateSameAsRefresh(net, pos, Move{"Rbd7"_pc, "d1"_sq, pos}), caseLabel);
+   }
+   {
+      const std::string caseLabel = "Network::update for castling";
+
+      const Position pos{"Kwe1 Rwa1 Rwh1 Kbe8 Rba8"};
+      VERIFY(isUpdateSameAsRefresh(net, pos, Move{"Kwe1"_pc, "g1"_sq, pos}), caseLabel);
+      VERIFY(isUpdateSameAsRefresh(net, pos, Move{"Kwe1"_pc, "c1"_sq, pos}), caseLabel);
+      VERIFY(isUpdateSameAsRefresh(net, pos, Move{"Kbe8"_pc, "c8"_sq, pos}), caseLabel);
+   }
+   {
+      const std::string caseLabel = "Network::update for en passant capture";
+
+      const Position pos{"Kwe1 we5 Kbe8 bd5"};
+      VERIFY(isUpdateSameAsRefresh(net, pos, Move{"we5"_pc, "d6"_sq, pos}), caseLabel);
+   }
+   {
+      const std::string caseLabel = "Network::update for promotion";
+
+      const Position pos{"Kwe1 wb7 Kbe8 Rba8"};
+      VERIFY(isUpdateSameAsRefresh(net, pos, Move{"wb7"_pc, "b8"_sq, Figure::Queen, pos}),
+             caseLabel);
+      VERIFY(
+         isUpdateSameAsRefresh(net, pos, Move{"wb7"_pc, "a8"_sq, Figure::Knight, pos}),
+         caseLabel);
+   }
+}
+
+
+void testNetworkFile()
+{
+   {
+      const std::string caseLabel = "Network::save and Network::load";
+
+      const std::filesystem::path path = tempPath("matt_nnue_tests.mnn");
+      const Network net = *Network::make(varyingWeights(48, 8));
+      VERIFY(net.save(path), caseLabel);
+
+      const std::optional<Network> loaded = Network::load(path);
+      VERIFY(loaded.has_value(), caseLabel);
+      if (loaded.has_value())
+      {
+         VERIFY(isSameWeights(loaded->weights(), net.weights()), caseLabel);
+         const Position pos{"Kwe1 Qwd1 Kbe8 Rbd7"};
+         VERIFY(loaded->evaluate(pos) == net.evaluate(pos), caseLabel);
+      }
+      std::filesystem::remove(path);
+   }
+   {
+      const std::string caseLabel = "Network::load for missing file";
+
+      VERIFY(!Network::load(tempPath("matt_nnue_tests_missing.mnn")).has_value(),
+             caseLabel);
+   }
+   {
+      const std::string caseLabel = "Network::load for invalid file";
+
+      const std::filesystem::path path = tempPath("matt_nnue_tests_invalid.mnn");
+      {
+         std::ofstream out{path, std::ios::binary};
+         out << "MNN1 not a network";
+      }
+      VERIFY(!Network::load(path).has_value(), caseLabel);
+
+      const Network net = *Network::make(constantWeights(16, 4));
+      net.save(path);
+      std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+      VERIFY(!Network::load(path).has_value(), caseLabel);
+      std::filesystem::remove(path);
+   }
+}
+
+} // namespace
+
+
+///////////////////
+
+void testNnue()
+{
+   testNetworkMake();
+   testNetworkEvaluate();
+   testNetworkUpdate();
+   testNetworkFile();
+}
@@ -0,0 +1,157 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "packed_position_tests.h"
+#include "bitboard.h"
+#include "fen.h"
+#include "mapped_file.h"
+#include "packed_position.h"
+#include "test_util.h"
+#include <filesystem>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+///////////////////
+
+const std::vector<std::string> TestFens = {
+   std::string{StartFen},
+   "r1bqkb1r/pppp1ppp/2n2n2/4p2Q/2B1P3/8/PPPP1PPP/RNB1K1NR w KQkq - 4 4",
+   "rnbqkbnr/ppp1pppp/8/3pP3/8/8/PPPP1PPP/RNBQKBNR w KQkq d6 0 3",
+   "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 b - - 37 80",
+   "8/8/8/8/8/8/8/8 w - - 0 1",
+};
+
+
+bool isSameFen(const FenPosition& a, const FenPosition& b)
+{
+   return writeFen(a) == writeFen(b) && a.pos.hash() == b.pos.hash() &&
+          a.pos.score() == b.pos.score() &&
+          a.pos.reversiblePlies() == b.pos.reversiblePlies();
+}
+
+
+void testPackUnpack()
+{
+   {
+      const std::string caseLabel = "pack and unpack";
+
+      for (const std::string& str : TestFens)
+      {
+         const FenPosition fen = *readFen(str);
+         const std::optional<PackedPosition> packed = pack(fen);
+         VERIFY(packed.has_value(), caseLabel);
+         if (packed.has_value())
+            VERIFY(isSameFen(unpack(*packed), fen), caseLabel);
+      }
+   }
+   {
+      const std::string caseLabel = "pack layout";
+
+      const PackedPosition packed = *pack(*readFen("8/8/8/8/8/8/8/Kk6 b Q a3 258 3"));
+      // Occupied squares a1 and b1.
+      VERIFY(packed.bytes[0] == 0x03, caseLabel);
+      // White king in the low nibble, black king in the high nibble.
+      VERIFY(packed.bytes[8] == 0x60, caseLabel);
+      // Black to move, white may castle queenside.
+      VERIFY(packed.bytes[24] == (1 | 2 << 1), caseLabel);
+      VERIFY(packed.bytes[25] == "a3"_sq.index(), caseLabel);
+      VERIFY(packed.bytes[26] == 2 && packed.bytes[27] == 1, caseLabel);
+      VERIFY(packed.bytes[28] == 3 && packed.bytes[29] == 0, caseLabel);
+   }
+   {
+      const std::string caseLabel = "pack for too many pieces";
+
+      FenPosition fen;
+      fen.pos = Position{"Kwa1 Qwb1 Qwc1 Qwd1 Qwe1 Qwf1 Qwg1 Qwh1 Qwa2 Qwb2 Qwc2 "
+                         "Rwa3 Rwb3 Rwc3 Rwd3 Rwe3 Rwf3 Rwg3 Rwh3 Rwa4 Rwb4 "
+                         "Bwa5 Bwb5 Bwc5 Bwd5 Bwe5 Bwf5 Bwg5 Bwh5 Bwa6 Bwb6 "
+                         "Kbh8 Qbg8"};
+      VERIFY(!pack(fen).has_value(), caseLabel);
+   }
+   {
+      const std::string caseLabel = "unpack corrupted data";
+
+      // All squares occupied but only codes for 32 pieces, alternating white queens
+      // and rooks, more of each than a position can hold.
+      PackedPosition packed;
+      for (std::size_t i = 0; i < 8; ++i)
+         packed.bytes[i] = 0xFF;
+      for (std::size_t i = 8; i < 24; ++i)
+         packed.bytes[i] = 0x21;
+      packed.bytes[25] = 0xFE;
+
+      const FenPosition fen = unpack(packed);
+      VERIFY(popcount(fen.pos.occupied()) == 2 * SquareList::Capacity, caseLabel);
+      VERIFY(fen.pos.squares(Color::White, Figure::Queen).size() ==
+                SquareList::Capacity,
+             caseLabel);
+      VERIFY(fen.pos.squares(Color::White, Figure::Rook).size() == SquareList::Capacity,
+             caseLabel);
+      // The pieces come from the first 32 occupied squares.
+      VERIFY((fen.pos.occupied() >> PackedPosition::MaxPieces) == 0, caseLabel);
+      VERIFY(!fen.enPassant, caseLabel);
+   }
+}
+
+
+void testPackedPositionReaderWriter()
+{
+   {
+      const std::string caseLabel = "PackedPositionWriter and PackedPositionReader";
+
+      std::vector<std::byte> memory(packedSize(TestFens.size()) + 5);
+      PackedPositionWriter writer{memory.data(), memory.size()};
+      VERIFY(writer.capacity() == TestFens.size(), caseLabel);
+      for (std::size_t i = 0; i < TestFens.size(); ++i)
+         VERIFY(writer.write(i, *readFen(TestFens[i])), caseLabel);
+      VERIFY(!writer.write(TestFens.size(), *readFen(StartFen)), caseLabel);
+
+      const PackedPositionReader reader{memory.data(), memory.size()};
+      VERIFY(reader.size() == TestFens.size(), caseLabel);
+      for (std::size_t i = 0; i < TestFens.size(); ++i)
+         VERIFY(writeFen(reader[i]) == TestFens[i], caseLabel);
+   }
+   {
+      const std::string caseLabel = "Packed positions in mapped file";
+
+      const std::filesystem::path path = tempPath("matt_packed_positions.bin");
+      {
+         std::optional<MappedFile> file =
+            MappedFile::create(path, packedSize(TestFens.size()));
+         VERIFY(file.has_value(), caseLabel);
+         if (file.has_value())
+         {
+            PackedPositionWriter writer{file->writableData(), file->size()};
+            for (std::size_t i = 0; i < TestFens.size(); ++i)
+               writer.write(i, *readFen(TestFens[i]));
+         }
+      }
+      {
+         const std::optional<MappedFile> file = MappedFile::open(path);
+         VERIFY(file.has_value(), caseLabel);
+         if (file.has_value())
+         {
+            const PackedPositionReader reader{file->data(), file->size()};
+            VERIFY(reader.size() == TestFens.size(), caseLabel);
+            for (std::size_t i = 0; i < reader.size(); ++i)
+               VERIFY(writeFen(reader[i]) == TestFens[i], caseLabel);
+         }
+      }
+      std::filesystem::remove(path);
+   }
+}
+
+} // namespace
+
+
+///////////////////
+
+void testPackedPosition()
+{
+   testPackUnpack();
+   testPackedPositionReaderWriter();
+}
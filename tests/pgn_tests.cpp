@@ -0,0 +1,186 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "pgn_tests.h"
+#include "fen.h"
+#include "pgn.h"
+#include "position.h"
+#include "test_util.h"
+#include <sstream>
+#include <string>
+
+
+namespace
+{
+///////////////////
+
+const std::string OperaGame = R"([Event "Paris"]
+[Site "Paris FRA"]
+[White "Paul Morphy"]
+[Black "Duke Karl / Count Isouard"]
+[Result "1-0"]
+
+1. e4 e5 2. Nf3 d6 3. d4 Bg4 {This is a weak move already.} 4. dxe5 Bxf3
+5. Qxf3 dxe5 6. Bc4 Nf6 7. Qb3 Qe7 8. Nc3 c6 9. Bg5 b5 $2 (9... Qb4+ 10. Qxb4)
+10. Nxb5 cxb5 11. Bxb5+ Nbd7 12. O-O-O Rd8 13. Rxd7 Rxd7 14. Rd1 Qe6
+15. Bxd7+ Nxd7 16. Qb8+! Nxb8 17. Rd8# 1-0
+)";
+
+const std::string OperaFinalFen = "1n1Rkb1r/p4ppp/4q3/4p1B1/4P3/8/PPP2PPP/2K5 b k - 1 17";
+
+
+void testReadSan()
+{
+   {
+      const std::string caseLabel = "readSan for pawn moves";
+
+      const auto move = readSan("e4", StartPos, Color::White);
+      VERIFY(move.has_value() && move->piece() == "we2"_pc && move->to() == "e4"_sq,
+             caseLabel);
+      VERIFY(!readSan("e5", StartPos, Color::White).has_value(), caseLabel);
+   }
+   {
+      const std::string caseLabel = "readSan for piece moves";
+
+      const auto move = readSan("Nf6", StartPos, Color::Black);
+      VERIFY(move.has_value() && move->piece() == "Nbg8"_pc && move->to() == "f6"_sq,
+             caseLabel);
+      VERIFY(move.has_value() && move->notate() == "Nf6", caseLabel);
+   }
+   {
+      const std::string caseLabel = "readSan with disambiguation";
+
+      const Position pos{"Kwh1 Rwa1 Rwf1 Nwe2 Nwb5 Kbh8"};
+      VERIFY(!readSan("Rd1", pos, Color::White).has_value(), caseLabel);
+      const auto byFile = readSan("Rad1", pos, Color::White);
+      VERIFY(byFile.has_value() && byFile->from() == "a1"_sq, caseLabel);
+      const auto byRank = readSan("N5c3", pos, Color::White);
+      VERIFY(byRank.has_value() && byRank->from() == "b5"_sq, caseLabel);
+   }
+   {
+      const std::string caseLabel = "readSan ignores pinned pieces when disambiguating";
+
+      const Position pos{"Kwe1 Nwe2 Nwa2 Rbe8 Kbh8"};
+      const auto move = readSan("Nc3", pos, Color::White);
+      VERIFY(move.has_value() && move->from() == "a2"_sq, caseLabel);
+   }
+   {
+      const std::string caseLabel = "readSan for special moves";
+
+      const Position pos{"Kwe1 Rwh1 wb7 we5 Kbe8 bd5"};
+      const auto castling = readSan("O-O", pos, Color::White);
+      VERIFY(castling.has_value() && castling->to() == "g1"_sq, caseLabel);
+      const auto promotion = readSan("b8=Q+", pos, Color::White);
+      VERIFY(promotion.has_value() && promotion->promotion() == Figure::Queen, caseLabel);
+      const auto enPassant = readSan("exd6", pos, Color::White);
+      VERIFY(enPassant.has_value() && enPassant->from() == "e5"_sq, caseLabel);
+   }
+   {
+      const std::string caseLabel = "readSan for malformed moves";
+
+      VERIFY(!readSan("", StartPos, Color::White).has_value(), caseLabel);
+      VERIFY(!readSan("Xe4", StartPos, Color::White).has_value(), caseLabel);
+      VERIFY(!readSan("e9", StartPos, Color::White).has_value(), caseLabel);
+      VERIFY(!readSan("Ne4=Q", StartPos, Color::White).has_value(), caseLabel);
+   }
+}
+
+
+void testPgnReaderFromMemory()
+{
+   {
+      const std::string caseLabel = "PgnReader from memory";
+
+      PgnReader reader{std::string_view{OperaGame}};
+      PgnGame game;
+      VERIFY(reader.next(game), caseLabel);
+      VERIFY(game.isComplete, caseLabel);
+      VERIFY(game.tags.size() == 5, caseLabel);
+      VERIFY(game.tag("White") == "Paul Morphy", caseLabel);
+      VERIFY(!game.tag("Round").has_value(), caseLabel);
+      VERIFY(game.result == "1-0", caseLabel);
+      VERIFY(game.moves.size() == 33, caseLabel);
+      VERIFY(game.positions.size() == 34, caseLabel);
+      VERIFY(game.positions.front() == StartPos, caseLabel);
+      VERIFY(game.positions.back() == readFen(OperaFinalFen)->pos, caseLabel);
+      VERIFY(game.moves.back().notate() == "Rd8", caseLabel);
+      VERIFY(!reader.next(game), caseLabel);
+   }
+}
+
+
+void testPgnReaderFromStream()
+{
+   {
+      const std::string caseLabel = "PgnReader from stream with several games";
+
+      std::istringstream in{OperaGame + "\n" + OperaGame};
+      PgnReader reader{in};
+      PgnGame game;
+      std::size_t numGames = 0;
+      while (reader.next(game))
+      {
+         ++numGames;
+         VERIFY(game.isComplete && game.moves.size() == 33, caseLabel);
+      }
+      VERIFY(numGames == 2, caseLabel);
+   }
+   {
+      const std::string caseLabel = "PgnReader for game with start position";
+
+      std::istringstream in{"[FEN \"4k3/1P6/8/3pP3/8/8/8/4K3 w - d6 0 1\"]\r\n"
+                            "\r\n"
+                            "1. exd6 Kf7 2. b8=N Ke6 *\r\n"};
+      PgnReader reader{in};
+      PgnGame game;
+      VERIFY(reader.next(game), caseLabel);
+      VERIFY(game.isComplete && game.result == "*", caseLabel);
+      VERIFY(game.positions.back() == Position("Kwe1 Nwb8 wd6 Kbe6"), caseLabel);
+   }
+   {
+      const std::string caseLabel = "PgnReader for game without result";
+
+      std::istringstream in{"1. e4 e5\n[Event \"Next\"]\n1. d4 d5 *\n"};
+      PgnReader reader{in};
+      PgnGame game;
+      VERIFY(reader.next(game) && game.moves.size() == 2 && game.result.empty(),
+             caseLabel);
+      VERIFY(reader.next(game) && game.tag("Event") == "Next", caseLabel);
+      VERIFY(game.moves.size() == 2 && game.moves[0].notate() == "d4", caseLabel);
+      VERIFY(!reader.next(game), caseLabel);
+   }
+   {
+      const std::string caseLabel = "PgnReader for game with black to move first";
+
+      std::istringstream in{"[FEN \"4k3/8/8/8/8/8/8/R3K3 b - - 0 1\"]\n"
+                            "1... Kd7 2. Ra7+ *"};
+      PgnReader reader{in};
+      PgnGame game;
+      VERIFY(reader.next(game) && game.isComplete, caseLabel);
+      VERIFY(game.firstSide == Color::Black && game.moves.size() == 2, caseLabel);
+   }
+   {
+      const std::string caseLabel = "PgnReader for game with illegal move";
+
+      std::istringstream in{"1. e4 e5 2. Ke3 Nc6 1-0\n\n1. d4 *\n"};
+      PgnReader reader{in};
+      PgnGame game;
+      VERIFY(reader.next(game), caseLabel);
+      VERIFY(!game.isComplete && game.moves.size() == 2, caseLabel);
+      VERIFY(game.result == "1-0", caseLabel);
+      VERIFY(reader.next(game) && game.isComplete && game.moves.size() == 1, caseLabel);
+   }
+}
+
+} // namespace
+
+
+///////////////////
+
+void testPgn()
+{
+   testReadSan();
+   testPgnReaderFromMemory();
+   testPgnReaderFromStream();
+}
@@ -1735,6 +1735,131 @@ void testPieceNextMovesForPawn()
 }
 
 
+void testPieceNextCaptures()
+{
+   {
+      const std::string caseLabel = "Piece::nextCaptures";
+
+      struct
+      {
+         std::string piece;
+         std::vector<std::string> otherPieces;
+         std::vector<std::string> captureLocations;
+      } testCases[] = {
+         // Only pieces of other color.
+         {"Rwd4", {"bd6", "Bwf4", "Nba4"}, {"d6", "a4"}},
+         // Pawns capture diagonally only.
+         {"we4", {"be5", "bd5", "Bbf5"}, {"d5", "f5"}},
+         // Nothing to capture.
+         {"Nbg8", {"bh6", "wg6"}, {}},
+         // King can not capture a protected piece.
+         {"Kwe1", {"Nbe2", "Rbe8", "bd2"}, {"d2"}},
+      };
+      for (const auto& test : testCases)
+      {
+         Piece piece(test.piece);
+         std::vector<Piece> all{piece};
+         std::transform(begin(test.otherPieces), end(test.otherPieces),
+                        std::back_inserter(all),
+                        [](const std::string& notation) { return Piece(notation); });
+         Position pos(all);
+         VERIFY(verifyNextMoves(piece.nextCaptures(pos), piece, pos,
+                                test.captureLocations),
+                caseLabel);
+      }
+   }
+}
+
+
+void testPieceNextQuietMoves()
+{
+   {
+      const std::string caseLabel = "Piece::nextQuietMoves";
+
+      struct
+      {
+         std::string piece;
+         std::vector<std::string> otherPieces;
+         std::vector<std::string> quietLocations;
+      } testCases[] = {
+         {"Rwd4",
+          {"bd6", "Bwf4", "Nba4"},
+          {"d3", "d2", "d1", "c4", "b4", "e4", "d5"}},
+         {"we2", {"bd3", "bf3"}, {"e3", "e4"}},
+         {"Nbg8", {"bh6", "wg6"}, {"f6", "e7"}},
+      };
+      for (const auto& test : testCases)
+      {
+         Piece piece(test.piece);
+         std::vector<Piece> all{piece};
+         std::transform(begin(test.otherPieces), end(test.otherPieces),
+                        std::back_inserter(all),
+                        [](const std::string& notation) { return Piece(notation); });
+         Position pos(all);
+         VERIFY(verifyNextMoves(piece.nextQuietMoves(pos), piece, pos,
+                                test.quietLocations),
+                caseLabel);
+      }
+   }
+   {
+      const std::string caseLabel = "Piece::nextCaptures/nextQuietMoves append to list";
+
+      const Piece rook{"Rwd4"};
+      const Position pos{"Rwd4 bd6 Bwf4 Nba4"};
+
+      MoveList moves;
+      rook.nextCaptures(pos, moves);
+      const std::size_t numCaptures = moves.size();
+      rook.nextQuietMoves(pos, moves);
+
+      VERIFY(numCaptures == 2, caseLabel);
+      VERIFY(moves.size() == rook.nextMoves(pos).size(), caseLabel);
+      for (std::size_t i = 0; i < moves.size(); ++i)
+         VERIFY(pos.isOccupiedBy(moves[i].to(), Color::Black) == (i < numCaptures),
+                caseLabel);
+   }
+}
+
+
+void testPieceCanMoveTo()
+{
+   {
+      const std::string caseLabel = "Piece::canMoveTo agrees with Piece::nextMoves";
+
+      const Position pos{"Kwe1 Qwd1 Rwh1 Bwc4 Nwf3 we2 wd4 wh2 Kbe8 Qbe7 Rba8 Bbb4 Nbc6 "
+                         "bd5 bf7 bg5"};
+
+      for (const Color side : {Color::White, Color::Black})
+      {
+         for (const Piece& piece : pos.pieces(side))
+         {
+            const std::vector<Move> moves = piece.nextMoves(pos);
+
+            for (char file = 'a'; file <= 'h'; ++file)
+            {
+               for (char rank = '1'; rank <= '8'; ++rank)
+               {
+                  const Square to{file, rank};
+                  const bool isNextMove =
+                     std::any_of(begin(moves), end(moves),
+                                 [&to](const Move& move) { return move.to() == to; });
+                  VERIFY(piece.canMoveTo(to, pos) == isNextMove, caseLabel);
+               }
+            }
+         }
+      }
+   }
+   {
+      const std::string caseLabel = "Piece::canMoveTo for pawn moving two squares";
+
+      const Position pos{"wb2 wc2 bc3 Nbd3 wd2"};
+      VERIFY(Piece("wb2").canMoveTo("b4"_sq, pos), caseLabel);
+      VERIFY(!Piece("wc2").canMoveTo("c4"_sq, pos), caseLabel);
+      VERIFY(!Piece("wd2").canMoveTo("d4"_sq, pos), caseLabel);
+   }
+}
+
+
 void testPieceNextPositionsForKing()
 {
    // todo - write once tests for Position are in place.
@@ -2003,6 +2128,9 @@ void testPiece()
    testPieceNextMovesForBishop();
    testPieceNextMovesForKnight();
    testPieceNextMovesForPawn();
+   testPieceNextCaptures();
+   testPieceNextQuietMoves();
+   testPieceCanMoveTo();
    testPieceNextPositionsForKing();
    testPieceNextPositionsForQueen();
    testPieceNextPositionsForRook();
@@ -7,6 +7,7 @@
 #include "position.h"
 #include "square.h"
 #include "test_util.h"
+#include <algorithm>
 #include <vector>
 
 
@@ -54,6 +55,17 @@ void testPositionNotationCtor()
       VERIFY(pos[Square("e1")] == "Kwe1"_pc, caseLabel);
       VERIFY(pos[Square("e8")] == "Kbe8"_pc, caseLabel);
    }
+   {
+      const std::string caseLabel = "Position notation ctor with extra spaces";
+
+      const Position pos{"  Kwe1   wd2 Kbe8 "};
+      VERIFY(pos == Position("Kwe1 wd2 Kbe8"), caseLabel);
+   }
+   {
+      const std::string caseLabel = "Position notation ctor for empty notation";
+
+      VERIFY(Position("") == Position(), caseLabel);
+   }
 }
 
 
@@ -200,6 +212,96 @@ void testPositionPieces()
 }
 
 
+void testPositionSquares()
+{
+   {
+      const std::string caseLabel = "Position::squares";
+
+      const Position pos{"Kwe1 wg2 wh2 Kbe8 Bbf8"};
+      VERIFY(pos.squares(Color::White, Figure::King).size() == 1, caseLabel);
+      VERIFY(pos.squares(Color::White, Figure::King)[0] == "e1"_sq, caseLabel);
+      VERIFY(pos.squares(Color::White, Figure::Pawn).size() == 2, caseLabel);
+      VERIFY(pos.squares(Color::Black, Figure::Bishop).size() == 1, caseLabel);
+      VERIFY(pos.squares(Color::Black, Figure::Bishop)[0] == "f8"_sq, caseLabel);
+      VERIFY(pos.squares(Color::Black, Figure::Pawn).empty(), caseLabel);
+      VERIFY(pos.squares(Color::White, Figure::Queen).empty(), caseLabel);
+   }
+   {
+      const std::string caseLabel = "Position::squares after moves";
+
+      const Position pos{"Kwe1 wa2 wb2 wc2 Kbe8 bb3"};
+      // Capture removes the piece from its list.
+      const Position next = pos.makeMove(Move{"wa2"_pc, "b3"_sq, pos});
+      VERIFY(next.squares(Color::Black, Figure::Pawn).empty(), caseLabel);
+
+      // Moving piece keeps its place in the list.
+      const SquareList& pawns = next.squares(Color::White, Figure::Pawn);
+      VERIFY(pawns.size() == 3, caseLabel);
+      VERIFY(pawns[0] == "b3"_sq && pawns[1] == "b2"_sq && pawns[2] == "c2"_sq,
+             caseLabel);
+   }
+   {
+      const std::string caseLabel = "Position::squares after capture of listed piece";
+
+      const Position pos{"Kwe1 Nwc3 ba2 bb5 bd5 Kbe8"};
+      // Last pawn in the list fills the gap.
+      const Position next = pos.makeMove(Move{"Nwc3"_pc, "a2"_sq, pos});
+      const SquareList& pawns = next.squares(Color::Black, Figure::Pawn);
+      VERIFY(pawns.size() == 2, caseLabel);
+      VERIFY(pawns[0] == "d5"_sq && pawns[1] == "b5"_sq, caseLabel);
+      VERIFY(next["d5"_sq] == "bd5"_pc && next["b5"_sq] == "bb5"_pc, caseLabel);
+   }
+}
+
+
+void testPositionOccupied()
+{
+   {
+      const std::string caseLabel = "Position::occupied";
+
+      const Position pos{"Kwe1 wg2 Kbe8 Bbf8"};
+      VERIFY(pos.occupied(Color::White) == (bit("e1"_sq) | bit("g2"_sq)), caseLabel);
+      VERIFY(pos.occupied(Color::Black) == (bit("e8"_sq) | bit("f8"_sq)), caseLabel);
+      VERIFY(popcount(pos.occupied()) == 4, caseLabel);
+      VERIFY(Position().occupied() == EmptyBB, caseLabel);
+   }
+   {
+      const std::string caseLabel = "Position::occupied after capture";
+
+      const Position pos("Kwe1 wg2 Kbe8 Bbf3");
+      const Position next = pos.makeMove(Move("wg2"_pc, "f3"_sq, pos));
+      VERIFY(next.occupied(Color::White) == (bit("e1"_sq) | bit("f3"_sq)), caseLabel);
+      VERIFY(next.occupied(Color::Black) == bit("e8"_sq), caseLabel);
+   }
+}
+
+
+void testPositionIsThreatenedBy()
+{
+   {
+      const std::string caseLabel = "Position::isThreatenedBy";
+
+      const Position pos{"Kwe1 Rwa4 Bwc1 Nwg1 wd4 Kbh8 Qbh5"};
+      VERIFY(pos.isThreatenedBy("a8"_sq, Color::White), caseLabel);
+      VERIFY(pos.isThreatenedBy("c4"_sq, Color::White), caseLabel);
+      VERIFY(pos.isThreatenedBy("h6"_sq, Color::White), caseLabel);
+      VERIFY(pos.isThreatenedBy("f3"_sq, Color::White), caseLabel);
+      VERIFY(pos.isThreatenedBy("e5"_sq, Color::White), caseLabel);
+      VERIFY(pos.isThreatenedBy("f2"_sq, Color::White), caseLabel);
+      VERIFY(pos.isThreatenedBy("e2"_sq, Color::Black), caseLabel);
+      VERIFY(pos.isThreatenedBy("h1"_sq, Color::Black), caseLabel);
+      // Blocked.
+      VERIFY(!pos.isThreatenedBy("h4"_sq, Color::White), caseLabel);
+      VERIFY(!pos.isThreatenedBy("e4"_sq, Color::White), caseLabel);
+      VERIFY(!pos.isThreatenedBy("d3"_sq, Color::White), caseLabel);
+      // Occupied by own piece.
+      VERIFY(!pos.isThreatenedBy("d4"_sq, Color::White), caseLabel);
+      // Pawns threaten diagonally only.
+      VERIFY(!pos.isThreatenedBy("d5"_sq, Color::White), caseLabel);
+   }
+}
+
+
 void testPositionMakeMove()
 {
    {
@@ -221,6 +323,70 @@ void testPositionMakeMove()
       VERIFY(pos.makeMove(Move("Bbf3"_pc, "g2"_sq, pos)) == Position("Kwe1 Kbe8 Bbg2"),
              caseLabel);
    }
+   {
+      const std::string caseLabel = "Position::makeMove for castling";
+
+      const Position pos("Kwe1 Rwa1 Rwh1 Kbe8 Rba8 Rbh8");
+      VERIFY(pos.makeMove(Move("Kwe1"_pc, "g1"_sq, pos)) ==
+                Position("Kwg1 Rwa1 Rwf1 Kbe8 Rba8 Rbh8"),
+             caseLabel);
+      VERIFY(pos.makeMove(Move("Kbe8"_pc, "c8"_sq, pos)) ==
+                Position("Kwe1 Rwa1 Rwh1 Kbc8 Rbd8 Rbh8"),
+             caseLabel);
+   }
+   {
+      const std::string caseLabel = "Position::makeMove for en passant capture";
+
+      const Position pos("Kwe1 we5 Kbe8 bd5");
+      const Position next = pos.makeMove(Move("we5"_pc, "d6"_sq, pos));
+      VERIFY(next == Position("Kwe1 wd6 Kbe8"), caseLabel);
+      VERIFY(next.hash() == Position("Kwe1 wd6 Kbe8").hash(), caseLabel);
+   }
+   {
+      const std::string caseLabel = "Position::makeMove for promotion";
+
+      const Position pos("Kwe1 wb7 Kbe8 Rba8");
+      VERIFY(pos.makeMove(Move("wb7"_pc, "b8"_sq, Figure::Queen, pos)) ==
+                Position("Kwe1 Qwb8 Kbe8 Rba8"),
+             caseLabel);
+      VERIFY(pos.makeMove(Move("wb7"_pc, "a8"_sq, Figure::Knight, pos)) ==
+                Position("Kwe1 Nwa8 Kbe8"),
+             caseLabel);
+   }
+}
+
+
+void testPositionMakeUnrecordedMove()
+{
+   {
+      const std::string caseLabel = "Position::makeUnrecordedMove matches makeMove";
+
+      const Position pos = Position("Kwe1 Rwh1 wd2 Kbe8 bc4").makeMove(
+         Move("Kbe8"_pc, "e7"_sq, Position("Kwe1 Rwh1 wd2 Kbe8 bc4")));
+      const std::vector<Move> moves = {Move("Kwe1"_pc, "g1"_sq, pos),
+                                       Move("wd2"_pc, "d4"_sq, pos),
+                                       Move("Rwh1"_pc, "h7"_sq, pos)};
+      for (const Move& move : moves)
+      {
+         const Position recorded = pos.makeMove(move);
+         const Position unrecorded = pos.makeUnrecordedMove(move);
+         VERIFY(unrecorded == recorded, caseLabel);
+         VERIFY(unrecorded.hash() == recorded.hash(), caseLabel);
+         VERIFY(unrecorded.score() == recorded.score(), caseLabel);
+         VERIFY(unrecorded.reversiblePlies() == recorded.reversiblePlies(), caseLabel);
+      }
+   }
+   {
+      const std::string caseLabel = "Position::makeUnrecordedMove does not record";
+
+      const Position pos = Position("Kwe1 Kbe8").makeMove(
+         Move("Kwe1"_pc, "e2"_sq, Position("Kwe1 Kbe8")));
+      const Position next = pos.makeUnrecordedMove(Move("Kbe8"_pc, "d7"_sq, pos));
+      VERIFY(next.recordedMoves().empty(), caseLabel);
+      VERIFY(next.initialPosition() == "Kwe2 Kbd7", caseLabel);
+      VERIFY(next.reversibleHistory() == std::vector<HashKey>{next.hash()}, caseLabel);
+      VERIFY(next.reversiblePlies() == 2, caseLabel);
+   }
 }
 
 
@@ -251,6 +417,113 @@ void testPositionRecordedMoves()
       const Position next = pos.makeMove(Move{*pos["e1"_sq], "e2"_sq, pos});
       VERIFY(next.recordedMoves() == "Ke2", caseLabel);
    }
+   {
+      const std::string caseLabel = "Position::moves after several moves";
+
+      const Position pos{"Kwe1 Kbe8"};
+      const Position a = pos.makeMove(Move{*pos["e1"_sq], "e2"_sq, pos});
+      const Position b = a.makeMove(Move{*a["e8"_sq], "d7"_sq, a});
+      const Position c = b.makeMove(Move{*b["e2"_sq], "f3"_sq, b});
+      VERIFY(c.recordedMoves() == "Ke2 Kd7 Kf3", caseLabel);
+      VERIFY(c.initialPosition() == "Kwe1 Kbe8", caseLabel);
+   }
+   {
+      const std::string caseLabel = "Position::moves of positions with shared history";
+
+      const Position pos{"Kwe1 Kbe8"};
+      const Position a = pos.makeMove(Move{*pos["e1"_sq], "e2"_sq, pos});
+      const Position b = a.makeMove(Move{*a["e8"_sq], "d7"_sq, a});
+      const Position c = a.makeMove(Move{*a["e8"_sq], "f8"_sq, a});
+      // Branching off does not affect the parent or the sibling.
+      VERIFY(a.recordedMoves() == "Ke2", caseLabel);
+      VERIFY(b.recordedMoves() == "Ke2 Kd7", caseLabel);
+      VERIFY(c.recordedMoves() == "Ke2 Kf8", caseLabel);
+   }
+}
+
+
+void testPositionHash()
+{
+   {
+      const std::string caseLabel = "Position::hash for equal positions";
+
+      VERIFY(Position("Kwe1 wg2 Kbe8").hash() == Position("Kbe8 wg2 Kwe1").hash(),
+             caseLabel);
+      VERIFY(Position().hash() == 0, caseLabel);
+   }
+   {
+      const std::string caseLabel = "Position::hash for different positions";
+
+      VERIFY(Position("Kwe1 wg2 Kbe8").hash() != Position("Kwe1 wg3 Kbe8").hash(),
+             caseLabel);
+      VERIFY(Position("Kwe1 wg2 Kbe8").hash() != Position("Kwe1 bg2 Kbe8").hash(),
+             caseLabel);
+   }
+   {
+      const std::string caseLabel = "Position::hash is updated by moves";
+
+      const Position pos{"Kwe1 Rwa1 Kbe8 bb2"};
+      const Position moved = pos.makeMove(Move{*pos["a1"_sq], "a4"_sq, pos});
+      VERIFY(moved.hash() == Position("Kwe1 Rwa4 Kbe8 bb2").hash(), caseLabel);
+      const Position captured = pos.makeMove(Move{*pos["b2"_sq], "a1"_sq, pos});
+      VERIFY(captured.hash() == Position("Kwe1 ba1 Kbe8").hash(), caseLabel);
+   }
+   {
+      const std::string caseLabel = "Position::hash for transpositions";
+
+      const Position pos{"Kwe1 Nwb1 Kbe8 Nbg8"};
+      const Position a1 = pos.makeMove(Move{*pos["b1"_sq], "c3"_sq, pos});
+      const Position a2 = a1.makeMove(Move{*a1["e1"_sq], "e2"_sq, a1});
+      const Position b1 = pos.makeMove(Move{*pos["e1"_sq], "e2"_sq, pos});
+      const Position b2 = b1.makeMove(Move{*b1["b1"_sq], "c3"_sq, b1});
+      VERIFY(a2.hash() == b2.hash(), caseLabel);
+   }
+}
+
+
+void testPositionReversiblePlies()
+{
+   {
+      const std::string caseLabel = "Position::reversiblePlies";
+
+      const Position pos{"Kwe1 we2 wb4 Kbe8 Nbd3"};
+      VERIFY(pos.reversiblePlies() == 0, caseLabel);
+
+      const Position a = pos.makeMove(Move{*pos["e1"_sq], "f1"_sq, pos});
+      VERIFY(a.reversiblePlies() == 1, caseLabel);
+      const Position b = a.makeMove(Move{*a["e8"_sq], "d8"_sq, a});
+      VERIFY(b.reversiblePlies() == 2, caseLabel);
+      // Pawn moves are irreversible.
+      const Position c = b.makeMove(Move{*b["e2"_sq], "e3"_sq, b});
+      VERIFY(c.reversiblePlies() == 0, caseLabel);
+      const Position d = c.makeMove(Move{*c["d8"_sq], "e8"_sq, c});
+      VERIFY(d.reversiblePlies() == 1, caseLabel);
+      // Captures are irreversible.
+      const Position e = d.makeMove(Move{*d["d3"_sq], "b4"_sq, d});
+      VERIFY(e.reversiblePlies() == 0, caseLabel);
+   }
+}
+
+
+void testPositionReversibleHistory()
+{
+   {
+      const std::string caseLabel = "Position::reversibleHistory for initial position";
+
+      const Position pos{"Kwe1 Kbe8"};
+      VERIFY(pos.reversibleHistory() == std::vector<HashKey>{pos.hash()}, caseLabel);
+   }
+   {
+      const std::string caseLabel = "Position::reversibleHistory after moves";
+
+      const Position pos{"Kwe1 we2 Kbe8"};
+      const Position a = pos.makeMove(Move{*pos["e2"_sq], "e3"_sq, pos});
+      const Position b = a.makeMove(Move{*a["e8"_sq], "d8"_sq, a});
+      const Position c = b.makeMove(Move{*b["e1"_sq], "f2"_sq, b});
+      // Stops at the pawn move.
+      const std::vector<HashKey> expected{a.hash(), b.hash(), c.hash()};
+      VERIFY(c.reversibleHistory() == expected, caseLabel);
+   }
 }
 
 
@@ -345,10 +618,17 @@ void testPosition()
    testPositionIsOccupiedBy();
    testPositionIndexOperator();
    testPositionPieces();
+   testPositionSquares();
+   testPositionOccupied();
+   testPositionIsThreatenedBy();
    testPositionMakeMove();
+   testPositionMakeUnrecordedMove();
    testPositionNotate();
    testPositionInitialPosition();
    testPositionRecordedMoves();
+   testPositionHash();
+   testPositionReversiblePlies();
+   testPositionReversibleHistory();
    testPositionEquality();
    testPositionInequality();
    testPositionLess();
@@ -0,0 +1,141 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "repetition_tests.h"
+#include "repetition.h"
+#include "test_util.h"
+#include <vector>
+
+
+namespace
+{
+///////////////////
+
+void testRepetitionHistoryIsRepetition()
+{
+   {
+      const std::string caseLabel = "RepetitionHistory::isRepetition without history";
+
+      const RepetitionHistory history{};
+      VERIFY(!history.isRepetition(10, 10), caseLabel);
+   }
+   {
+      const std::string caseLabel = "RepetitionHistory::isRepetition within search";
+
+      RepetitionHistory history{{5}};
+      history.push(1);
+      history.push(2);
+      history.push(1);
+      VERIFY(history.isRepetition(3, 3), caseLabel);
+   }
+   {
+      const std::string caseLabel =
+         "RepetitionHistory::isRepetition for positions with other side to move";
+
+      RepetitionHistory history{{1, 2}};
+      history.push(3);
+      history.push(1);
+      VERIFY(!history.isRepetition(3, 2), caseLabel);
+   }
+   {
+      const std::string caseLabel =
+         "RepetitionHistory::isRepetition before irreversible move";
+
+      RepetitionHistory history{{5}};
+      history.push(1);
+      history.push(2);
+      history.push(1);
+      VERIFY(!history.isRepetition(1, 3), caseLabel);
+   }
+   {
+      const std::string caseLabel =
+         "RepetitionHistory::isRepetition of game positions needs threefold repetition";
+
+      RepetitionHistory history{{1, 2, 3, 4}};
+      history.push(1);
+      VERIFY(!history.isRepetition(4, 1), caseLabel);
+
+      RepetitionHistory threefold{{1, 2, 1, 2}};
+      threefold.push(1);
+      VERIFY(threefold.isRepetition(4, 1), caseLabel);
+   }
+   {
+      const std::string caseLabel = "RepetitionHistory::pop";
+
+      RepetitionHistory history{{1, 2}};
+      history.push(3);
+      history.push(1);
+      history.pop();
+      history.pop();
+      history.push(5);
+      history.push(1);
+      VERIFY(history.size() == 4, caseLabel);
+      VERIFY(!history.isRepetition(3, 2), caseLabel);
+   }
+   {
+      const std::string caseLabel =
+         "RepetitionHistory keeps game positions after deepest search line";
+
+      // The oldest and the middle game position repeat the position at the end.
+      std::vector<HashKey> gameKeys(RepetitionHistory::FiftyMovePlies);
+      for (std::size_t i = 0; i < gameKeys.size(); ++i)
+         gameKeys[i] = 1000 + i;
+      gameKeys[0] = 7;
+      gameKeys[RepetitionHistory::FiftyMovePlies / 2] = 7;
+      RepetitionHistory history{gameKeys};
+
+      const std::size_t deepestLine = 64;
+      for (std::size_t i = 0; i < deepestLine; ++i)
+         history.push(2000 + i);
+      for (std::size_t i = 0; i < deepestLine; ++i)
+         history.pop();
+
+      history.push(7);
+      VERIFY(history.isRepetition(RepetitionHistory::FiftyMovePlies, 1), caseLabel);
+   }
+   {
+      const std::string caseLabel = "RepetitionHistory keeps newest game positions";
+
+      std::vector<HashKey> gameKeys(2 * RepetitionHistory::Capacity);
+      for (std::size_t i = 0; i < gameKeys.size(); ++i)
+         gameKeys[i] = i;
+      const RepetitionHistory history{gameKeys};
+      VERIFY(history.size() == RepetitionHistory::FiftyMovePlies + 1, caseLabel);
+   }
+   {
+      const std::string caseLabel = "RepetitionHistory overwrites oldest keys when full";
+
+      RepetitionHistory history;
+      for (std::size_t i = 0; i <= RepetitionHistory::Capacity + 10; ++i)
+         history.push(i % 2 == 0 ? 7 : i);
+      VERIFY(history.size() == RepetitionHistory::Capacity, caseLabel);
+      VERIFY(history.isRepetition(2, 2), caseLabel);
+   }
+}
+
+
+void testRepetitionScope()
+{
+   {
+      const std::string caseLabel = "RepetitionScope";
+
+      RepetitionHistory history{{1, 2}};
+      {
+         RepetitionScope scope{history, 3};
+         VERIFY(history.size() == 3, caseLabel);
+      }
+      VERIFY(history.size() == 2, caseLabel);
+   }
+}
+
+} // namespace
+
+
+///////////////////
+
+void testRepetition()
+{
+   testRepetitionHistoryIsRepetition();
+   testRepetitionScope();
+}
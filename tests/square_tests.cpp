@@ -33,8 +33,16 @@ void testSquareCharCtor()
             std::string coord(1, file);
             coord += rank;
             VERIFY(Square(coord).operator bool(), caseLabel);
+            VERIFY(Square(file, rank).notate() == coord, caseLabel);
          }
    }
+   {
+      const std::string caseLabel = "Square ctor for invalid characters";
+
+      VERIFY(!Square('i', '1').operator bool(), caseLabel);
+      VERIFY(!Square('a', '9').operator bool(), caseLabel);
+      VERIFY(!Square('A', '0').operator bool(), caseLabel);
+   }
 }
 
 
@@ -181,6 +189,95 @@ void testSquareOperatorBool()
 }
 
 
+void testSquareIndex()
+{
+   {
+      const std::string caseLabel = "Square::index";
+
+      VERIFY(Square("a1").index() == 0, caseLabel);
+      VERIFY(Square("b1").index() == 1, caseLabel);
+      VERIFY(Square("a2").index() == 8, caseLabel);
+      VERIFY(Square("e4").index() == 28, caseLabel);
+      VERIFY(Square("h8").index() == 63, caseLabel);
+   }
+   {
+      const std::string caseLabel = "Square::fileIndex and Square::rankIndex";
+
+      VERIFY(Square("a1").fileIndex() == 0 && Square("a1").rankIndex() == 0, caseLabel);
+      VERIFY(Square("e4").fileIndex() == 4 && Square("e4").rankIndex() == 3, caseLabel);
+      VERIFY(Square("h8").fileIndex() == 7 && Square("h8").rankIndex() == 7, caseLabel);
+   }
+   {
+      const std::string caseLabel = "Square::fromIndex";
+
+      for (std::size_t idx = 0; idx < Square::NumSquares; ++idx)
+         VERIFY(Square::fromIndex(idx).index() == idx, caseLabel);
+      VERIFY(Square::fromIndex(28) == "e4"_sq, caseLabel);
+      VERIFY(!Square::fromIndex(64), caseLabel);
+   }
+   {
+      const std::string caseLabel = "Square is usable at compile time";
+
+      static_assert("e4"_sq.file() == 'e');
+      static_assert("e4"_sq.rank() == '4');
+      static_assert(("e4"_sq + Offset{1, 2}) == std::make_optional("f6"_sq));
+      static_assert(!("h4"_sq + Offset{1, 0}).has_value());
+   }
+}
+
+
+void testRay()
+{
+   {
+      const std::string caseLabel = "ray";
+
+      const Ray& north = ray("e4"_sq, Direction::North);
+      VERIFY(north.size() == 4, caseLabel);
+      VERIFY(north[0] == "e5"_sq && north[3] == "e8"_sq, caseLabel);
+
+      const Ray& southWest = ray("e4"_sq, Direction::SouthWest);
+      VERIFY(southWest.size() == 3, caseLabel);
+      VERIFY(southWest[0] == "d3"_sq && southWest[2] == "b1"_sq, caseLabel);
+
+      VERIFY(ray("h8"_sq, Direction::NorthEast).empty(), caseLabel);
+      VERIFY(ray("a1"_sq, Direction::NorthEast).size() == 7, caseLabel);
+   }
+   {
+      const std::string caseLabel = "ray agrees with offset arithmetic";
+
+      for (std::size_t idx = 0; idx < Square::NumSquares; ++idx)
+      {
+         for (std::size_t dir = 0; dir < NumDirections; ++dir)
+         {
+            const Square from = Square::fromIndex(idx);
+            const Offset off = offset(static_cast<Direction>(dir));
+
+            std::optional<Square> sq = from + off;
+            for (const Square raySq : ray(from, static_cast<Direction>(dir)))
+            {
+               VERIFY(sq == raySq, caseLabel);
+               sq = sq + off;
+            }
+            VERIFY(!sq.has_value(), caseLabel);
+         }
+      }
+   }
+}
+
+
+void testNeighbor()
+{
+   {
+      const std::string caseLabel = "neighbor";
+
+      VERIFY(neighbor("e4"_sq, Direction::North) == "e5"_sq, caseLabel);
+      VERIFY(neighbor("e4"_sq, Direction::SouthEast) == "f3"_sq, caseLabel);
+      VERIFY(neighbor("a4"_sq, Direction::West) == std::nullopt, caseLabel);
+      VERIFY(neighbor("h8"_sq, Direction::North) == std::nullopt, caseLabel);
+   }
+}
+
+
 void testSwapSquares()
 {
    {
@@ -458,6 +555,7 @@ void testSquare()
    testSquareRank();
    testSquareNotate();
    testSquareOperatorBool();
+   testSquareIndex();
    testSwapSquares();
    testSquareEquality();
    testSquareInequality();
@@ -474,4 +572,7 @@ void testSquare()
    testOffsetSquareAddition();
    testOptionalSquareOffsetAddition();
    testOffsetOptionalSquareAddition();
+
+   testRay();
+   testNeighbor();
 }
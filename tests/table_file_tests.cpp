@@ -0,0 +1,291 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "table_file_tests.h"
+#include "position.h"
+#include "table_file.h"
+#include "test_util.h"
+#include <filesystem>
+#include <memory>
+#include <string>
+
+
+namespace
+{
+///////////////////
+
+// Codes of a table where every position is drawn except for one.
+std::vector<std::uint8_t> makeCodes(const Material& material, const Position& pos,
+                                    Color side, TableValue value)
+{
+   std::vector<std::uint8_t> codes(material.numEntries(), 0);
+   codes[*material.index(pos, side)] = value.encode();
+   return codes;
+}
+
+
+void testMaterialRead()
+{
+   {
+      const std::string caseLabel = "Material::read";
+
+      const std::optional<Material> material = Material::read("KQPKR");
+      VERIFY(material.has_value(), caseLabel);
+      if (material.has_value())
+      {
+         VERIFY(material->numPieces() == 5, caseLabel);
+         VERIFY(material->figures(Color::White) ==
+                   std::vector<Figure>({Figure::King, Figure::Queen, Figure::Pawn}),
+                caseLabel);
+         VERIFY(material->figures(Color::Black) ==
+                   std::vector<Figure>({Figure::King, Figure::Rook}),
+                caseLabel);
+      }
+   }
+   {
+      const std::string caseLabel = "Material::read for invalid notation";
+
+      VERIFY(!Material::read("").has_value(), caseLabel);
+      VERIFY(!Material::read("KQ").has_value(), caseLabel);
+      VERIFY(!Material::read("QKK").has_value(), caseLabel);
+      VERIFY(!Material::read("KXK").has_value(), caseLabel);
+      VERIFY(!Material::read("KKK").has_value(), caseLabel);
+      VERIFY(Material::read("KQRBNKQR").has_value(), caseLabel);
+      VERIFY(!Material::read("KQRBNKQRB").has_value(), caseLabel);
+   }
+}
+
+
+void testMaterialNotate()
+{
+   {
+      const std::string caseLabel = "Material::notate orders figures";
+
+      const Material material{{Figure::Pawn, Figure::King, Figure::Queen},
+                              {Figure::Knight, Figure::King}};
+      VERIFY(material.notate() == "KQPKN", caseLabel);
+   }
+   {
+      const std::string caseLabel = "Material::of";
+
+      VERIFY(Material::of(Position{"Kwe1 we2 Rwa1 Kbe8 Nbb8"}).notate() == "KRPKN",
+             caseLabel);
+   }
+   {
+      const std::string caseLabel = "Material::flipped";
+
+      VERIFY(Material::read("KRPKN")->flipped() == Material::read("KNKRP"), caseLabel);
+   }
+}
+
+
+void testMaterialIndex()
+{
+   {
+      const std::string caseLabel = "Material::numEntries";
+
+      VERIFY(Material::read("KK")->numEntries() == 2 * 32 * 64, caseLabel);
+      VERIFY(Material::read("KQK")->numEntries() == 2 * 32 * 64 * 64, caseLabel);
+   }
+   {
+      const std::string caseLabel = "Material::index and Material::pieces";
+
+      const Material material = *Material::read("KRPKN");
+      const Position pos{"Kwc1 Rwa5 wf2 Kbe8 Nbb8"};
+      const std::optional<std::size_t> idx = material.index(pos, Color::Black);
+      VERIFY(idx.has_value(), caseLabel);
+      if (idx.has_value())
+      {
+         VERIFY(Material::sideToMove(*idx) == Color::Black, caseLabel);
+         const std::optional<std::vector<Piece>> pieces = material.pieces(*idx);
+         VERIFY(pieces.has_value() && Position{*pieces} == pos, caseLabel);
+      }
+   }
+   {
+      const std::string caseLabel = "Material::index mirrors the files";
+
+      const Material material = *Material::read("KQK");
+      VERIFY(material.index(Position{"Kwg2 Qwh3 Kbb7"}, Color::White) ==
+                material.index(Position{"Kwb2 Qwa3 Kbg7"}, Color::White),
+             caseLabel);
+   }
+   {
+      const std::string caseLabel = "Material::index for flipped position";
+
+      const Material material = *Material::read("KQK");
+      VERIFY(material.index(Position{"Kbe1 Qbd1 Kwe8"}, Color::Black, true) ==
+                material.index(Position{"Kwe8 Qwd8 Kbe1"}, Color::White),
+             caseLabel);
+   }
+   {
+      const std::string caseLabel = "Material::index for identical pieces";
+
+      const Material material = *Material::read("KRRK");
+      const std::optional<std::size_t> idx =
+         material.index(Position{"Kwa1 Rwh5 Rwb2 Kbe8"}, Color::White);
+      VERIFY(idx.has_value(), caseLabel);
+      VERIFY(idx == material.index(Position{"Kwa1 Rwb2 Rwh5 Kbe8"}, Color::White),
+             caseLabel);
+      if (idx.has_value())
+      {
+         VERIFY(*idx == 2 * (((0 * 64 + 9) * 64 + 39) * 64 + 60), caseLabel);
+         // Swapping the rooks gives an index that no position maps to.
+         const std::size_t swapped = 2 * (((0 * 64 + 39) * 64 + 9) * 64 + 60);
+         VERIFY(!material.pieces(swapped).has_value(), caseLabel);
+      }
+   }
+   {
+      const std::string caseLabel = "Material::index for other positions";
+
+      const Material material = *Material::read("KPK");
+      VERIFY(!material.index(Position{"Kwe1 Qwe2 Kbe8"}, Color::White).has_value(),
+             caseLabel);
+      VERIFY(!material.index(Position{"Kwe1 we2 wd2 Kbe8"}, Color::White).has_value(),
+             caseLabel);
+      VERIFY(!material.index(Position{"Kwe1 wd8 Kbe7"}, Color::White).has_value(),
+             caseLabel);
+   }
+   {
+      const std::string caseLabel = "Material::pieces for invalid indices";
+
+      const Material material = *Material::read("KK");
+      // Both kings on a1.
+      VERIFY(!material.pieces(0).has_value(), caseLabel);
+      VERIFY(!material.pieces(material.numEntries()).has_value(), caseLabel);
+   }
+}
+
+
+void testTableValue()
+{
+   {
+      const std::string caseLabel = "TableValue::encode and TableValue::decode";
+
+      for (const TableValue value :
+           {TableValue{}, TableValue{Wdl::Win, 1}, TableValue{Wdl::Win, 127},
+            TableValue{Wdl::Loss, 0}, TableValue{Wdl::Loss, 126}})
+         VERIFY(TableValue::decode(value.encode()) == value, caseLabel);
+   }
+   {
+      const std::string caseLabel = "TableValue::decode for invalid code";
+
+      VERIFY(!TableValue::decode(TableValue::InvalidCode).has_value(), caseLabel);
+   }
+}
+
+
+void testTableFileProbe()
+{
+   {
+      const std::string caseLabel = "TableFile::write and TableFile::open";
+
+      const Material material = *Material::read("KK");
+      const auto path = tempPath(TableFile::fileName(material));
+      const Position pos{"Kwa1 Kbc3"};
+      VERIFY(TableFile::write(path, material,
+                              makeCodes(material, pos, Color::White, {Wdl::Win, 3})),
+             caseLabel);
+
+      const std::optional<TableFile> file = TableFile::open(path);
+      VERIFY(file.has_value(), caseLabel);
+      if (file.has_value())
+      {
+         VERIFY(file->material() == material, caseLabel);
+         VERIFY(file->probe(pos, Color::White) == TableValue({Wdl::Win, 3}), caseLabel);
+         VERIFY(file->probe(pos, Color::Black) == TableValue{}, caseLabel);
+         VERIFY(file->probe(Position{"Kba8 Kwc6"}, Color::Black, true) ==
+                   TableValue({Wdl::Win, 3}),
+                caseLabel);
+         VERIFY(!file->probe(Position{"Kwa1 Qwa2 Kbc3"}, Color::White).has_value(),
+                caseLabel);
+      }
+      std::filesystem::remove(path);
+   }
+   {
+      const std::string caseLabel = "TableFile::write for codes of other material";
+
+      const auto path = tempPath("matt_table_file_wrong_size.mtb");
+      VERIFY(!TableFile::write(path, *Material::read("KK"),
+                               std::vector<std::uint8_t>(100)),
+             caseLabel);
+   }
+   {
+      const std::string caseLabel = "TableFile::open for other files";
+
+      const auto path = tempPath("matt_table_file_other.mtb");
+      VERIFY(MappedFile::create(path, 4096).has_value(), caseLabel);
+      VERIFY(!TableFile::open(path).has_value(), caseLabel);
+      VERIFY(!TableFile::open(tempPath("matt_table_file_missing.mtb")).has_value(),
+             caseLabel);
+      std::filesystem::remove(path);
+   }
+}
+
+
+void testTableFilesProbe()
+{
+   const auto dir = tempPath("matt_table_files");
+   std::filesystem::create_directories(dir);
+   const Material material = *Material::read("KPK");
+   const Position pos{"Kwe6 we5 Kbe8"};
+   TableFile::write(dir / TableFile::fileName(material), material,
+                    makeCodes(material, pos, Color::White, {Wdl::Win, 20}));
+
+   {
+      const std::string caseLabel = "TableFiles::openDirectory";
+
+      TableFiles files;
+      VERIFY(files.openDirectory(dir) == 1, caseLabel);
+      VERIFY(files.size() == 1 && files.maxPieces() == 3, caseLabel);
+      VERIFY(files.contains(material), caseLabel);
+      VERIFY(files.contains(*Material::read("KKP")), caseLabel);
+      VERIFY(!files.contains(*Material::read("KQK")), caseLabel);
+      VERIFY(files.openDirectory(tempPath("matt_table_files_missing")) == 0, caseLabel);
+   }
+   {
+      const std::string caseLabel = "TableFiles::probe";
+
+      TableFiles files;
+      files.openDirectory(dir);
+      VERIFY(files.probe(pos, Color::White) == TableValue({Wdl::Win, 20}), caseLabel);
+      VERIFY(files.probe(Position{"Kbe3 be4 Kwe1"}, Color::Black) ==
+                TableValue({Wdl::Win, 20}),
+             caseLabel);
+      VERIFY(files.probe(pos, Color::Black) == TableValue{}, caseLabel);
+      VERIFY(!files.probe(Position{"Kwe6 Qwe5 Kbe8"}, Color::White).has_value(),
+             caseLabel);
+      VERIFY(!files.probe(Position{"Kwe6 we5 we4 Kbe8"}, Color::White).has_value(),
+             caseLabel);
+   }
+   {
+      const std::string caseLabel = "makeEndgameTable";
+
+      auto files = std::make_shared<TableFiles>();
+      files->openDirectory(dir);
+      const EndgameTable table = makeEndgameTable(files);
+      VERIFY(table.maxPieces == 3, caseLabel);
+      VERIFY(table.probeWdl(pos, Color::White) == Wdl::Win, caseLabel);
+      VERIFY(table.probeDtz(pos, Color::White) == 20, caseLabel);
+      VERIFY(table.probeWdl(pos, Color::Black) == Wdl::Draw, caseLabel);
+      VERIFY(!table.probeWdl(Position{"Kwe6 Qwe5 Kbe8"}, Color::White).has_value(),
+             caseLabel);
+   }
+
+   std::filesystem::remove_all(dir);
+}
+
+} // namespace
+
+
+///////////////////
+
+void testTableFile()
+{
+   testMaterialRead();
+   testMaterialNotate();
+   testMaterialIndex();
+   testTableValue();
+   testTableFileProbe();
+   testTableFilesProbe();
+}
@@ -0,0 +1,138 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "table_generator_tests.h"
+#include "position.h"
+#include "table_generator.h"
+#include "test_util.h"
+#include <algorithm>
+#include <filesystem>
+#include <string>
+
+
+namespace
+{
+///////////////////
+
+bool containsMaterial(const std::vector<Material>& materials, std::string_view notation)
+{
+   return std::find(std::begin(materials), std::end(materials),
+                    *Material::read(notation)) != std::end(materials);
+}
+
+
+void testSuccessorMaterials()
+{
+   {
+      const std::string caseLabel = "successorMaterials for captures";
+
+      const std::vector<Material> materials = successorMaterials(*Material::read("KQKR"));
+      VERIFY(materials.size() == 2, caseLabel);
+      VERIFY(containsMaterial(materials, "KQK"), caseLabel);
+      VERIFY(containsMaterial(materials, "KKR"), caseLabel);
+   }
+   {
+      const std::string caseLabel = "successorMaterials for promotions";
+
+      const std::vector<Material> materials = successorMaterials(*Material::read("KPK"));
+      VERIFY(materials.size() == 5, caseLabel);
+      for (const std::string_view notation : {"KK", "KQK", "KRK", "KBK", "KNK"})
+         VERIFY(containsMaterial(materials, notation), caseLabel);
+   }
+   {
+      const std::string caseLabel = "successorMaterials for captures by promotions";
+
+      const std::vector<Material> materials = successorMaterials(*Material::read("KPKN"));
+      VERIFY(containsMaterial(materials, "KKN"), caseLabel);
+      VERIFY(containsMaterial(materials, "KPK"), caseLabel);
+      VERIFY(containsMaterial(materials, "KQKN"), caseLabel);
+      VERIFY(containsMaterial(materials, "KQK"), caseLabel);
+      VERIFY(!containsMaterial(materials, "KK"), caseLabel);
+   }
+}
+
+
+void testGenerateTable()
+{
+   const auto dir = tempPath("matt_table_generator");
+   std::filesystem::create_directories(dir);
+   const Material kk = *Material::read("KK");
+   const Material kqk = *Material::read("KQK");
+
+   {
+      const std::string caseLabel = "generateTable for bare kings";
+
+      const auto codes = generateTable(kk, TableFiles{}, 2);
+      VERIFY(codes.has_value() && codes->size() == kk.numEntries(), caseLabel);
+      if (codes.has_value())
+      {
+         // Only draws and positions with touching kings.
+         VERIFY(std::all_of(std::begin(*codes), std::end(*codes),
+                            [](std::uint8_t code) {
+                               return code == 0 || code == TableValue::InvalidCode;
+                            }),
+                caseLabel);
+         VERIFY((*codes)[*kk.index(Position{"Kwa1 Kbc3"}, Color::White)] == 0,
+                caseLabel);
+         VERIFY((*codes)[*kk.index(Position{"Kwa1 Kbb2"}, Color::White)] ==
+                   TableValue::InvalidCode,
+                caseLabel);
+         TableFile::write(dir / TableFile::fileName(kk), kk, *codes);
+      }
+   }
+   {
+      const std::string caseLabel = "generateTable without successor tables";
+
+      VERIFY(!generateTable(kqk, TableFiles{}, 2).has_value(), caseLabel);
+   }
+   {
+      const std::string caseLabel = "generateTable for king and queen";
+
+      TableFiles tables;
+      tables.openDirectory(dir);
+      const auto codes = generateTable(kqk, tables, 2);
+      VERIFY(codes.has_value(), caseLabel);
+      if (codes.has_value())
+      {
+         const auto value = [&](std::string_view pos, Color side) {
+            return TableValue::decode((*codes)[*kqk.index(Position{pos}, side)]);
+         };
+
+         // Mate.
+         VERIFY(value("Kwc6 Qwb7 Kba8", Color::Black) == TableValue({Wdl::Loss, 0}),
+                caseLabel);
+         // Stalemate.
+         VERIFY(value("Kwc6 Qwb6 Kba8", Color::Black) == TableValue{}, caseLabel);
+         VERIFY(value("Kwc6 Qwh7 Kba8", Color::White) == TableValue({Wdl::Win, 1}),
+                caseLabel);
+         // Black captures the queen.
+         VERIFY(value("Kwc5 Qwb7 Kba8", Color::Black) == TableValue{}, caseLabel);
+         // Black is in check with White to move.
+         VERIFY(!value("Kwc6 Qwb8 Kba8", Color::White).has_value(), caseLabel);
+
+         // The longest win takes ten moves.
+         std::size_t maxDistance = 0;
+         for (const std::uint8_t code : *codes)
+         {
+            const std::optional<TableValue> v = TableValue::decode(code);
+            if (v.has_value() && v->wdl == Wdl::Win)
+               maxDistance = std::max(maxDistance, v->distance);
+         }
+         VERIFY(maxDistance == 19, caseLabel);
+      }
+   }
+
+   std::filesystem::remove_all(dir);
+}
+
+} // namespace
+
+
+///////////////////
+
+void testTableGenerator()
+{
+   testSuccessorMaterials();
+   testGenerateTable();
+}
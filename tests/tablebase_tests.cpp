@@ -0,0 +1,98 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "tablebase_tests.h"
+#include "kpk.h"
+#include "position.h"
+#include "tablebase.h"
+#include "test_util.h"
+
+
+namespace
+{
+///////////////////
+
+// Table that knows the same result for every position with few pieces.
+EndgameTable makeTable(std::size_t maxPieces, Wdl wdl, std::optional<int> dtz)
+{
+   EndgameTable table;
+   table.maxPieces = maxPieces;
+   table.probeWdl = [wdl](const Position&, Color) { return wdl; };
+   if (dtz.has_value())
+      table.probeDtz = [dtz](const Position&, Color) { return dtz; };
+   return table;
+}
+
+
+///////////////////
+
+void testTablebasesProbe()
+{
+   {
+      const std::string caseLabel = "Tablebases for built-in tables";
+
+      const Tablebases& tables = Tablebases::builtIn();
+      VERIFY(tables.maxPieces() == 3, caseLabel);
+      VERIFY(tables.probeWdl(Position{"Kwe6 we5 Kbe8"}, Color::White) == Wdl::Win,
+             caseLabel);
+      VERIFY(!tables.probeWdl(Position{"Kwe6 Rwe5 Kbe8"}, Color::White).has_value(),
+             caseLabel);
+      VERIFY(tables.probeDtz(Position{"Kwe6 we5 Kbe8"}, Color::White) ==
+                probeKpkDistance(Position{"Kwe6 we5 Kbe8"}, Color::White),
+             caseLabel);
+   }
+   {
+      const std::string caseLabel = "Tablebases::add";
+
+      Tablebases tables;
+      tables.add(makeTable(4, Wdl::Loss, 12));
+      VERIFY(tables.maxPieces() == 4, caseLabel);
+      VERIFY(tables.probeWdl(Position{"Kwe6 Rwe5 Kbe8"}, Color::White) == Wdl::Loss,
+             caseLabel);
+      VERIFY(tables.probeDtz(Position{"Kwe6 Rwe5 Kbe8"}, Color::White) == 12, caseLabel);
+      VERIFY(!tables.probeWdl(Position{"Kwe6 Rwe5 Rwe4 Kbe8 bh7"}, Color::White)
+                 .has_value(),
+             caseLabel);
+   }
+   {
+      const std::string caseLabel = "Tablebases asks tables in order";
+
+      Tablebases tables;
+      tables.add(makeTable(4, Wdl::Loss, std::nullopt));
+      tables.add(makeTable(5, Wdl::Draw, 3));
+      // The built-in table comes first.
+      VERIFY(tables.probeWdl(Position{"Kwe6 we5 Kbe8"}, Color::White) == Wdl::Win,
+             caseLabel);
+      VERIFY(tables.probeWdl(Position{"Kwe6 Rwe5 Kbe8"}, Color::White) == Wdl::Loss,
+             caseLabel);
+      // Skips tables with too few pieces and tables without distances.
+      VERIFY(tables.probeWdl(Position{"Kwe6 Rwe5 Rwe4 Kbe8 bh7"}, Color::White) ==
+                Wdl::Draw,
+             caseLabel);
+      VERIFY(tables.probeDtz(Position{"Kwe6 Rwe5 Kbe8"}, Color::White) == 3, caseLabel);
+   }
+}
+
+
+void testWdlNegation()
+{
+   {
+      const std::string caseLabel = "negation of Wdl";
+
+      VERIFY(-Wdl::Win == Wdl::Loss, caseLabel);
+      VERIFY(-Wdl::Loss == Wdl::Win, caseLabel);
+      VERIFY(-Wdl::Draw == Wdl::Draw, caseLabel);
+   }
+}
+
+} // namespace
+
+
+///////////////////
+
+void testTablebase()
+{
+   testTablebasesProbe();
+   testWdlNegation();
+}
@@ -3,8 +3,12 @@
 // MIT license
 //
 #include "test_util.h"
+#include <chrono>
+#include <cstdint>
 #include <iostream>
+#include <random>
 #include <string>
+#include <system_error>
 
 
 static std::string errorMessage(const std::string& label, const std::string& reason,
@@ -32,3 +36,51 @@ bool verify(bool cond, const std::string& label, const std::string& reason,
       std::cout << errorMessage(label, reason, fileName, lineNum) << "\n";
    return cond;
 }
+
+
+namespace
+{
+///////////////////
+
+class TempDirectory
+{
+ public:
+   TempDirectory();
+   ~TempDirectory();
+   TempDirectory(const TempDirectory&) = delete;
+   TempDirectory& operator=(const TempDirectory&) = delete;
+
+   const std::filesystem::path& path() const { return m_path; }
+
+ private:
+   std::filesystem::path m_path;
+};
+
+
+TempDirectory::TempDirectory()
+{
+   const auto now = std::chrono::steady_clock::now().time_since_epoch().count();
+   std::mt19937_64 random{std::random_device{}() ^ static_cast<std::uint64_t>(now)};
+   // Retry in the unlikely case that the directory exists already.
+   do
+   {
+      m_path = std::filesystem::temp_directory_path() /
+               ("matt_tests_" + std::to_string(random()));
+   } while (!std::filesystem::create_directory(m_path));
+}
+
+
+TempDirectory::~TempDirectory()
+{
+   std::error_code ec;
+   std::filesystem::remove_all(m_path, ec);
+}
+
+} // namespace
+
+
+std::filesystem::path tempPath(const std::string& name)
+{
+   static const TempDirectory dir;
+   return dir.path() / name;
+}
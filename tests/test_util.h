@@ -3,6 +3,7 @@
 // MIT license
 //
 #pragma once
+#include <filesystem>
 #include <string>
 
 
@@ -11,3 +12,7 @@ bool verify(bool cond, const std::string& label, const std::string& reason,
 
 #define VERIFY(cond, label) (verify(cond, label, #cond, __FILE__, __LINE__))
 #define FAIL(reason, label) (verify(false, label, reason, __FILE__, __LINE__))
+
+// Path of a file in a temporary directory of its own for each test run, so that
+// runs at the same time do not share files. The directory gets removed at exit.
+std::filesystem::path tempPath(const std::string& name);
@@ -0,0 +1,125 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "time_manager_tests.h"
+#include "position.h"
+#include "test_util.h"
+#include "time_manager.h"
+#include <limits>
+
+using namespace std::chrono_literals;
+
+
+namespace
+{
+///////////////////
+
+const Position pos{"Kwa1 Rwh1 Qbb2 Kba8"};
+const Move kingMove{Piece{"Kwa1"}, Square{"b2"}, pos};
+const Move rookMove{Piece{"Rwh1"}, Square{"b1"}, pos};
+
+
+SearchResult makeIteration(const Move& best, float margin)
+{
+   SearchResult iteration;
+   iteration.pv = {best};
+   iteration.bestMoveMargin = margin;
+   return iteration;
+}
+
+
+void testAllotTime()
+{
+   {
+      const std::string caseLabel = "allotTime for sudden death";
+
+      const TimeLimits limits = allotTime(GameClock{3010ms, 0ms, std::nullopt}, 10ms);
+      VERIFY(limits.soft == 100ms, caseLabel);
+      VERIFY(limits.hard == 400ms, caseLabel);
+   }
+   {
+      const std::string caseLabel = "allotTime with increment";
+
+      const TimeLimits limits = allotTime(GameClock{3010ms, 200ms, std::nullopt}, 10ms);
+      VERIFY(limits.soft == 200ms, caseLabel);
+      VERIFY(limits.hard == 800ms, caseLabel);
+   }
+   {
+      const std::string caseLabel = "allotTime for last move before time control";
+
+      const TimeLimits limits = allotTime(GameClock{3010ms, 0ms, 1}, 10ms);
+      VERIFY(limits.soft == 3000ms, caseLabel);
+      VERIFY(limits.hard == 3000ms, caseLabel);
+   }
+   {
+      const std::string caseLabel = "allotTime for almost no time";
+
+      const TimeLimits limits = allotTime(GameClock{5ms, 100ms, 10}, 10ms);
+      VERIFY(limits.soft == 1ms, caseLabel);
+      VERIFY(limits.hard == 1ms, caseLabel);
+   }
+}
+
+
+void testTimeManagerShouldStop()
+{
+   const TimeManager::Clock::time_point start{};
+
+   {
+      const std::string caseLabel = "TimeManager stops when soft time is used";
+
+      TimeManager manager{TimeLimits{100ms, 400ms}, start};
+      VERIFY(manager.deadline() == start + 400ms, caseLabel);
+      VERIFY(!manager.shouldStop(makeIteration(kingMove, 0.5f), start + 10ms),
+             caseLabel);
+      VERIFY(manager.shouldStop(makeIteration(kingMove, 0.5f), start + 70ms), caseLabel);
+   }
+   {
+      const std::string caseLabel = "TimeManager extends time for unstable best move";
+
+      TimeManager manager{TimeLimits{100ms, 400ms}, start};
+      VERIFY(!manager.shouldStop(makeIteration(kingMove, 0.5f), start + 10ms),
+             caseLabel);
+      VERIFY(!manager.shouldStop(makeIteration(rookMove, 0.5f), start + 70ms),
+             caseLabel);
+      VERIFY(manager.shouldStop(makeIteration(rookMove, 0.5f), start + 130ms),
+             caseLabel);
+   }
+   {
+      const std::string caseLabel = "TimeManager stops early for clear best move";
+
+      TimeManager manager{TimeLimits{100ms, 400ms}, start};
+      VERIFY(!manager.shouldStop(makeIteration(kingMove, 5.f), start + 21ms), caseLabel);
+      VERIFY(!manager.shouldStop(makeIteration(kingMove, 5.f), start + 22ms), caseLabel);
+      VERIFY(manager.shouldStop(makeIteration(kingMove, 5.f), start + 23ms), caseLabel);
+   }
+   {
+      const std::string caseLabel = "TimeManager stops for only move";
+
+      TimeManager manager{TimeLimits{100ms, 400ms}, start};
+      VERIFY(manager.shouldStop(
+                makeIteration(kingMove, std::numeric_limits<float>::infinity()), start),
+             caseLabel);
+   }
+   {
+      const std::string caseLabel = "TimeManager::restart";
+
+      TimeManager manager{TimeLimits{100ms, 400ms}, start};
+      manager.restart(start + 1s);
+      VERIFY(manager.deadline() == start + 1400ms, caseLabel);
+      VERIFY(!manager.shouldStop(makeIteration(kingMove, 0.5f), start + 1010ms),
+             caseLabel);
+   }
+}
+
+} // namespace
+
+
+///////////////////
+
+void testTimeManager()
+{
+   testAllotTime();
+   testTimeManagerShouldStop();
+}
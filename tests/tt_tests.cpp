@@ -0,0 +1,186 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "tt_tests.h"
+#include "tt.h"
+#include "test_util.h"
+
+
+namespace
+{
+///////////////////
+
+TranspositionTable::Entry makeEntry(float score, std::uint8_t depth, Bound bound)
+{
+   TranspositionTable::Entry entry;
+   entry.score = score;
+   entry.depth = depth;
+   entry.bound = bound;
+   entry.from = Square{"e2"};
+   entry.to = Square{"e4"};
+   return entry;
+}
+
+
+///////////////////
+
+void testTranspositionTableSize()
+{
+   {
+      const std::string caseLabel = "TranspositionTable size is a power of two";
+
+      const TranspositionTable tt{3};
+      VERIFY(tt.size() > 0, caseLabel);
+      VERIFY((tt.size() & (tt.size() - 1)) == 0, caseLabel);
+   }
+   {
+      const std::string caseLabel = "TranspositionTable::resize";
+
+      TranspositionTable tt{1};
+      const std::size_t smallSize = tt.size();
+      tt.resize(4);
+      VERIFY(tt.size() == 4 * smallSize, caseLabel);
+   }
+}
+
+
+void testTranspositionTableProbe()
+{
+   {
+      const std::string caseLabel = "TranspositionTable::probe for empty table";
+
+      const TranspositionTable tt{1};
+      VERIFY(!tt.probe(12345).has_value(), caseLabel);
+      VERIFY(!tt.probe(0).has_value(), caseLabel);
+   }
+   {
+      const std::string caseLabel = "TranspositionTable::probe for stored entry";
+
+      TranspositionTable tt{1};
+      tt.store(12345, makeEntry(1.5f, 7, Bound::Lower));
+      const auto entry = tt.probe(12345);
+      VERIFY(entry.has_value(), caseLabel);
+      if (entry.has_value())
+      {
+         VERIFY(entry->score == 1.5f, caseLabel);
+         VERIFY(entry->depth == 7, caseLabel);
+         VERIFY(entry->bound == Bound::Lower, caseLabel);
+         VERIFY(entry->from == Square{"e2"}, caseLabel);
+         VERIFY(entry->to == Square{"e4"}, caseLabel);
+      }
+   }
+   {
+      const std::string caseLabel = "TranspositionTable::probe for key in same slot";
+
+      TranspositionTable tt{1};
+      tt.store(12345, makeEntry(1.5f, 7, Bound::Exact));
+      VERIFY(!tt.probe(12345 + tt.size()).has_value(), caseLabel);
+   }
+   {
+      const std::string caseLabel = "TranspositionTable::probe for entry without move";
+
+      TranspositionTable tt{1};
+      TranspositionTable::Entry entry = makeEntry(-2.f, 1, Bound::Upper);
+      entry.from = Square{};
+      entry.to = Square{};
+      tt.store(99, entry);
+      const auto probed = tt.probe(99);
+      VERIFY(probed.has_value() && !probed->from && !probed->to, caseLabel);
+   }
+}
+
+
+void testTranspositionTableStore()
+{
+   {
+      const std::string caseLabel =
+         "TranspositionTable::store keeps deeper entry of other position";
+
+      TranspositionTable tt{1};
+      tt.store(5, makeEntry(1.f, 6, Bound::Exact));
+      tt.store(5 + tt.size(), makeEntry(2.f, 2, Bound::Exact));
+      VERIFY(tt.probe(5).has_value(), caseLabel);
+      VERIFY(!tt.probe(5 + tt.size()).has_value(), caseLabel);
+   }
+   {
+      const std::string caseLabel =
+         "TranspositionTable::store replaces deeper entry of earlier search";
+
+      TranspositionTable tt{1};
+      tt.store(5, makeEntry(1.f, 6, Bound::Exact));
+      tt.newSearch();
+      tt.store(5 + tt.size(), makeEntry(2.f, 2, Bound::Exact));
+      VERIFY(!tt.probe(5).has_value(), caseLabel);
+      VERIFY(tt.probe(5 + tt.size()).has_value(), caseLabel);
+   }
+   {
+      const std::string caseLabel =
+         "TranspositionTable::store keeps move of same position";
+
+      TranspositionTable tt{1};
+      tt.store(5, makeEntry(1.f, 3, Bound::Exact));
+      TranspositionTable::Entry update = makeEntry(0.5f, 4, Bound::Upper);
+      update.from = Square{};
+      update.to = Square{};
+      tt.store(5, update);
+      const auto entry = tt.probe(5);
+      VERIFY(entry.has_value() && entry->depth == 4 && entry->from == Square{"e2"},
+             caseLabel);
+   }
+}
+
+
+void testTranspositionTableHashfull()
+{
+   {
+      const std::string caseLabel = "TranspositionTable::hashfull for empty table";
+
+      const TranspositionTable tt{1};
+      VERIFY(tt.hashfull() == 0, caseLabel);
+   }
+   {
+      const std::string caseLabel = "TranspositionTable::hashfull for full table";
+
+      TranspositionTable tt{1};
+      for (HashKey key = 1; key <= tt.size(); ++key)
+         tt.store(key, makeEntry(0.f, 1, Bound::Exact));
+      VERIFY(tt.hashfull() == 1000, caseLabel);
+
+      tt.newSearch();
+      VERIFY(tt.hashfull() == 0, caseLabel);
+   }
+   {
+      const std::string caseLabel = "TranspositionTable::clear";
+
+      TranspositionTable tt{1};
+      tt.store(5, makeEntry(1.f, 3, Bound::Exact));
+      tt.clear();
+      VERIFY(!tt.probe(5).has_value(), caseLabel);
+   }
+}
+
+
+void testSearchKey()
+{
+   {
+      const std::string caseLabel = "searchKey distinguishes side to move";
+
+      VERIFY(searchKey(42, Color::White) != searchKey(42, Color::Black), caseLabel);
+      VERIFY(searchKey(42, Color::White) == 42, caseLabel);
+   }
+}
+
+} // namespace
+
+
+///////////////////
+
+void testTt()
+{
+   testTranspositionTableSize();
+   testTranspositionTableProbe();
+   testTranspositionTableStore();
+   testTranspositionTableHashfull();
+   testSearchKey();
+}
@@ -0,0 +1,298 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "uci_tests.h"
+#include "book.h"
+#include "fen.h"
+#include "table_file.h"
+#include "uci.h"
+#include "test_util.h"
+#include <filesystem>
+#include <sstream>
+
+
+namespace
+{
+///////////////////
+
+std::string runCommands(const std::string& commands)
+{
+   std::istringstream in{commands};
+   std::ostringstream out;
+   runUci(in, out);
+   return out.str();
+}
+
+
+bool contains(const std::string& output, const std::string& text)
+{
+   return output.find(text) != std::string::npos;
+}
+
+
+///////////////////
+
+void testRunUci()
+{
+   {
+      const std::string caseLabel = "runUci for uci command";
+
+      const std::string output = runCommands("uci\n");
+      VERIFY(contains(output, "id name Matt\n"), caseLabel);
+      VERIFY(contains(output, "option name Hash type spin"), caseLabel);
+      VERIFY(contains(output, "option name Evaluation type combo"), caseLabel);
+      VERIFY(contains(output, "option name EvalFile type string"), caseLabel);
+      VERIFY(contains(output, "option name EvalCache type spin"), caseLabel);
+      VERIFY(contains(output, "option name Ponder type check"), caseLabel);
+      VERIFY(contains(output, "option name OwnBook type check"), caseLabel);
+      VERIFY(contains(output, "option name BookFile type string"), caseLabel);
+      VERIFY(contains(output, "option name TablebasePath type string"), caseLabel);
+      VERIFY(contains(output, "option name MultiPV type spin default 1"), caseLabel);
+      VERIFY(contains(output, "uciok\n"), caseLabel);
+   }
+   {
+      const std::string caseLabel = "runUci for isready command";
+
+      const std::string output = runCommands("isready\n");
+      VERIFY(output == "readyok\n", caseLabel);
+   }
+   {
+      const std::string caseLabel = "runUci ignores unknown commands";
+
+      const std::string output = runCommands("xyzzy\nisready\n");
+      VERIFY(output == "readyok\n", caseLabel);
+   }
+   {
+      const std::string caseLabel = "runUci for search with depth limit";
+
+      const std::string output =
+         runCommands("ucinewgame\nposition startpos moves e2e4 e7e5\ngo depth 2\n");
+      VERIFY(contains(output, "info depth 1 "), caseLabel);
+      VERIFY(contains(output, "info depth 2 "), caseLabel);
+      VERIFY(contains(output, " nodes "), caseLabel);
+      VERIFY(contains(output, " nps "), caseLabel);
+      VERIFY(contains(output, " hashfull "), caseLabel);
+      VERIFY(contains(output, " pv "), caseLabel);
+      VERIFY(contains(output, "bestmove "), caseLabel);
+      VERIFY(contains(output, " ponder "), caseLabel);
+   }
+   {
+      const std::string caseLabel = "runUci for search with several lines";
+
+      const std::string output = runCommands(
+         "setoption name MultiPV value 3\nposition startpos\ngo depth 2\n");
+      VERIFY(contains(output, "info depth 2 multipv 1 score cp "), caseLabel);
+      VERIFY(contains(output, "info depth 2 multipv 2 score cp "), caseLabel);
+      VERIFY(contains(output, "info depth 2 multipv 3 score cp "), caseLabel);
+      VERIFY(!contains(output, "multipv 4 "), caseLabel);
+      VERIFY(contains(output, "bestmove "), caseLabel);
+   }
+   {
+      const std::string caseLabel = "runUci for ponder search";
+
+      const std::string output =
+         runCommands("position startpos moves e2e4\ngo ponder depth 1\nponderhit\n");
+      VERIFY(contains(output, "info depth 1 "), caseLabel);
+      VERIFY(contains(output, "bestmove "), caseLabel);
+   }
+   {
+      const std::string caseLabel = "runUci for position from FEN";
+
+      const std::string output =
+         runCommands("position fen k7/8/8/8/8/8/1q6/K7 w - - 0 1\ngo depth 2\n");
+      VERIFY(contains(output, "bestmove a1b2"), caseLabel);
+   }
+   {
+      const std::string caseLabel = "runUci for position from FEN with moves";
+
+      const std::string output = runCommands(
+         "position fen k7/8/8/8/8/8/8/K1q5 b - - 0 1 moves c1b2\ngo depth 1\n");
+      VERIFY(contains(output, "bestmove a1b2"), caseLabel);
+   }
+   {
+      const std::string caseLabel = "runUci for stopped infinite search";
+
+      const std::string output =
+         runCommands("position startpos\ngo infinite\nisready\nstop\n");
+      VERIFY(contains(output, "readyok\n"), caseLabel);
+      VERIFY(contains(output, "bestmove "), caseLabel);
+   }
+   {
+      const std::string caseLabel = "runUci for search with move time";
+
+      const std::string output =
+         runCommands("setoption name Hash value 1\nposition startpos\ngo movetime 50\n");
+      VERIFY(contains(output, "bestmove "), caseLabel);
+   }
+   {
+      const std::string caseLabel = "runUci for search with node limit";
+
+      const std::string output =
+         runCommands("setoption name Hash value 1\nposition startpos\ngo nodes 5000\n");
+      VERIFY(contains(output, "bestmove "), caseLabel);
+   }
+   {
+      const std::string caseLabel = "runUci with positional evaluation";
+
+      const std::string output = runCommands(
+         "setoption name Evaluation value Positional\nposition startpos\ngo depth 2\n");
+      VERIFY(contains(output, "info depth 2 "), caseLabel);
+      VERIFY(contains(output, "bestmove "), caseLabel);
+   }
+   {
+      const std::string caseLabel = "runUci for missing network file";
+
+      const std::string output = runCommands(
+         "setoption name EvalFile value x y.mnn\nposition startpos\ngo depth 2\n");
+      VERIFY(contains(output, "info string cannot open network x y.mnn\n"), caseLabel);
+      VERIFY(contains(output, "bestmove "), caseLabel);
+   }
+   {
+      const std::string caseLabel = "runUci for missing book file";
+
+      const std::string output = runCommands(
+         "setoption name OwnBook value true\nsetoption name BookFile value x y.bin\n");
+      VERIFY(contains(output, "info string cannot open book x y.bin\n"), caseLabel);
+   }
+   {
+      const std::string caseLabel = "runUci for quit command";
+
+      const std::string output = runCommands("quit\nisready\n");
+      VERIFY(output.empty(), caseLabel);
+   }
+}
+
+
+void testReadUciMove()
+{
+   const FenPosition start = *readFen(StartFen);
+
+   {
+      const std::string caseLabel = "readUciMove for pawn move";
+
+      const auto move = readUciMove("e2e4", start.pos, Color::White);
+      VERIFY(move.has_value(), caseLabel);
+      if (move.has_value())
+      {
+         VERIFY(move->piece() == Piece{"we2"}, caseLabel);
+         VERIFY(move->to() == Square{"e4"}, caseLabel);
+         VERIFY(move->notate() == "e4", caseLabel);
+      }
+   }
+   {
+      const std::string caseLabel = "readUciMove for promotion";
+
+      const Position pos{"Kwe1 wb7 Kbe8"};
+      const auto move = readUciMove("b7b8n", pos, Color::White);
+      VERIFY(move.has_value() && move->promotion() == Figure::Knight, caseLabel);
+   }
+   {
+      const std::string caseLabel = "readUciMove for invalid moves";
+
+      VERIFY(!readUciMove("e3e4", start.pos, Color::White).has_value(), caseLabel);
+      VERIFY(!readUciMove("e7e5", start.pos, Color::White).has_value(), caseLabel);
+      VERIFY(!readUciMove("e2", start.pos, Color::White).has_value(), caseLabel);
+      VERIFY(!readUciMove("e2e4x", start.pos, Color::White).has_value(), caseLabel);
+      VERIFY(!readUciMove("b1c3q", start.pos, Color::White).has_value(), caseLabel);
+   }
+}
+
+
+void testNotateUciMove()
+{
+   {
+      const std::string caseLabel = "notateUciMove for regular move";
+
+      const Move move{Piece{"Nwg1"}, Square{"f3"}, "Nf3"};
+      VERIFY(notateUciMove(move) == "g1f3", caseLabel);
+   }
+   {
+      const std::string caseLabel = "notateUciMove for promotion";
+
+      const Move move{Piece{"wa7"}, Square{"a8"}, Figure::Queen, "a8=Q"};
+      VERIFY(notateUciMove(move) == "a7a8q", caseLabel);
+   }
+}
+
+
+void testRunUciWithBook()
+{
+   const auto path = tempPath("matt_uci_book.bin");
+   const FenPosition start = *readFen(StartFen);
+   BookBuilder builder;
+   builder.add(start, Move{Piece{"wg1"}, Square{"f3"}, start.pos});
+   const FenPosition afterE4 =
+      makeMove(start, Move{Piece{"we2"}, Square{"e4"}, start.pos});
+   builder.add(afterE4, Move{Piece{"bc7"}, Square{"c5"}, afterE4.pos});
+   builder.write(path);
+   const std::string options = "setoption name BookFile value " + path.string() + "\n";
+
+   {
+      const std::string caseLabel = "runUci plays book move";
+
+      const std::string output = runCommands(
+         options + "setoption name OwnBook value true\nposition startpos\ngo depth 3\n");
+      VERIFY(contains(output, "bestmove g1f3"), caseLabel);
+      VERIFY(!contains(output, "info depth "), caseLabel);
+   }
+   {
+      const std::string caseLabel = "runUci plays book move after moves";
+
+      const std::string output =
+         runCommands(options + "setoption name OwnBook value true\n"
+                               "position startpos moves e2e4\ngo depth 3\n");
+      VERIFY(contains(output, "bestmove c7c5"), caseLabel);
+   }
+   {
+      const std::string caseLabel = "runUci ignores book without OwnBook option";
+
+      const std::string output = runCommands(options + "position startpos\ngo depth 1\n");
+      VERIFY(contains(output, "info depth 1 "), caseLabel);
+   }
+
+   std::filesystem::remove(path);
+}
+
+
+void testRunUciWithTablebases()
+{
+   const auto dir = tempPath("matt_uci_tablebases");
+   std::filesystem::create_directories(dir);
+   const Material material = *Material::read("KK");
+   TableFile::write(dir / TableFile::fileName(material), material,
+                    std::vector<std::uint8_t>(material.numEntries()));
+
+   {
+      const std::string caseLabel = "runUci opens tablebases";
+
+      const std::string output =
+         runCommands("setoption name TablebasePath value " + dir.string() +
+                     "\nposition fen 8/8/4k3/8/8/4K3/8/8 w - - 0 1\ngo depth 2\n");
+      VERIFY(contains(output, "info string found 1 tablebases in "), caseLabel);
+      VERIFY(contains(output, "bestmove "), caseLabel);
+   }
+   {
+      const std::string caseLabel = "runUci for missing tablebase directory";
+
+      const std::string output =
+         runCommands("setoption name TablebasePath value " + (dir / "x").string() + "\n");
+      VERIFY(contains(output, "info string found 0 tablebases in "), caseLabel);
+   }
+
+   std::filesystem::remove_all(dir);
+}
+
+} // namespace
+
+
+///////////////////
+
+void testUci()
+{
+   testRunUci();
+   testRunUciWithBook();
+   testRunUciWithTablebases();
+   testReadUciMove();
+   testNotateUciMove();
+}
@@ -0,0 +1,50 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "zobrist_tests.h"
+#include "zobrist.h"
+#include "test_util.h"
+#include <algorithm>
+#include <vector>
+
+
+namespace
+{
+///////////////////
+
+void testPieceKey()
+{
+   {
+      const std::string caseLabel = "pieceKey is unique";
+
+      std::vector<HashKey> keys;
+      for (const Color side : {Color::White, Color::Black})
+         for (std::size_t f = 0; f < NumFigures; ++f)
+            for (std::size_t idx = 0; idx < Square::NumSquares; ++idx)
+               keys.push_back(
+                  pieceKey(side, static_cast<Figure>(f), Square::fromIndex(idx)));
+      keys.push_back(sideKey());
+
+      std::sort(keys.begin(), keys.end());
+      VERIFY(std::adjacent_find(keys.begin(), keys.end()) == keys.end(), caseLabel);
+      VERIFY(std::find(keys.begin(), keys.end(), HashKey{0}) == keys.end(), caseLabel);
+   }
+   {
+      const std::string caseLabel = "pieceKey is constexpr";
+
+      constexpr HashKey key = pieceKey(Color::White, Figure::King, "e1"_sq);
+      static_assert(key != 0);
+      VERIFY(key == pieceKey(Color::White, Figure::King, "e1"_sq), caseLabel);
+   }
+}
+
+} // namespace
+
+
+///////////////////
+
+void testZobrist()
+{
+   testPieceKey();
+}
@@ -0,0 +1,99 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "time_manager.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace std::chrono_literals;
+
+
+namespace
+{
+///////////////////
+
+// Number of moves that the remaining time gets divided into if the clock does not
+// tell.
+constexpr std::size_t DefaultMovesToGo = 30;
+// Most that the hard limit exceeds the soft limit by.
+constexpr int HardLimitFactor = 4;
+// An iteration takes several times as long as the one before. Iterations that start
+// late in the soft time would be cut off at the hard limit.
+constexpr double NextIterationShare = 0.6;
+// Score lead over the second best move that makes the best move clear.
+constexpr float ClearMargin = 2.f;
+// Iterations that a clear best move needs to keep its place.
+constexpr std::size_t ClearIterations = 3;
+// Share of the soft time that a search with a clear best move takes at least.
+constexpr double ClearShare = 0.2;
+// How long the search extends the soft time when the best move changes, in soft
+// times.
+constexpr double InstabilityExtension = 1.;
+constexpr double InstabilityDecay = 0.5;
+
+} // namespace
+
+
+///////////////////
+
+TimeLimits allotTime(const GameClock& clock, std::chrono::milliseconds overhead)
+{
+   const std::chrono::milliseconds available =
+      std::max(clock.remaining - overhead, 1ms);
+   const std::size_t movesToGo = std::max<std::size_t>(
+      clock.movesToGo.value_or(DefaultMovesToGo), 1);
+   const std::chrono::milliseconds share =
+      available / static_cast<std::chrono::milliseconds::rep>(movesToGo) +
+      clock.increment / 2;
+
+   TimeLimits limits;
+   limits.soft = std::clamp(share, 1ms, available);
+   limits.hard = std::min(limits.soft * HardLimitFactor, available);
+   return limits;
+}
+
+
+///////////////////
+
+TimeManager::TimeManager(const TimeLimits& limits, Clock::time_point start)
+: m_limits{limits}, m_start{start}
+{
+}
+
+
+void TimeManager::restart(Clock::time_point start)
+{
+   m_start = start;
+}
+
+
+bool TimeManager::shouldStop(const SearchResult& iteration, Clock::time_point now)
+{
+   const std::optional<Move> best = iteration.bestMove();
+   m_instability *= InstabilityDecay;
+   if (m_bestMove.has_value() && best.has_value() && *best != *m_bestMove)
+   {
+      m_instability += InstabilityExtension;
+      m_stableIterations = 0;
+   }
+   else
+   {
+      ++m_stableIterations;
+   }
+   m_bestMove = best;
+
+   // Nothing to think about with only one move.
+   if (std::isinf(iteration.bestMoveMargin))
+      return true;
+
+   const std::chrono::duration<double, std::milli> elapsed = now - m_start;
+   const double soft = static_cast<double>(m_limits.soft.count());
+   if (iteration.bestMoveMargin >= ClearMargin && m_stableIterations >= ClearIterations &&
+       elapsed.count() >= soft * ClearShare)
+      return true;
+
+   const double extendedSoft = std::min(soft * (1. + m_instability),
+                                        static_cast<double>(m_limits.hard.count()));
+   return elapsed.count() >= extendedSoft * NextIterationShare;
+}
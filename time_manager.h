@@ -0,0 +1,64 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#pragma once
+#include "matt.h"
+#include <chrono>
+#include <cstddef>
+#include <optional>
+
+
+///////////////////
+
+// Clock of the searching side.
+struct GameClock
+{
+   std::chrono::milliseconds remaining{0};
+   std::chrono::milliseconds increment{0};
+   // Moves until the next time control. Sudden death if not given.
+   std::optional<std::size_t> movesToGo;
+};
+
+
+// Time that a search may take. The search ends between iterations around the soft
+// limit, later while the best move is unstable and earlier if the best move is
+// clear. It gets stopped at the hard limit.
+struct TimeLimits
+{
+   std::chrono::milliseconds soft{0};
+   std::chrono::milliseconds hard{0};
+};
+
+
+// Spreads the remaining time of a clock over the moves until the next time control.
+// Keeps a given overhead for communicating the move in reserve.
+TimeLimits allotTime(const GameClock& clock, std::chrono::milliseconds overhead);
+
+
+// Decides after each iteration of a search whether to start another one.
+class TimeManager
+{
+ public:
+   using Clock = std::chrono::steady_clock;
+
+   TimeManager(const TimeLimits& limits, Clock::time_point start);
+
+   // Starts the time again, e.g. when a ponder search turns into a regular search.
+   // Keeps what the earlier iterations showed about the best move.
+   void restart(Clock::time_point start);
+   Clock::time_point deadline() const { return m_start + m_limits.hard; }
+
+   // Takes a completed iteration. Returns whether the search should stop, because
+   // the time is used up or because the best move is clear.
+   bool shouldStop(const SearchResult& iteration, Clock::time_point now);
+
+ private:
+   TimeLimits m_limits;
+   Clock::time_point m_start;
+   std::optional<Move> m_bestMove;
+   // Iterations in a row that kept the best move.
+   std::size_t m_stableIterations = 0;
+   // Grows when the best move changes and decays with each iteration.
+   double m_instability = 0.;
+};
@@ -0,0 +1,165 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "tt.h"
+#include <algorithm>
+#include <cstring>
+
+
+namespace
+{
+///////////////////
+
+// Layout of the packed data of a slot.
+constexpr int DepthShift = 32;
+constexpr int BoundShift = 40;
+constexpr int FromShift = 42;
+constexpr int ToShift = 49;
+constexpr int GenerationShift = 56;
+constexpr std::uint64_t SquareMask = 0x7F;
+
+// Number of slots that hashfull samples.
+constexpr std::size_t HashfullSamples = 1000;
+
+
+std::uint64_t squareBits(Square sq)
+{
+   return sq ? sq.index() : Square::NumSquares;
+}
+
+
+Square unpackSquare(std::uint64_t bits)
+{
+   return bits < Square::NumSquares ? Square::fromIndex(bits) : Square{};
+}
+
+} // namespace
+
+
+///////////////////
+
+TranspositionTable::TranspositionTable(std::size_t sizeMB)
+{
+   resize(sizeMB);
+}
+
+
+void TranspositionTable::resize(std::size_t sizeMB)
+{
+   const std::size_t maxSlots =
+      std::max<std::size_t>(sizeMB, 1) * 1024 * 1024 / sizeof(Slot);
+   // Round down to a power of two, so that slots are indexed by masking the key.
+   std::size_t size = 1;
+   while (size * 2 <= maxSlots)
+      size *= 2;
+
+   m_slots = std::make_unique<Slot[]>(size);
+   m_size = size;
+   m_generation = 0;
+}
+
+
+void TranspositionTable::clear()
+{
+   for (std::size_t i = 0; i < m_size; ++i)
+   {
+      m_slots[i].key.store(0, std::memory_order_relaxed);
+      m_slots[i].data.store(0, std::memory_order_relaxed);
+   }
+   m_generation = 0;
+}
+
+
+void TranspositionTable::newSearch()
+{
+   ++m_generation;
+}
+
+
+std::optional<TranspositionTable::Entry> TranspositionTable::probe(HashKey key) const
+{
+   const Slot& s = slot(key);
+   const std::uint64_t data = s.data.load(std::memory_order_relaxed);
+   if ((s.key.load(std::memory_order_relaxed) ^ data) != key)
+      return std::nullopt;
+
+   const Entry entry = unpack(data);
+   if (entry.bound == Bound::None)
+      return std::nullopt;
+   return entry;
+}
+
+
+void TranspositionTable::store(HashKey key, const Entry& entry)
+{
+   Slot& s = slot(key);
+   const std::uint64_t oldData = s.data.load(std::memory_order_relaxed);
+   const bool sameKey = (s.key.load(std::memory_order_relaxed) ^ oldData) == key;
+   const Entry old = unpack(oldData);
+
+   // Keep deeper results of the current search for other positions.
+   if (!sameKey && old.bound != Bound::None && generation(oldData) == m_generation &&
+       entry.depth < old.depth)
+   {
+      return;
+   }
+
+   Entry update = entry;
+   // Keep the best move of an earlier search of the same position.
+   if (sameKey && !update.from)
+   {
+      update.from = old.from;
+      update.to = old.to;
+   }
+
+   const std::uint64_t data = pack(update);
+   s.key.store(key ^ data, std::memory_order_relaxed);
+   s.data.store(data, std::memory_order_relaxed);
+}
+
+
+std::size_t TranspositionTable::hashfull() const
+{
+   const std::size_t samples = std::min(HashfullSamples, m_size);
+   std::size_t used = 0;
+   for (std::size_t i = 0; i < samples; ++i)
+   {
+      const std::uint64_t data = m_slots[i].data.load(std::memory_order_relaxed);
+      if (unpack(data).bound != Bound::None && generation(data) == m_generation)
+         ++used;
+   }
+   return used * 1000 / samples;
+}
+
+
+std::uint64_t TranspositionTable::pack(const Entry& entry) const
+{
+   std::uint32_t scoreBits = 0;
+   static_assert(sizeof(scoreBits) == sizeof(entry.score));
+   std::memcpy(&scoreBits, &entry.score, sizeof(scoreBits));
+
+   return std::uint64_t{scoreBits} | std::uint64_t{entry.depth} << DepthShift |
+          static_cast<std::uint64_t>(entry.bound) << BoundShift |
+          squareBits(entry.from) << FromShift | squareBits(entry.to) << ToShift |
+          std::uint64_t{m_generation} << GenerationShift;
+}
+
+
+TranspositionTable::Entry TranspositionTable::unpack(std::uint64_t data)
+{
+   Entry entry;
+   const auto scoreBits = static_cast<std::uint32_t>(data);
+   std::memcpy(&entry.score, &scoreBits, sizeof(scoreBits));
+   entry.depth = static_cast<std::uint8_t>(data >> DepthShift);
+   entry.bound = static_cast<Bound>((data >> BoundShift) & 3);
+   entry.from = unpackSquare((data >> FromShift) & SquareMask);
+   entry.to = unpackSquare((data >> ToShift) & SquareMask);
+   return entry;
+}
+
+
+std::uint8_t TranspositionTable::generation(std::uint64_t data)
+{
+   return static_cast<std::uint8_t>(data >> GenerationShift);
+}
@@ -0,0 +1,90 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#pragma once
+#include "square.h"
+#include "zobrist.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+
+///////////////////
+
+// How a stored score relates to the real score of a position.
+enum class Bound : std::uint8_t
+{
+   None,
+   // The score is exact.
+   Exact,
+   // The real score is at least the stored score.
+   Lower,
+   // The real score is at most the stored score.
+   Upper
+};
+
+
+// Search results shared between searches and searching threads.
+// Lockless. Each slot stores its key xor-ed with its data, so that a slot that is
+// torn by concurrent writes does not match any key and reads as empty.
+class TranspositionTable
+{
+ public:
+   static constexpr std::size_t DefaultSizeMB = 16;
+
+   struct Entry
+   {
+      // Score from the point of view of the side to move.
+      float score = 0.f;
+      // Remaining plies that the score was searched with.
+      std::uint8_t depth = 0;
+      Bound bound = Bound::None;
+      // Best move. Invalid squares if the position had no best move.
+      Square from;
+      Square to;
+   };
+
+   explicit TranspositionTable(std::size_t sizeMB = DefaultSizeMB);
+
+   // Clears the table.
+   void resize(std::size_t sizeMB);
+   void clear();
+   // Marks the start of a new search. Entries of older searches get replaced first.
+   void newSearch();
+   std::size_t size() const { return m_size; }
+
+   std::optional<Entry> probe(HashKey key) const;
+   void store(HashKey key, const Entry& entry);
+   // Used slots that belong to the current search, in permill.
+   std::size_t hashfull() const;
+
+ private:
+   struct Slot
+   {
+      std::atomic<std::uint64_t> key{0};
+      std::atomic<std::uint64_t> data{0};
+   };
+
+   Slot& slot(HashKey key) const { return m_slots[key & (m_size - 1)]; }
+   std::uint64_t pack(const Entry& entry) const;
+   static Entry unpack(std::uint64_t data);
+   static std::uint8_t generation(std::uint64_t data);
+
+ private:
+   std::unique_ptr<Slot[]> m_slots;
+   // Power of two.
+   std::size_t m_size = 0;
+   std::uint8_t m_generation = 0;
+};
+
+
+///////////////////
+
+// Key of a position for the transposition table. Includes the side to move.
+inline HashKey searchKey(HashKey piecesKey, Color side)
+{
+   return side == Color::Black ? piecesKey ^ sideKey() : piecesKey;
+}
@@ -0,0 +1,577 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "uci.h"
+#include "engine.h"
+#include "evaluation.h"
+#include "fen.h"
+#include "nnue.h"
+#include "position.h"
+#include "table_file.h"
+#include "time_manager.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+
+namespace
+{
+///////////////////
+
+constexpr std::string_view EngineName = "Matt";
+constexpr std::string_view EngineAuthor = "Michael Lindner";
+constexpr std::size_t MaxHashSizeMB = 4096;
+constexpr std::size_t MaxMultiPv = 256;
+// Time kept in reserve for communicating with the GUI.
+constexpr std::chrono::milliseconds MoveOverhead = 10ms;
+
+using Tokens = std::vector<std::string_view>;
+
+
+Tokens tokenize(std::string_view line)
+{
+   Tokens tokens;
+   std::size_t pos = 0;
+   while (pos < line.size())
+   {
+      while (pos < line.size() && std::isspace(static_cast<unsigned char>(line[pos])))
+         ++pos;
+      const std::size_t start = pos;
+      while (pos < line.size() && !std::isspace(static_cast<unsigned char>(line[pos])))
+         ++pos;
+      if (pos > start)
+         tokens.push_back(line.substr(start, pos - start));
+   }
+   return tokens;
+}
+
+
+// Joins tokens with single spaces.
+std::string join(Tokens::const_iterator first, Tokens::const_iterator last)
+{
+   std::string joined;
+   for (auto it = first; it != last; ++it)
+   {
+      if (!joined.empty())
+         joined += ' ';
+      joined += *it;
+   }
+   return joined;
+}
+
+
+std::optional<std::int64_t> readNumber(std::string_view token)
+{
+   std::int64_t value = 0;
+   std::istringstream stream{std::string{token}};
+   if (!(stream >> value))
+      return std::nullopt;
+   return value;
+}
+
+
+std::optional<Figure> readPromotion(char ch)
+{
+   switch (ch)
+   {
+   case 'q':
+      return Figure::Queen;
+   case 'r':
+      return Figure::Rook;
+   case 'b':
+      return Figure::Bishop;
+   case 'n':
+      return Figure::Knight;
+   default:
+      return std::nullopt;
+   }
+}
+
+
+char notatePromotion(Figure f)
+{
+   switch (f)
+   {
+   case Figure::Queen:
+      return 'q';
+   case Figure::Rook:
+      return 'r';
+   case Figure::Bishop:
+      return 'b';
+   case Figure::Knight:
+      return 'n';
+   default:
+      return '?';
+   }
+}
+
+
+///////////////////
+
+// Parameters of the go command.
+struct GoCommand
+{
+   SearchLimits limits;
+   std::optional<std::chrono::milliseconds> moveTime;
+   std::optional<std::chrono::milliseconds> time;
+   std::chrono::milliseconds increment{0};
+   std::optional<std::int64_t> movesToGo;
+   bool infinite = false;
+   bool ponder = false;
+};
+
+
+GoCommand readGo(const Tokens& tokens, Color side)
+{
+   GoCommand cmd;
+   const std::string_view timeToken = side == Color::White ? "wtime" : "btime";
+   const std::string_view incToken = side == Color::White ? "winc" : "binc";
+
+   for (std::size_t i = 1; i < tokens.size(); ++i)
+   {
+      const std::string_view token = tokens[i];
+      if (token == "infinite")
+      {
+         cmd.infinite = true;
+         continue;
+      }
+      if (token == "ponder")
+      {
+         cmd.ponder = true;
+         continue;
+      }
+
+      // All other parameters take a value.
+      if (i + 1 >= tokens.size())
+         break;
+      const std::optional<std::int64_t> value = readNumber(tokens[i + 1]);
+      if (!value.has_value())
+         continue;
+      ++i;
+
+      const std::chrono::milliseconds ms{std::max<std::int64_t>(*value, 0)};
+      if (token == "depth")
+         cmd.limits.plies = static_cast<std::size_t>(std::max<std::int64_t>(*value, 1));
+      else if (token == "nodes")
+         cmd.limits.nodes = static_cast<std::uint64_t>(std::max<std::int64_t>(*value, 1));
+      else if (token == "movetime")
+         cmd.moveTime = ms;
+      else if (token == timeToken)
+         cmd.time = ms;
+      else if (token == incToken)
+         cmd.increment = ms;
+      else if (token == "movestogo")
+         cmd.movesToGo = std::max<std::int64_t>(*value, 1);
+   }
+   return cmd;
+}
+
+
+// Time for the next move. A fixed move time is the soft and the hard limit.
+std::optional<TimeLimits> readTimeLimits(const GoCommand& cmd)
+{
+   if (cmd.moveTime.has_value())
+   {
+      const std::chrono::milliseconds moveTime =
+         std::max(*cmd.moveTime - MoveOverhead, 1ms);
+      return TimeLimits{moveTime, moveTime};
+   }
+   if (!cmd.time.has_value())
+      return std::nullopt;
+
+   GameClock clock;
+   clock.remaining = *cmd.time;
+   clock.increment = cmd.increment;
+   if (cmd.movesToGo.has_value())
+      clock.movesToGo = static_cast<std::size_t>(*cmd.movesToGo);
+   return allotTime(clock, MoveOverhead);
+}
+
+
+///////////////////
+
+// State of the protocol between the commands of the GUI.
+class UciSession
+{
+ public:
+   explicit UciSession(std::ostream& out);
+   ~UciSession();
+
+   // Returns false when the GUI ends the session.
+   bool handle(std::string_view line);
+   // Waits for the result of a running search. Stops searches that would not end
+   // on their own.
+   void finishSearch();
+
+ private:
+   void uci();
+   void setOption(const Tokens& tokens);
+   // Opens the book that the options select.
+   void updateBook();
+   // Opens the table files in a directory in addition to the built-in tables.
+   void setTablebasePath(const std::string& path);
+   // Loads the network that evaluates positions instead of the evaluation option.
+   void setEvalFile(const std::string& path);
+   void position(const Tokens& tokens);
+   void go(const Tokens& tokens);
+   void reportIteration(const SearchResult& result);
+   void reportResult(const SearchResult& result);
+   // Writes a line of output. Called from the protocol and the search threads.
+   void send(const std::string& line);
+
+ private:
+   std::ostream& m_out;
+   std::mutex m_outMutex;
+   Engine m_engine;
+   FenPosition m_pos;
+   // Whether the running search only ends when stopped.
+   bool m_isUnlimited = false;
+   std::size_t m_multiPv = 1;
+   // Scores by position instead of only by material.
+   bool m_isPositionalEval = false;
+   std::shared_ptr<const Network> m_network;
+   bool m_useBook = false;
+   std::string m_bookFile;
+};
+
+
+UciSession::UciSession(std::ostream& out) : m_out{out}, m_pos{*readFen(StartFen)}
+{
+}
+
+
+UciSession::~UciSession()
+{
+   m_engine.stop();
+   m_engine.wait();
+}
+
+
+bool UciSession::handle(std::string_view line)
+{
+   const Tokens tokens = tokenize(line);
+   if (tokens.empty())
+      return true;
+
+   const std::string_view cmd = tokens[0];
+   if (cmd == "uci")
+      uci();
+   else if (cmd == "isready")
+      send("readyok");
+   else if (cmd == "setoption")
+      setOption(tokens);
+   else if (cmd == "ucinewgame")
+      m_engine.newGame();
+   else if (cmd == "position")
+      position(tokens);
+   else if (cmd == "go")
+      go(tokens);
+   else if (cmd == "stop")
+      m_engine.stop();
+   else if (cmd == "ponderhit")
+      m_engine.ponderhit();
+   else if (cmd == "quit")
+      return false;
+   // Ignore unknown commands as the protocol demands.
+
+   return true;
+}
+
+
+void UciSession::finishSearch()
+{
+   if (m_isUnlimited)
+      m_engine.stop();
+   m_engine.wait();
+}
+
+
+void UciSession::uci()
+{
+   send("id name " + std::string{EngineName});
+   send("id author " + std::string{EngineAuthor});
+   send("option name Hash type spin default " +
+        std::to_string(TranspositionTable::DefaultSizeMB) + " min 1 max " +
+        std::to_string(MaxHashSizeMB));
+   send("option name Evaluation type combo default Material var Material var "
+        "Positional");
+   send("option name EvalFile type string default <empty>");
+   send("option name EvalCache type spin default " +
+        std::to_string(EvalCache::DefaultSizeMB) + " min 1 max " +
+        std::to_string(MaxHashSizeMB));
+   // Tells the GUI that the engine can think on the opponent's time.
+   send("option name Ponder type check default false");
+   send("option name MultiPV type spin default 1 min 1 max " +
+        std::to_string(MaxMultiPv));
+   send("option name OwnBook type check default false");
+   send("option name BookFile type string default <empty>");
+   send("option name TablebasePath type string default <empty>");
+   send("uciok");
+}
+
+
+void UciSession::setOption(const Tokens& tokens)
+{
+   // setoption name <id> [value <x>]
+   // Names and values can contain spaces.
+   const auto valueIt = std::find(std::begin(tokens), std::end(tokens), "value");
+   if (tokens.size() < 3 || tokens[1] != "name")
+      return;
+   const std::string name = join(std::begin(tokens) + 2, valueIt);
+   const std::string value =
+      valueIt != std::end(tokens) ? join(valueIt + 1, std::end(tokens)) : "";
+
+   if (name == "Hash")
+   {
+      if (const auto sizeMB = readNumber(value); sizeMB.has_value())
+         m_engine.setHashSize(static_cast<std::size_t>(
+            std::clamp<std::int64_t>(*sizeMB, 1, MaxHashSizeMB)));
+   }
+   else if (name == "Evaluation")
+   {
+      const bool isPositional = value == "Positional";
+      // Scores of the other evaluation in the tables are stale.
+      if (isPositional != m_isPositionalEval)
+         m_engine.newGame();
+      m_isPositionalEval = isPositional;
+   }
+   else if (name == "EvalFile")
+   {
+      setEvalFile(value == "<empty>" ? "" : value);
+   }
+   else if (name == "EvalCache")
+   {
+      if (const auto sizeMB = readNumber(value); sizeMB.has_value())
+         m_engine.setEvalCacheSize(static_cast<std::size_t>(
+            std::clamp<std::int64_t>(*sizeMB, 1, MaxHashSizeMB)));
+   }
+   else if (name == "MultiPV")
+   {
+      if (const auto numLines = readNumber(value); numLines.has_value())
+         m_multiPv = static_cast<std::size_t>(
+            std::clamp<std::int64_t>(*numLines, 1, MaxMultiPv));
+   }
+   else if (name == "OwnBook")
+   {
+      m_useBook = value == "true";
+      updateBook();
+   }
+   else if (name == "BookFile")
+   {
+      m_bookFile = value == "<empty>" ? "" : value;
+      updateBook();
+   }
+   else if (name == "TablebasePath")
+   {
+      setTablebasePath(value == "<empty>" ? "" : value);
+   }
+}
+
+
+void UciSession::updateBook()
+{
+   std::optional<OpeningBook> book;
+   if (m_useBook && !m_bookFile.empty())
+   {
+      book = OpeningBook::open(m_bookFile);
+      if (!book.has_value())
+         send("info string cannot open book " + m_bookFile);
+   }
+   m_engine.setBook(std::move(book));
+}
+
+
+void UciSession::setTablebasePath(const std::string& path)
+{
+   Tablebases tablebases;
+   if (!path.empty())
+   {
+      auto files = std::make_shared<TableFiles>();
+      const std::size_t numFiles = files->openDirectory(path);
+      send("info string found " + std::to_string(numFiles) + " tablebases in " + path);
+      if (numFiles > 0)
+         tablebases.add(makeEndgameTable(std::move(files)));
+   }
+   m_engine.setTablebases(std::move(tablebases));
+}
+
+
+void UciSession::setEvalFile(const std::string& path)
+{
+   std::shared_ptr<const Network> network;
+   if (!path.empty())
+   {
+      if (std::optional<Network> loaded = Network::load(path); loaded.has_value())
+         network = std::make_shared<const Network>(std::move(*loaded));
+      else
+         send("info string cannot open network " + path);
+   }
+   // Scores of the other evaluation in the tables are stale.
+   if (network || m_network)
+      m_engine.newGame();
+   m_network = std::move(network);
+}
+
+
+void UciSession::position(const Tokens& tokens)
+{
+   // position [startpos | fen <fen>] [moves <move>...]
+   const auto movesIt = std::find(std::begin(tokens), std::end(tokens), "moves");
+
+   std::optional<FenPosition> start;
+   if (tokens.size() > 1 && tokens[1] == "startpos")
+   {
+      start = readFen(StartFen);
+   }
+   else if (tokens.size() > 1 && tokens[1] == "fen")
+   {
+      start = readFen(join(std::begin(tokens) + 2, movesIt));
+   }
+   if (!start.has_value())
+      return;
+
+   if (movesIt != std::end(tokens))
+   {
+      for (auto it = movesIt + 1; it != std::end(tokens); ++it)
+      {
+         const std::optional<Move> move = readUciMove(*it, start->pos, start->side);
+         if (!move.has_value())
+            break;
+         start = makeMove(*start, *move);
+      }
+   }
+
+   m_pos = std::move(*start);
+}
+
+
+void UciSession::go(const Tokens& tokens)
+{
+   const GoCommand cmd = readGo(tokens, m_pos.side);
+
+   SearchRequest request;
+   request.limits = cmd.limits;
+   request.limits.multiPv = m_multiPv;
+   if (m_isPositionalEval)
+      request.limits.evaluation = static_cast<float (*)(const Position&)>(
+         evaluatePosition);
+   request.limits.network = m_network;
+   request.castling = m_pos.castling;
+   request.enPassant = m_pos.enPassant;
+   request.time = readTimeLimits(cmd);
+   request.infinite = cmd.infinite;
+   request.ponder = cmd.ponder;
+   m_isUnlimited = cmd.infinite || cmd.ponder;
+
+   m_engine.go(
+      m_pos.pos, m_pos.side, request,
+      [this](const SearchResult& result) { reportIteration(result); },
+      [this](const SearchResult& result) { reportResult(result); });
+}
+
+
+void UciSession::reportIteration(const SearchResult& result)
+{
+   const auto ms = static_cast<std::uint64_t>(result.time.count());
+   const std::uint64_t nps = result.nodes * 1000 / std::max<std::uint64_t>(ms, 1);
+
+   // One line per best move. Only numbered if there are several.
+   for (std::size_t i = 0; i < result.lines.size(); ++i)
+   {
+      const SearchLine& searchLine = result.lines[i];
+      const long centipawns = std::lround(searchLine.score * 100.f);
+
+      std::string line = "info depth " + std::to_string(result.depth);
+      if (result.lines.size() > 1)
+         line += " multipv " + std::to_string(i + 1);
+      line += " score cp " + std::to_string(centipawns) + " nodes " +
+              std::to_string(result.nodes) + " nps " + std::to_string(nps) + " time " +
+              std::to_string(ms) + " hashfull " + std::to_string(result.hashfull) +
+              " pv";
+      for (const Move& move : searchLine.pv)
+         line += " " + notateUciMove(move);
+      send(line);
+   }
+}
+
+
+void UciSession::reportResult(const SearchResult& result)
+{
+   const std::optional<Move> best = result.bestMove();
+   // A null move tells the GUI that there is no move.
+   std::string line = "bestmove " + (best.has_value() ? notateUciMove(*best) : "0000");
+   // The GUI starts pondering on the expected reply.
+   if (const std::optional<Move> reply = result.ponderMove(); reply.has_value())
+      line += " ponder " + notateUciMove(*reply);
+   send(line);
+}
+
+
+void UciSession::send(const std::string& line)
+{
+   std::lock_guard lock{m_outMutex};
+   m_out << line << std::endl;
+}
+
+} // namespace
+
+
+///////////////////
+
+void runUci(std::istream& in, std::ostream& out)
+{
+   UciSession session{out};
+   std::string line;
+   while (std::getline(in, line))
+      if (!session.handle(line))
+         return;
+
+   // Let the last search finish when the input ends, e.g. for piped commands.
+   session.finishSearch();
+}
+
+
+std::string notateUciMove(const Move& move)
+{
+   std::string notation = move.from().notate() + move.to().notate();
+   if (move.promotion().has_value())
+      notation += notatePromotion(*move.promotion());
+   return notation;
+}
+
+
+std::optional<Move> readUciMove(std::string_view notation, const Position& pos,
+                                Color side)
+{
+   if (notation.size() != 4 && notation.size() != 5)
+      return std::nullopt;
+
+   const Square from{notation.substr(0, 2)};
+   const Square to{notation.substr(2, 2)};
+   if (!from || !to)
+      return std::nullopt;
+
+   const std::optional<Piece> piece = pos[from];
+   if (!piece.has_value() || piece->color() != side)
+      return std::nullopt;
+
+   if (notation.size() == 5)
+   {
+      const std::optional<Figure> promotion = readPromotion(notation[4]);
+      if (!promotion.has_value() || piece->figure() != Figure::Pawn)
+         return std::nullopt;
+      return Move{*piece, to, *promotion, pos};
+   }
+   return Move{*piece, to, pos};
+}
@@ -0,0 +1,29 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#pragma once
+#include "move.h"
+#include "piece.h"
+#include <iosfwd>
+#include <optional>
+#include <string>
+#include <string_view>
+
+class Position;
+
+
+///////////////////
+
+// Runs the Universal Chess Interface protocol that chess GUIs use to drive engines.
+// Reads commands from a stream until "quit" or the end of the stream and writes
+// the responses to another stream. Searches run in the background, so commands
+// like "stop" and "isready" are answered while the engine thinks.
+void runUci(std::istream& in, std::ostream& out);
+
+// Moves in UCI notation name the start and target squares and the promoted figure,
+// e.g. "e2e4", "e1g1" for castling or "e7e8q".
+std::string notateUciMove(const Move& move);
+// Returns nothing if there is no piece of the side on the start square.
+std::optional<Move> readUciMove(std::string_view notation, const Position& pos,
+                                Color side);
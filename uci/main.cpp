@@ -0,0 +1,14 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "uci.h"
+#include <cstdlib>
+#include <iostream>
+
+
+int main()
+{
+   runUci(std::cin, std::cout);
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,76 @@
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#pragma once
+#include "piece.h"
+#include "square.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Random keys for Zobrist hashing of positions. A position's key is the xor of the
+// keys of its pieces, so it can be updated incrementally when pieces move. The keys
+// are generated at compile time from a fixed seed, so they are the same in every
+// build.
+
+
+///////////////////
+
+using HashKey = std::uint64_t;
+
+
+namespace detail
+{
+///////////////////
+
+struct ZobristKeys
+{
+   std::array<std::array<std::array<HashKey, Square::NumSquares>, NumFigures>, NumColors>
+      pieces{};
+   HashKey side = 0;
+};
+
+
+// SplitMix64 generator. Advances the state and returns the next number.
+constexpr std::uint64_t splitMix64(std::uint64_t& state)
+{
+   state += 0x9E3779B97F4A7C15ull;
+   std::uint64_t z = state;
+   z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+   z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+   return z ^ (z >> 31);
+}
+
+
+constexpr ZobristKeys makeZobristKeys()
+{
+   ZobristKeys keys;
+   std::uint64_t state = 0x6D617474ull;
+   for (auto& colorKeys : keys.pieces)
+      for (auto& figureKeys : colorKeys)
+         for (HashKey& key : figureKeys)
+            key = splitMix64(state);
+   keys.side = splitMix64(state);
+   return keys;
+}
+
+
+inline constexpr ZobristKeys Zobrist = makeZobristKeys();
+
+} // namespace detail
+
+
+///////////////////
+
+inline constexpr HashKey pieceKey(Color side, Figure figure, Square sq)
+{
+   return detail::Zobrist.pieces[static_cast<std::size_t>(side)]
+                                [static_cast<std::size_t>(figure)][sq.index()];
+}
+
+// Key that distinguishes positions with black to move.
+inline constexpr HashKey sideKey()
+{
+   return detail::Zobrist.side;
+}